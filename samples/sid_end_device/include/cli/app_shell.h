@@ -193,6 +193,7 @@
 #define CMD_SID_SDK_VERSION_DESCRIPTION "Print sid sdk version"
 
 #define CMD_SID_SDK_CONFIG_DESCRIPTION "Print sid sdk config"
+#define CMD_SID_EVENT_STAT_DESCRIPTION "Print Sidewalk thread event queue statistics"
 
 #define CMD_NORDIC_DFU_ARG_REQUIRED 1
 #define CMD_NORDIC_DFU_ARG_OPTIONAL 0
@@ -245,6 +246,8 @@
 #define CMD_SID_SDK_VERSION_DESCRIPTION_ARG_OPTIONAL 0
 #define CMD_SID_SDK_CONFIG_DESCRIPTION_ARG_REQUIRED 1
 #define CMD_SID_SDK_CONFIG_DESCRIPTION_ARG_OPTIONAL 0
+#define CMD_SID_EVENT_STAT_DESCRIPTION_ARG_REQUIRED 1
+#define CMD_SID_EVENT_STAT_DESCRIPTION_ARG_OPTIONAL 0
 
 int cmd_nordic_dfu(const struct shell *shell, int32_t argc, const char **argv);
 
@@ -280,6 +283,15 @@ int cmd_sid_set_send_link(const struct shell *shell, int32_t argc, const char **
 int cmd_sid_set_rsp_id(const struct shell *shell, int32_t argc, const char **argv);
 int cmd_sid_sdk_version(const struct shell *shell, int32_t argc, const char **argv);
 int cmd_sid_sdk_config(const struct shell *shell, int32_t argc, const char **argv);
+int cmd_sid_event_stat(const struct shell *shell, int32_t argc, const char **argv);
+
+#ifdef CONFIG_SIDEWALK_HEAP_SLAB_POOLS
+int cmd_sid_print_memory_stats(const struct shell *shell, int32_t argc, const char **argv);
+#endif
+
+#ifdef CONFIG_SIDEWALK_BLE
+int cmd_sid_print_ble_stats(const struct shell *shell, int32_t argc, const char **argv);
+#endif
 
 #ifdef CONFIG_SIDEWALK_TRACE_HEAP
 int cmd_sid_print_heap_stats(const struct shell *shell, int32_t argc, const char **argv);
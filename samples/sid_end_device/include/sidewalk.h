@@ -7,9 +7,11 @@
 #define SIDEWALK_APP_H
 
 #include <sid_api.h>
+#include <sid_hal_memory_ifc.h>
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#include <string.h>
 
 typedef struct {
 	struct sid_handle *handle;
@@ -25,10 +27,17 @@ typedef struct {
 	ctx_free ctx_free;
 } sidewalk_ctx_event_t;
 
+typedef struct {
+	uint32_t high_watermark;
+	uint32_t dropped;
+	uint32_t coalesced;
+} sidewalk_event_stats_t;
+
 typedef struct {
 	sys_snode_t node;
 	struct sid_msg msg;
 	struct sid_msg_desc desc;
+	uint8_t payload[];
 } sidewalk_msg_t;
 
 typedef struct {
@@ -48,6 +57,61 @@ void sidewalk_start(sidewalk_ctx_t *context);
 
 int sidewalk_event_send(event_handler_t event, void *ctx, ctx_free free);
 
+/**
+ * @brief Get usage statistics of the Sidewalk thread event queue.
+ *
+ * The high watermark is the largest number of events waiting in the queue,
+ * dropped counts events not sent because the queue was full, a sidewalk_event_process
+ * without context is not dropped but waits for a free slot,
+ * coalesced counts sidewalk_event_process posts merged into an already pending one.
+ *
+ * @param stats [out] statistics since boot.
+ */
+void sidewalk_event_stats_get(sidewalk_event_stats_t *stats);
+
+/**
+ * @brief Allocate a message with the payload in the same memory block.
+ *
+ * msg.data points to the payload, msg.size is set to @p size, the rest is zeroed.
+ * The caller writes the payload in place, so no copy of it is needed.
+ *
+ * @param size payload size in bytes.
+ * @return message, or NULL if out of memory.
+ */
+static inline sidewalk_msg_t *sidewalk_msg_alloc(size_t size)
+{
+	sidewalk_msg_t *msg = sid_hal_malloc(sizeof(sidewalk_msg_t) + size);
+
+	if (!msg) {
+		return NULL;
+	}
+	memset(msg, 0x0, sizeof(*msg));
+	msg->msg.data = msg->payload;
+	msg->msg.size = size;
+
+	return msg;
+}
+
+/**
+ * @brief Free a message, to be used as ctx_free of sidewalk_event_send_msg.
+ *
+ * Payloads allocated separately from the message are freed as well.
+ *
+ * @param ctx message, may be NULL.
+ */
+static inline void sidewalk_msg_free(void *ctx)
+{
+	sidewalk_msg_t *msg = (sidewalk_msg_t *)ctx;
+
+	if (!msg) {
+		return;
+	}
+	if (msg->msg.data && msg->msg.data != msg->payload) {
+		sid_hal_free(msg->msg.data);
+	}
+	sid_hal_free(msg);
+}
+
 #ifdef CONFIG_SIDEWALK_LINK_MASK_BLE
 #define DEFAULT_LM (uint32_t)(SID_LINK_TYPE_1)
 #elif CONFIG_SIDEWALK_LINK_MASK_FSK
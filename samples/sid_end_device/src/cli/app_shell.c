@@ -17,6 +17,10 @@
 #include <sid_api.h>
 #include <sid_900_cfg.h>
 #include <sid_hal_memory_ifc.h>
+#include <sid_hal_memory_stats.h>
+#ifdef CONFIG_SIDEWALK_BLE
+#include <sid_ble_adapter.h>
+#endif
 
 #include <cli/app_shell.h>
 #include <cli/app_dut.h>
@@ -120,6 +124,17 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	SHELL_CMD_ARG(sdk_config, NULL, CMD_SID_SDK_CONFIG_DESCRIPTION, cmd_sid_sdk_config,
 		      CMD_SID_SDK_CONFIG_DESCRIPTION_ARG_REQUIRED,
 		      CMD_SID_SDK_CONFIG_DESCRIPTION_ARG_OPTIONAL),
+	SHELL_CMD_ARG(event_stat, NULL, CMD_SID_EVENT_STAT_DESCRIPTION, cmd_sid_event_stat,
+		      CMD_SID_EVENT_STAT_DESCRIPTION_ARG_REQUIRED,
+		      CMD_SID_EVENT_STAT_DESCRIPTION_ARG_OPTIONAL),
+#ifdef CONFIG_SIDEWALK_HEAP_SLAB_POOLS
+	SHELL_CMD_ARG(mem_stat, NULL, "print memory pool statistics", cmd_sid_print_memory_stats, 1,
+		      0),
+#endif
+#ifdef CONFIG_SIDEWALK_BLE
+	SHELL_CMD_ARG(ble_stat, NULL, "print BLE notification statistics, -r to reset",
+		      cmd_sid_print_ble_stats, 1, 1),
+#endif
 #ifdef CONFIG_SIDEWALK_TRACE_HEAP
 	SHELL_CMD_ARG(heap_stat, NULL, "print heap statistics", cmd_sid_print_heap_stats, 1, 0),
 #endif
@@ -374,23 +389,11 @@ int cmd_sid_stop(const struct shell *shell, int32_t argc, const char **argv)
 	return cmd_sid_simple_param(dut_event_stop, &link_type);
 }
 
-static void free_sid_send_event_ctx(void *ctx)
-{
-	sidewalk_msg_t *send = (sidewalk_msg_t *)ctx;
-	if (send == NULL) {
-		return;
-	}
-	if (send->msg.data) {
-		sid_hal_free(send->msg.data);
-	}
-	sid_hal_free(send);
-}
-
 int cmd_sid_send(const struct shell *shell, int32_t argc, const char **argv)
 {
 	CHECK_ARGUMENT_COUNT(argc, CMD_SID_SEND_ARG_REQUIRED, CMD_SID_SEND_ARG_OPTIONAL);
 
-	struct sid_msg msg = (struct sid_msg){ .size = 0, .data = NULL };
+	const char *hex_payload = NULL;
 	struct sid_msg_desc desc = (struct sid_msg_desc){
 		.type = SID_MSG_TYPE_NOTIFY,
 		.link_type = cli_cfg.send_link_type,
@@ -472,19 +475,12 @@ int cmd_sid_send(const struct shell *shell, int32_t argc, const char **argv)
 				shell_error(shell, "-r need a value");
 				return -EINVAL;
 			}
-			uint8_t msg_buffer[strlen(argv[opt]) / 2];
-			memset(msg_buffer, 0, sizeof(msg_buffer));
-			msg.size = hex2bin(argv[opt], strlen(argv[opt]), msg_buffer,
-					   sizeof(msg_buffer));
-			if (!msg.size) {
+			size_t hex_len = strlen(argv[opt]);
+			if (!hex_len || hex_len % 2) {
 				shell_error(shell, "failed to parse value as hexstring");
 				return -EINVAL;
 			}
-			msg.data = sid_hal_malloc(msg.size);
-			if (!msg.data) {
-				return -ENOMEM;
-			}
-			memcpy(msg.data, msg_buffer, msg.size);
+			hex_payload = argv[opt];
 			continue;
 		}
 		if (strcmp("-l", argv[opt]) == 0) {
@@ -557,27 +553,27 @@ int cmd_sid_send(const struct shell *shell, int32_t argc, const char **argv)
 		desc.id = cli_cfg.rsp_msg_id;
 	}
 
-	if (!msg.data) {
-		msg.size = strlen(argv[argc - 1]);
-		msg.data = sid_hal_malloc(msg.size);
-		if (!msg.data) {
-			return -ENOMEM;
-		}
-		memcpy(msg.data, argv[argc - 1], msg.size);
-	}
-
-	sidewalk_msg_t *send = sid_hal_malloc(sizeof(sidewalk_msg_t));
+	// Write the payload directly into the message
+	const char *payload = hex_payload ? hex_payload : argv[argc - 1];
+	size_t payload_len = strlen(payload);
+	sidewalk_msg_t *send = sidewalk_msg_alloc(hex_payload ? payload_len / 2 : payload_len);
 	if (!send) {
-		sid_hal_free(msg.data);
 		return -ENOMEM;
 	}
-	memset(send, 0x0, sizeof(*send));
-	memcpy(&send->msg, &msg, sizeof(struct sid_msg));
+	if (hex_payload) {
+		if (!hex2bin(payload, payload_len, send->msg.data, send->msg.size)) {
+			sidewalk_msg_free(send);
+			shell_error(shell, "failed to parse value as hexstring");
+			return -EINVAL;
+		}
+	} else {
+		memcpy(send->msg.data, payload, send->msg.size);
+	}
 	memcpy(&send->desc, &desc, sizeof(struct sid_msg_desc));
 
-	int err = sidewalk_event_send(sidewalk_event_send_msg, send, free_sid_send_event_ctx);
+	int err = sidewalk_event_send(sidewalk_event_send_msg, send, sidewalk_msg_free);
 	if (err) {
-		free_sid_send_event_ctx(send);
+		sidewalk_msg_free(send);
 		return -ENOMSG;
 	}
 
@@ -1126,6 +1122,66 @@ int cmd_sid_sdk_config(const struct shell *shell, int32_t argc, const char **arg
 	return 0;
 }
 
+int cmd_sid_event_stat(const struct shell *shell, int32_t argc, const char **argv)
+{
+	CHECK_ARGUMENT_COUNT(argc, CMD_SID_EVENT_STAT_DESCRIPTION_ARG_REQUIRED,
+			     CMD_SID_EVENT_STAT_DESCRIPTION_ARG_OPTIONAL);
+	sidewalk_event_stats_t stats = {};
+
+	sidewalk_event_stats_get(&stats);
+	shell_info(shell, "queue size: %d", CONFIG_SIDEWALK_THREAD_QUEUE_SIZE);
+	shell_info(shell, "high watermark: %u", stats.high_watermark);
+	shell_info(shell, "dropped: %u", stats.dropped);
+	shell_info(shell, "coalesced: %u", stats.coalesced);
+	return 0;
+}
+
+#ifdef CONFIG_SIDEWALK_HEAP_SLAB_POOLS
+int cmd_sid_print_memory_stats(const struct shell *shell, int32_t argc, const char **argv)
+{
+	struct sid_hal_memory_stats stats;
+
+	sid_hal_memory_stats_get(&stats);
+	for (size_t i = 0; i < ARRAY_SIZE(stats.pools); i++) {
+		struct sid_hal_memory_pool_stats *pool = &stats.pools[i];
+
+		shell_info(shell, "pool %4zu: used %u/%u max %u hits %u misses %u",
+			   pool->block_size, pool->used, pool->num_blocks, pool->max_used,
+			   pool->hits, pool->misses);
+	}
+	shell_info(shell, "heap: size %zu free %zu max allocated %zu", stats.heap_size,
+		   stats.heap_free, stats.heap_max_allocated);
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_SIDEWALK_BLE
+int cmd_sid_print_ble_stats(const struct shell *shell, int32_t argc, const char **argv)
+{
+	struct sid_ble_adapter_send_stats stats;
+
+	if (argc == 2 && !strcmp(argv[1], "-r")) {
+		sid_ble_adapter_send_stats_reset();
+		return 0;
+	}
+
+	if (sid_ble_adapter_send_stats_get(&stats) != SID_ERROR_NONE) {
+		return -EINVAL;
+	}
+	shell_info(shell, "queue depth: %u", stats.queue_depth);
+	shell_info(shell, "queued %u sent %u bytes %llu queue full %u", stats.notify.queued,
+		   stats.notify.sent, stats.notify.bytes, stats.notify.queue_full);
+	shell_info(shell, "in flight %u max %u", stats.notify.in_flight,
+		   stats.notify.max_in_flight);
+	if (stats.per_conn_event_x100 && stats.throughput) {
+		shell_info(shell, "per connection event %u.%02u, throughput %u B/s",
+			   stats.per_conn_event_x100 / 100, stats.per_conn_event_x100 % 100,
+			   stats.throughput);
+	}
+	return 0;
+}
+#endif
+
 #ifdef CONFIG_SIDEWALK_TRACE_HEAP
 int cmd_sid_print_heap_stats(const struct shell *shell, int32_t argc, const char **argv)
 {
@@ -47,18 +47,6 @@ static void on_sidewalk_event(bool in_isr, void *context)
 	};
 }
 
-static void free_sid_echo_event_ctx(void *ctx)
-{
-	sidewalk_msg_t *echo = (sidewalk_msg_t *)ctx;
-	if (echo == NULL) {
-		return;
-	}
-	if (echo->msg.data) {
-		sid_hal_free(echo->msg.data);
-	}
-	sid_hal_free(echo);
-}
-
 static void on_sidewalk_msg_received(const struct sid_msg_desc *msg_desc, const struct sid_msg *msg,
 				     void *context)
 {
@@ -73,17 +61,9 @@ static void on_sidewalk_msg_received(const struct sid_msg_desc *msg_desc, const
 #ifdef CONFIG_SID_END_DEVICE_ECHO_MSGS
 	if (msg_desc->type == SID_MSG_TYPE_GET || msg_desc->type == SID_MSG_TYPE_SET) {
 		LOG_INF("Send echo message");
-		sidewalk_msg_t *echo = sid_hal_malloc(sizeof(sidewalk_msg_t));
+		sidewalk_msg_t *echo = sidewalk_msg_alloc(msg->size);
 		if (!echo) {
-			LOG_ERR("Failed to allocate event context for echo message");
-			return;
-		}
-		memset(echo, 0x0, sizeof(*echo));
-		echo->msg.size = msg->size;
-		echo->msg.data = sid_hal_malloc(echo->msg.size);
-		if (!echo->msg.data) {
-			LOG_ERR("Failed to allocate memory for message echo data");
-			sid_hal_free(echo);
+			LOG_ERR("Failed to allocate memory for echo message");
 			return;
 		}
 		memcpy(echo->msg.data, msg->data, echo->msg.size);
@@ -95,10 +75,9 @@ static void on_sidewalk_msg_received(const struct sid_msg_desc *msg_desc, const
 		echo->desc.link_type = SID_LINK_TYPE_ANY;
 		echo->desc.link_mode = SID_LINK_MODE_CLOUD;
 
-		int err =
-			sidewalk_event_send(sidewalk_event_send_msg, echo, free_sid_echo_event_ctx);
+		int err = sidewalk_event_send(sidewalk_event_send_msg, echo, sidewalk_msg_free);
 		if (err) {
-			free_sid_echo_event_ctx(echo);
+			sidewalk_msg_free(echo);
 			LOG_ERR("Send event err %d", err);
 		} else {
 #if defined(CONFIG_STATE_NOTIFIER)
@@ -206,36 +185,15 @@ static void on_sidewalk_status_changed(const struct sid_status *status, void *co
 		}
 	}
 }
-static void free_sid_hello_event_ctx(void *ctx)
-{
-	sidewalk_msg_t *hello = (sidewalk_msg_t *)ctx;
-	if (hello == NULL) {
-		return;
-	}
-	if (hello->msg.data) {
-		sid_hal_free(hello->msg.data);
-	}
-	sid_hal_free(hello);
-}
-
 static void app_btn_send_msg(uint32_t unused)
 {
 	ARG_UNUSED(unused);
 
 	LOG_INF("Send hello message");
 	const char payload[] = "hello";
-	sidewalk_msg_t *hello = sid_hal_malloc(sizeof(sidewalk_msg_t));
+	sidewalk_msg_t *hello = sidewalk_msg_alloc(sizeof(payload));
 	if (!hello) {
-		LOG_ERR("Failed to alloc memory for message context");
-		return;
-	}
-	memset(hello, 0x0, sizeof(*hello));
-
-	hello->msg.size = sizeof(payload);
-	hello->msg.data = sid_hal_malloc(hello->msg.size);
-	if (!hello->msg.data) {
-		sid_hal_free(hello);
-		LOG_ERR("Failed to allocate memory for message data");
+		LOG_ERR("Failed to alloc memory for message");
 		return;
 	}
 	memcpy(hello->msg.data, payload, hello->msg.size);
@@ -244,9 +202,9 @@ static void app_btn_send_msg(uint32_t unused)
 	hello->desc.link_type = SID_LINK_TYPE_ANY;
 	hello->desc.link_mode = SID_LINK_MODE_CLOUD;
 
-	int err = sidewalk_event_send(sidewalk_event_send_msg, hello, free_sid_hello_event_ctx);
+	int err = sidewalk_event_send(sidewalk_event_send_msg, hello, sidewalk_msg_free);
 	if (err) {
-		free_sid_hello_event_ctx(hello);
+		sidewalk_msg_free(hello);
 		LOG_ERR("Send event err %d", err);
 	} else {
 #if defined(CONFIG_STATE_NOTIFIER)
@@ -11,7 +11,6 @@
 #include <sidewalk.h>
 #include <sid_demo_parser.h>
 #include <sid_pal_uptime_ifc.h>
-#include <sid_hal_memory_ifc.h>
 #include <zephyr/kernel.h>
 #include <zephyr/smf.h>
 #include <zephyr/logging/log.h>
@@ -82,52 +81,38 @@ static uint32_t last_link_mask_get(void)
 	return last_link_mask;
 }
 
-static void free_sid_msg_event_ctx(void *ctx)
-{
-	sidewalk_msg_t *sid_msg = (sidewalk_msg_t *)ctx;
-	if (sid_msg == NULL) {
-		return;
-	}
-	if (sid_msg->msg.data) {
-		sid_hal_free(sid_msg->msg.data);
-	}
-	sid_hal_free(sid_msg);
-}
-
 static int app_tx_demo_msg_send(struct sid_parse_state *state, uint8_t *buffer,
 				struct sid_demo_msg_desc *demo_desc, struct sid_msg_desc *sid_desc)
 {
-	// Serialize demo message
+	// Serialize demo message directly into the sidewalk message payload
 	struct sid_demo_msg demo_msg = { .payload = buffer, .payload_size = state->offset };
-	uint8_t msg_buffer[DEMO_MSG_PAYLOAD_MAX_SIXE] = { 0 };
-	sid_parse_state_init(state, msg_buffer, sizeof(msg_buffer));
-	sid_demo_app_msg_serialize(state, demo_desc, &demo_msg);
-	if (state->ret_code != SID_ERROR_NONE) {
-		LOG_DBG("Demo msg serialize failed -%d (%s)", state->ret_code,
-			SID_ERROR_T_STR(state->ret_code));
+	size_t size = sid_demo_app_msg_serialized_size(demo_desc, &demo_msg);
+	if (size > DEMO_MSG_PAYLOAD_MAX_SIXE) {
+		LOG_DBG("Demo msg too long %zu", size);
 		return -EINVAL;
 	}
 
-	// Send sidewalk message
-	sidewalk_msg_t *sid_msg = sid_hal_malloc(sizeof(sidewalk_msg_t));
+	sidewalk_msg_t *sid_msg = sidewalk_msg_alloc(size);
 	if (!sid_msg) {
-		LOG_ERR("Failed to alloc memory for message context");
+		LOG_ERR("Failed to alloc memory for message");
 		return -ENOMEM;
 	}
-	memset(sid_msg, 0x0, sizeof(*sid_msg));
-	sid_msg->msg.size = state->offset;
-	sid_msg->msg.data = sid_hal_malloc(sid_msg->msg.size);
-	if (!sid_msg->msg.data) {
-		sid_hal_free(sid_msg);
-		LOG_ERR("Failed to allocate memory for message data");
-		return -ENOMEM;
+
+	sid_parse_state_init(state, sid_msg->msg.data, sid_msg->msg.size);
+	sid_demo_app_msg_serialize(state, demo_desc, &demo_msg);
+	if (state->ret_code != SID_ERROR_NONE) {
+		LOG_DBG("Demo msg serialize failed -%d (%s)", state->ret_code,
+			SID_ERROR_T_STR(state->ret_code));
+		sidewalk_msg_free(sid_msg);
+		return -EINVAL;
 	}
-	memcpy(sid_msg->msg.data, msg_buffer, sid_msg->msg.size);
+	sid_msg->msg.size = state->offset;
 	memcpy(&sid_msg->desc, sid_desc, sizeof(struct sid_msg_desc));
 
-	int err = sidewalk_event_send(sidewalk_event_send_msg, sid_msg, free_sid_msg_event_ctx);
+	// Send sidewalk message
+	int err = sidewalk_event_send(sidewalk_event_send_msg, sid_msg, sidewalk_msg_free);
 	if (err) {
-		free_sid_msg_event_ctx(sid_msg);
+		sidewalk_msg_free(sid_msg);
 		LOG_ERR("Event send err %d", err);
 		return -EIO;
 	};
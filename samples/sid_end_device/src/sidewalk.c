@@ -15,10 +15,216 @@ LOG_MODULE_REGISTER(sidewalk_app, CONFIG_SIDEWALK_LOG_LEVEL);
 static struct k_thread sid_thread;
 K_THREAD_STACK_DEFINE(sid_thread_stack, CONFIG_SIDEWALK_THREAD_STACK_SIZE);
 
+K_SEM_DEFINE(sid_thread_started, 0, 1);
+
+static atomic_t event_high_watermark;
+static atomic_t event_dropped;
+static atomic_t event_coalesced;
+
+static void event_high_watermark_update(uint32_t used)
+{
+	atomic_val_t max = atomic_get(&event_high_watermark);
+
+	while (used > (uint32_t)max && !atomic_cas(&event_high_watermark, max, used)) {
+		max = atomic_get(&event_high_watermark);
+	}
+}
+
+#if CONFIG_SIDEWALK_THREAD_QUEUE_RING
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_SIDEWALK_THREAD_QUEUE_SIZE),
+	     "Sidewalk event ring size must be a power of two");
+
+#define EVENT_RING_MASK (CONFIG_SIDEWALK_THREAD_QUEUE_SIZE - 1)
+
+/*
+ * Bounded multi producer, single consumer ring with a sequence number per slot.
+ * A slot at position pos is free for a producer when its sequence equals pos,
+ * and holds an event for the consumer when its sequence equals pos + 1.
+ * Sequences are stored relative to the slot index, so the zero initialized ring
+ * starts with all slots free.
+ */
+struct event_slot {
+	atomic_t sequence;
+	sidewalk_ctx_event_t event;
+};
+
+static struct event_slot event_ring[CONFIG_SIDEWALK_THREAD_QUEUE_SIZE];
+static atomic_t event_ring_head;
+static atomic_t event_ring_tail;
+static atomic_t event_process_pending;
+
+/* States of event_process_pending */
+enum {
+	EVENT_PROCESS_IDLE,
+	EVENT_PROCESS_QUEUED,
+	/* Posted while the ring was full, put into the ring once a slot is free */
+	EVENT_PROCESS_WAITING,
+};
+
+/* Given once per published event */
+K_SEM_DEFINE(event_ring_sem, 0, K_SEM_MAX_LIMIT);
+/* Semaphore counts taken by the consumer for events not consumed yet */
+static uint32_t event_ring_taken;
+
+static inline uint32_t event_ring_sequence_get(uint32_t index)
+{
+	return (uint32_t)atomic_get(&event_ring[index].sequence) + index;
+}
+
+static inline void event_ring_sequence_set(uint32_t index, uint32_t sequence)
+{
+	atomic_set(&event_ring[index].sequence, (atomic_val_t)(uint32_t)(sequence - index));
+}
+
+/* Only one sidewalk_event_process without context is kept in the ring */
+static inline bool event_coalescable(const sidewalk_ctx_event_t *event)
+{
+	return event->handler == sidewalk_event_process && !event->ctx && !event->ctx_free;
+}
+
+static int event_ring_put(const sidewalk_ctx_event_t *event)
+{
+	uint32_t head = (uint32_t)atomic_get(&event_ring_head);
+	uint32_t index;
+
+	while (true) {
+		index = head & EVENT_RING_MASK;
+		int32_t diff = (int32_t)(event_ring_sequence_get(index) - head);
+
+		if (diff == 0) {
+			if (atomic_cas(&event_ring_head, head, (uint32_t)(head + 1))) {
+				break;
+			}
+		} else if (diff < 0) {
+			return -ENOMSG;
+		}
+		head = (uint32_t)atomic_get(&event_ring_head);
+	}
+
+	event_ring[index].event = *event;
+	event_ring_sequence_set(index, head + 1);
+	event_high_watermark_update(head + 1 - (uint32_t)atomic_get(&event_ring_tail));
+	k_sem_give(&event_ring_sem);
+
+	return 0;
+}
+
+/*
+ * Coalesced posts count on the pending sidewalk_event_process, so it is not dropped when
+ * the ring is full but left waiting, and the consumer puts it into the ring after it frees
+ * a slot. If the consumer freed one meanwhile it may have missed the waiting state,
+ * then the put is tried again.
+ */
+static void event_process_put(const sidewalk_ctx_event_t *event)
+{
+	do {
+		uint32_t tail = (uint32_t)atomic_get(&event_ring_tail);
+
+		if (event_ring_put(event) == 0) {
+			return;
+		}
+		atomic_set(&event_process_pending, EVENT_PROCESS_WAITING);
+		if (tail == (uint32_t)atomic_get(&event_ring_tail)) {
+			return;
+		}
+	} while (atomic_cas(&event_process_pending, EVENT_PROCESS_WAITING, EVENT_PROCESS_QUEUED));
+}
+
+static int sidewalk_event_get(sidewalk_ctx_event_t *event)
+{
+	uint32_t tail = (uint32_t)atomic_get(&event_ring_tail);
+	uint32_t index = tail & EVENT_RING_MASK;
+
+	/*
+	 * A producer of a later slot may have published first, block until the next
+	 * event is published. The producer of this slot publishes it eventually,
+	 * the counts taken meanwhile belong to the later slots.
+	 */
+	while (!event_ring_taken || event_ring_sequence_get(index) != tail + 1) {
+		int err = k_sem_take(&event_ring_sem, K_FOREVER);
+
+		if (err) {
+			return err;
+		}
+		event_ring_taken++;
+	}
+	event_ring_taken--;
+
+	*event = event_ring[index].event;
+	event_ring_sequence_set(index, tail + CONFIG_SIDEWALK_THREAD_QUEUE_SIZE);
+	atomic_set(&event_ring_tail, (uint32_t)(tail + 1));
+
+	/* Clear before the handler runs, so a post during processing is not lost */
+	if (event_coalescable(event)) {
+		atomic_set(&event_process_pending, EVENT_PROCESS_IDLE);
+	} else if (atomic_cas(&event_process_pending, EVENT_PROCESS_WAITING,
+			      EVENT_PROCESS_QUEUED)) {
+		event_process_put(&(sidewalk_ctx_event_t){ .handler = sidewalk_event_process });
+	}
+
+	return 0;
+}
+
+static inline uint32_t sidewalk_event_used(void)
+{
+	return (uint32_t)atomic_get(&event_ring_head) - (uint32_t)atomic_get(&event_ring_tail);
+}
+
+static int sidewalk_event_put(const sidewalk_ctx_event_t *event)
+{
+	if (event_coalescable(event)) {
+		if (atomic_cas(&event_process_pending, EVENT_PROCESS_IDLE, EVENT_PROCESS_QUEUED)) {
+			event_process_put(event);
+		} else {
+			atomic_inc(&event_coalesced);
+		}
+		return 0;
+	}
+
+	int err = event_ring_put(event);
+
+	if (err) {
+		atomic_inc(&event_dropped);
+	}
+
+	return err;
+}
+
+#else
 K_MSGQ_DEFINE(sidewalk_thread_msgq, sizeof(sidewalk_ctx_event_t), CONFIG_SIDEWALK_THREAD_QUEUE_SIZE,
 	      4);
 
-K_SEM_DEFINE(sid_thread_started, 0, 1);
+static int sidewalk_event_put(const sidewalk_ctx_event_t *event)
+{
+	k_timeout_t timeout = K_NO_WAIT;
+
+#if defined(CONFIG_SIDEWALK_THREAD_QUEUE_TIMEOUT_VALUE) &&                                         \
+	CONFIG_SIDEWALK_THREAD_QUEUE_TIMEOUT_VALUE > 0
+	if (!k_is_in_isr()) {
+		timeout = K_MSEC(CONFIG_SIDEWALK_THREAD_QUEUE_TIMEOUT_VALUE);
+	}
+#endif /* CONFIG_SIDEWALK_THREAD_QUEUE_TIMEOUT_VALUE > 0 */
+	int err = k_msgq_put(&sidewalk_thread_msgq, (void *)event, timeout);
+
+	if (err) {
+		atomic_inc(&event_dropped);
+	} else {
+		event_high_watermark_update(k_msgq_num_used_get(&sidewalk_thread_msgq));
+	}
+
+	return err;
+}
+
+static inline int sidewalk_event_get(sidewalk_ctx_event_t *event)
+{
+	return k_msgq_get(&sidewalk_thread_msgq, event, K_FOREVER);
+}
+
+static inline uint32_t sidewalk_event_used(void)
+{
+	return k_msgq_num_used_get(&sidewalk_thread_msgq);
+}
+#endif /* CONFIG_SIDEWALK_THREAD_QUEUE_RING */
 
 static void sid_thread_entry(void *context, void *unused, void *unused2)
 {
@@ -31,13 +237,12 @@ static void sid_thread_entry(void *context, void *unused, void *unused2)
 	k_sem_give(&sid_thread_started);
 
 	while (1) {
-		int err = k_msgq_get(&sidewalk_thread_msgq, &event, K_FOREVER);
+		int err = sidewalk_event_get(&event);
 		switch (err) {
 		case 0: {
 			LOG_DBG("event received %p (%s) sidewalk workq usage (%d/%d) ( after get )",
 				(void *)(event.handler), EVENT_TO_NAME(event.handler),
-				k_msgq_num_used_get(&sidewalk_thread_msgq),
-				CONFIG_SIDEWALK_THREAD_QUEUE_SIZE);
+				sidewalk_event_used(), CONFIG_SIDEWALK_THREAD_QUEUE_SIZE);
 			if (event.handler) {
 				event.handler(sid, event.ctx);
 			}
@@ -77,19 +282,18 @@ int sidewalk_event_send(event_handler_t event, void *ctx, ctx_free free)
 		.ctx_free = free,
 	};
 
-	k_timeout_t timeout = K_NO_WAIT;
-	int result = -EFAULT;
+	int result = sidewalk_event_put(&ctx_event);
 
-#if defined(CONFIG_SIDEWALK_THREAD_QUEUE_TIMEOUT_VALUE) &&                                         \
-	CONFIG_SIDEWALK_THREAD_QUEUE_TIMEOUT_VALUE > 0
-	if (!k_is_in_isr()) {
-		timeout = K_MSEC(CONFIG_SIDEWALK_THREAD_QUEUE_TIMEOUT_VALUE);
-	}
-#endif /* CONFIG_SIDEWALK_THREAD_QUEUE_TIMEOUT_VALUE > 0 */
-	result = k_msgq_put(&sidewalk_thread_msgq, (void *)&ctx_event, timeout);
-	LOG_DBG("sidewalk_event_send event = %p (%s), context = %p, k_msgq_put result %d sidewalk workq usage (%d/%d) (after put)",
-		(void *)event, EVENT_TO_NAME(event), ctx, result,
-		k_msgq_num_used_get(&sidewalk_thread_msgq), CONFIG_SIDEWALK_THREAD_QUEUE_SIZE);
+	LOG_DBG("sidewalk_event_send event = %p (%s), context = %p, put result %d sidewalk workq usage (%d/%d) (after put)",
+		(void *)event, EVENT_TO_NAME(event), ctx, result, sidewalk_event_used(),
+		CONFIG_SIDEWALK_THREAD_QUEUE_SIZE);
 
 	return result;
 }
+
+void sidewalk_event_stats_get(sidewalk_event_stats_t *stats)
+{
+	stats->high_watermark = (uint32_t)atomic_get(&event_high_watermark);
+	stats->dropped = (uint32_t)atomic_get(&event_dropped);
+	stats->coalesced = (uint32_t)atomic_get(&event_coalesced);
+}
@@ -23,6 +23,9 @@
 #ifdef CONFIG_SID_END_DEVICE_PERSISTENT_LINK_MASK
 #include <settings_utils.h>
 #endif /* CONFIG_SID_END_DEVICE_PERSISTENT_LINK_MASK */
+#ifdef CONFIG_SIDEWALK_STORAGE_CACHE
+#include <sid_storage_cache.h>
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
 
 #ifdef CONFIG_SIDEWALK_FILE_TRANSFER_DFU
 #include <sbdt/dfu_file_transfer.h>
@@ -325,6 +328,9 @@ void sidewalk_event_exit(sidewalk_ctx_t *sid, void *ctx)
 void sidewalk_event_reboot(sidewalk_ctx_t *sid, void *ctx)
 {
 	LOG_INF("Rebooting...");
+#ifdef CONFIG_SIDEWALK_STORAGE_CACHE
+	(void)sid_storage_cache_flush();
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
 	LOG_PANIC();
 	sys_reboot(SYS_REBOOT_WARM);
 }
@@ -36,6 +36,15 @@ void sid_demo_app_msg_serialize(struct sid_parse_state *const state,
                                 struct sid_demo_msg_desc *msg_desc,
                                 struct sid_demo_msg *msg);
 
+/**
+ * returns the number of bytes sid_demo_app_msg_serialize writes for the message
+ *
+ * @param[in] pointer to the sid demo app message descriptor structure.
+ * @param[in] pointer to the sid demo app message structure, may be NULL.
+ */
+size_t sid_demo_app_msg_serialized_size(const struct sid_demo_msg_desc *msg_desc,
+                                        const struct sid_demo_msg *msg);
+
 /**
  * serializes the demo app capability structure fields to a buffer
  *
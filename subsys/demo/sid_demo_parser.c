@@ -45,6 +45,20 @@ void sid_demo_app_msg_serialize(struct sid_parse_state *const state,
     }
 }
 
+size_t sid_demo_app_msg_serialized_size(const struct sid_demo_msg_desc *msg_desc,
+                                        const struct sid_demo_msg *msg)
+{
+    size_t size = sizeof(uint8_t);
+
+    if (msg_desc->status_hdr_ind) {
+        size += sizeof(msg_desc->status_code);
+    }
+    if (msg && msg->payload_size) {
+        size += msg->payload_size;
+    }
+    return size;
+}
+
 void sid_demo_app_msg_deserialize(struct sid_parse_state *const state,
                                   struct sid_demo_msg_desc *msg_desc, struct sid_demo_msg *msg)
 {
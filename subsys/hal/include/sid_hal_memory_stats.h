@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SID_HAL_MEMORY_STATS_H
+#define SID_HAL_MEMORY_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** Number of block size classes served before the Sidewalk heap. */
+#define SID_HAL_MEMORY_POOL_COUNT 4
+
+struct sid_hal_memory_pool_stats {
+	/** Size of one block in bytes. */
+	size_t block_size;
+	/** Number of blocks in the pool. */
+	uint32_t num_blocks;
+	/** Number of blocks allocated now. */
+	uint32_t used;
+	/** Largest number of blocks allocated at the same time. */
+	uint32_t max_used;
+	/** Allocations served by the pool. */
+	uint32_t hits;
+	/** Allocations of this class served by the heap because the pool was empty. */
+	uint32_t misses;
+};
+
+struct sid_hal_memory_stats {
+	/** Block pools, ordered by block size. Zeroed without CONFIG_SIDEWALK_HEAP_SLAB_POOLS. */
+	struct sid_hal_memory_pool_stats pools[SID_HAL_MEMORY_POOL_COUNT];
+	/** Size of the backing heap in bytes. */
+	size_t heap_size;
+	/** Free bytes in the heap, 0 without CONFIG_SYS_HEAP_RUNTIME_STATS. */
+	size_t heap_free;
+	/** Largest number of allocated heap bytes, 0 without CONFIG_SYS_HEAP_RUNTIME_STATS. */
+	size_t heap_max_allocated;
+};
+
+/**
+ * @brief Get usage statistics of the Sidewalk memory.
+ *
+ * Nothing is allocated, so it is safe to call while Sidewalk is running.
+ *
+ * @param stats [out] statistics since boot.
+ */
+void sid_hal_memory_stats_get(struct sid_hal_memory_stats *stats);
+
+#endif /* SID_HAL_MEMORY_STATS_H */
@@ -14,6 +14,7 @@
  */
 
 #include <sid_hal_memory_ifc.h>
+#include <sid_hal_memory_stats.h>
 
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
@@ -41,6 +42,83 @@ LOG_MODULE_REGISTER(hal_memory, CONFIG_SIDEWALK_LOG_LEVEL);
 
 K_HEAP_DEFINE(sid_heap, HEAP_SIZE);
 
+#if CONFIG_SIDEWALK_HEAP_SLAB_POOLS
+/* Same alignment as the heap chunks, so the caller cannot tell where the block came from */
+#define SLAB_BLOCK_ALIGN 8
+
+K_MEM_SLAB_DEFINE_STATIC(sid_slab_16, 16, CONFIG_SIDEWALK_HEAP_SLAB_16_COUNT, SLAB_BLOCK_ALIGN);
+K_MEM_SLAB_DEFINE_STATIC(sid_slab_32, 32, CONFIG_SIDEWALK_HEAP_SLAB_32_COUNT, SLAB_BLOCK_ALIGN);
+K_MEM_SLAB_DEFINE_STATIC(sid_slab_64, 64, CONFIG_SIDEWALK_HEAP_SLAB_64_COUNT, SLAB_BLOCK_ALIGN);
+K_MEM_SLAB_DEFINE_STATIC(sid_slab_256, 256, CONFIG_SIDEWALK_HEAP_SLAB_256_COUNT,
+			 SLAB_BLOCK_ALIGN);
+
+struct slab_pool {
+	struct k_mem_slab *slab;
+	atomic_t hits;
+	atomic_t misses;
+	atomic_t max_used;
+};
+
+/* Ordered by block size, the first pool with large enough blocks serves the allocation */
+static struct slab_pool slab_pools[] = {
+	{ .slab = &sid_slab_16 },
+	{ .slab = &sid_slab_32 },
+	{ .slab = &sid_slab_64 },
+	{ .slab = &sid_slab_256 },
+};
+
+BUILD_ASSERT(ARRAY_SIZE(slab_pools) == SID_HAL_MEMORY_POOL_COUNT);
+
+static bool slab_pool_contains(const struct slab_pool *pool, const void *ptr)
+{
+	const char *buffer = pool->slab->buffer;
+	size_t size = pool->slab->info.num_blocks * pool->slab->info.block_size;
+
+	return (const char *)ptr >= buffer && (const char *)ptr < buffer + size;
+}
+
+/* Returns NULL if the size has no class or its pool is empty, the heap serves it then */
+static void *slab_alloc(size_t size)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(slab_pools); i++) {
+		struct slab_pool *pool = &slab_pools[i];
+		void *block = NULL;
+
+		if (size > pool->slab->info.block_size) {
+			continue;
+		}
+
+		if (k_mem_slab_alloc(pool->slab, &block, K_NO_WAIT)) {
+			atomic_inc(&pool->misses);
+			return NULL;
+		}
+
+		atomic_val_t used = k_mem_slab_num_used_get(pool->slab);
+		atomic_val_t max = atomic_get(&pool->max_used);
+
+		while (used > max && !atomic_cas(&pool->max_used, max, used)) {
+			max = atomic_get(&pool->max_used);
+		}
+		atomic_inc(&pool->hits);
+		return block;
+	}
+
+	return NULL;
+}
+
+static bool slab_free(void *ptr)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(slab_pools); i++) {
+		if (slab_pool_contains(&slab_pools[i], ptr)) {
+			k_mem_slab_free(slab_pools[i].slab, ptr);
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_SIDEWALK_HEAP_SLAB_POOLS */
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 static void heap_alloc_stats(struct sys_heap *p_heap, size_t mem_to_alloc)
 {
@@ -101,11 +179,20 @@ void print_open_buffers(void){
 
 void *sid_hal_malloc(size_t size)
 {
-    #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-	heap_alloc_stats(&sid_heap.heap, size);
-    #endif
+	void *ptr = NULL;
+
+#if CONFIG_SIDEWALK_HEAP_SLAB_POOLS
+	if (size) {
+		ptr = slab_alloc(size);
+	}
+#endif /* CONFIG_SIDEWALK_HEAP_SLAB_POOLS */
 
-	void * ptr = k_heap_alloc(&sid_heap, size, K_NO_WAIT);
+	if (!ptr) {
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		heap_alloc_stats(&sid_heap.heap, size);
+#endif
+		ptr = k_heap_alloc(&sid_heap, size, K_NO_WAIT);
+	}
 	#if CONFIG_SIDEWALK_TRACE_HEAP
 	LOG_DBG("Alloc %d bytes at addr %p", size, ptr);
 	alloc_stat++;
@@ -125,5 +212,38 @@ void sid_hal_free(void *ptr)
     	free_stat++;
 	remove_buffer(ptr);
 	#endif /* CONFIG_SIDEWALK_TRACE_HEAP */
+#if CONFIG_SIDEWALK_HEAP_SLAB_POOLS
+	if (slab_free(ptr)) {
+		return;
+	}
+#endif /* CONFIG_SIDEWALK_HEAP_SLAB_POOLS */
     k_heap_free(&sid_heap, ptr);
 }
+
+void sid_hal_memory_stats_get(struct sid_hal_memory_stats *stats)
+{
+	*stats = (struct sid_hal_memory_stats){ .heap_size = HEAP_SIZE };
+
+#if CONFIG_SIDEWALK_HEAP_SLAB_POOLS
+	for (size_t i = 0; i < ARRAY_SIZE(slab_pools); i++) {
+		struct slab_pool *pool = &slab_pools[i];
+
+		stats->pools[i] = (struct sid_hal_memory_pool_stats){
+			.block_size = pool->slab->info.block_size,
+			.num_blocks = pool->slab->info.num_blocks,
+			.used = k_mem_slab_num_used_get(pool->slab),
+			.max_used = atomic_get(&pool->max_used),
+			.hits = atomic_get(&pool->hits),
+			.misses = atomic_get(&pool->misses),
+		};
+	}
+#endif /* CONFIG_SIDEWALK_HEAP_SLAB_POOLS */
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	struct sys_memory_stats heap_stats = {};
+
+	sys_heap_runtime_stats_get(&sid_heap.heap, &heap_stats);
+	stats->heap_free = heap_stats.free_bytes;
+	stats->heap_max_allocated = heap_stats.max_allocated_bytes;
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+}
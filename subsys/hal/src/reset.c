@@ -11,10 +11,16 @@
 #include <sid_hal_reset_ifc.h>
 #include <zephyr/sys/reboot.h>
 #include <zephyr/kernel.h>
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+#include <sid_storage_cache.h>
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
 
 sid_error_t sid_hal_reset(sid_hal_reset_type_t type)
 {
 	if (SID_HAL_RESET_NORMAL == type) {
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+		(void)sid_storage_cache_flush();
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
 		sys_reboot(SYS_REBOOT_WARM);
 	} else {
 		return SID_ERROR_NOSUPPORT;
@@ -84,6 +84,26 @@ struct sid_pal_serial_bus_client {
     void *client_selector_context;
 };
 
+/**
+ * Describes one segment of a scatter-gather transfer.
+ */
+struct sid_pal_serial_bus_buf {
+    /** data to be sent, if NULL the bus sends its filler byte.*/
+    const uint8_t *tx;
+    /** buffer for the received data, if NULL the received data is discarded.*/
+    uint8_t *rx;
+    /** length of the segment.*/
+    size_t len;
+};
+
+/**
+ * Callback called when an asynchronous transfer is finished.
+ *
+ * @param[in] result SID_ERROR_NONE if the transfer succeeded, error code otherwise.
+ * @param[in] context The context pointer given to #sid_pal_serial_bus_iface::xfer_async.
+ */
+typedef void (*sid_pal_serial_bus_xfer_done_t)(sid_error_t result, void *context);
+
 struct sid_pal_serial_bus_iface;
 
 /**
@@ -126,6 +146,48 @@ struct sid_pal_serial_bus_iface {
      * @param[in] iface pointer to serial bus interface.
      */
     sid_error_t (*destroy)(const struct sid_pal_serial_bus_iface *iface);
+    /**
+     * Callback to transfer messages in full duplex mode from and to several buffers.
+     *
+     * All segments are transferred back to back while the client is selected, so the
+     * caller does not have to assemble the message in one buffer.
+     *
+     * Optional, may be NULL. Callers fall back to #xfer in that case.
+     *
+     * @param[in] iface pointer to serial bus interface.
+     * @param[in] client pointer to serial bus client.
+     * @param[in] bufs segments of the message, in order of transfer.
+     * @param[in] count number of segments.
+     */
+    sid_error_t (*xfer_sg)(const struct sid_pal_serial_bus_iface *iface,
+                           const struct sid_pal_serial_bus_client *client,
+                           const struct sid_pal_serial_bus_buf *bufs,
+                           size_t count);
+    /**
+     * Callback to start a scatter-gather transfer without waiting for its end.
+     *
+     * The segments and the buffers they point to must stay valid until #done is called.
+     * #done may be called from interrupt context, or before this callback returns.
+     * One transfer at a time may be in progress, the next one must not be started from #done.
+     *
+     * Optional, may be NULL. Callers fall back to #xfer_sg or #xfer in that case.
+     *
+     * @param[in] iface pointer to serial bus interface.
+     * @param[in] client pointer to serial bus client.
+     * @param[in] bufs segments of the message, in order of transfer.
+     * @param[in] count number of segments.
+     * @param[in] done callback called when the transfer is finished.
+     * @param[in] context pointer passed to #done.
+     *
+     * @retval SID_ERROR_NONE if the transfer was started, #done is called in that case only.
+     * @retval SID_ERROR_BUSY if another transfer is in progress.
+     */
+    sid_error_t (*xfer_async)(const struct sid_pal_serial_bus_iface *iface,
+                              const struct sid_pal_serial_bus_client *client,
+                              const struct sid_pal_serial_bus_buf *bufs,
+                              size_t count,
+                              sid_pal_serial_bus_xfer_done_t done,
+                              void *context);
 };
 
 struct sid_pal_serial_bus_factory {
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_adapter.h
+ *  @brief Bluetooth low energy adapter extensions not covered by sid_pal_ble_adapter_ifc.h.
+ */
+
+#ifndef SID_BLE_ADAPTER_H
+#define SID_BLE_ADAPTER_H
+
+#include <sid_error.h>
+#include <sid_ble_service.h>
+#include <stdint.h>
+
+/**
+ * @brief Send statistics of the adapter.
+ */
+struct sid_ble_adapter_send_stats {
+	/** Notification slots, CONFIG_SIDEWALK_BLE_TX_QUEUE_DEPTH. */
+	uint16_t queue_depth;
+	/** Counters of the notifications sent by the adapter. */
+	struct sid_ble_send_stats notify;
+	/** Payload bytes per second with notifications in flight, 0 if nothing was sent. */
+	uint32_t throughput;
+	/** Notifications per connection event multiplied by 100, 0 if nothing was sent. */
+	uint32_t per_conn_event_x100;
+};
+
+/**
+ * @brief Get send statistics of the adapter.
+ *
+ * @param stats [out] statistics since boot or the last reset.
+ * @return SID_ERROR_NONE on success, SID_ERROR_NULL_POINTER if @p stats is NULL.
+ */
+sid_error_t sid_ble_adapter_send_stats_get(struct sid_ble_adapter_send_stats *stats);
+
+/**
+ * @brief Reset send statistics of the adapter.
+ */
+void sid_ble_adapter_send_stats_reset(void);
+
+#endif /* SID_BLE_ADAPTER_H */
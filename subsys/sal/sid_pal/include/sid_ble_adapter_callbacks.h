@@ -14,6 +14,28 @@
 #include <sid_error.h>
 #include <sid_pal_ble_adapter_ifc.h>
 
+/**
+ * @brief Parameters of the BLE link.
+ */
+typedef struct {
+	/** Connection interval [1.25 ms]. */
+	uint16_t interval;
+	/** Peripheral latency [connection events]. */
+	uint16_t latency;
+	/** Supervision timeout [10 ms]. */
+	uint16_t timeout;
+	/** TX PHY, BT_GAP_LE_PHY_*. */
+	uint8_t tx_phy;
+	/** RX PHY, BT_GAP_LE_PHY_*. */
+	uint8_t rx_phy;
+	/** Maximum TX payload of a link layer packet [bytes]. */
+	uint16_t tx_max_len;
+	/** Maximum RX payload of a link layer packet [bytes]. */
+	uint16_t rx_max_len;
+} sid_ble_link_params_t;
+
+typedef void (*sid_ble_link_params_callback_t)(const sid_ble_link_params_t *params);
+
 /**
  * @brief Set a callback for notification sent.
  *
@@ -62,6 +84,15 @@ sid_error_t sid_ble_adapter_notification_changed_cb_set(sid_pal_ble_notify_callb
  */
 void sid_ble_adapter_notification_changed(sid_ble_cfg_service_identifier_t id, bool state);
 
+/**
+ * @brief Check if notifications are enabled, as last reported by
+ *        @ref sid_ble_adapter_notification_changed.
+ *
+ * @param id service identifier.
+ * @return true if the peer subscribed to notifications of the service.
+ */
+bool sid_ble_adapter_notification_enabled(sid_ble_cfg_service_identifier_t id);
+
 /**
  * @brief Set a callback for connection change.
  *
@@ -84,6 +115,21 @@ void sid_ble_adapter_conn_connected(const uint8_t *ble_addr);
  */
 void sid_ble_adapter_conn_disconnected(const uint8_t *ble_addr);
 
+/**
+ * @brief Set a callback for link parameters change.
+ *
+ * @param cb a callback to function which should be call.
+ * @return SID_ERROR_NONE when success, error code otherwise.
+ */
+sid_error_t sid_ble_adapter_link_params_cb_set(sid_ble_link_params_callback_t cb);
+
+/**
+ * @brief Execute callback after connection interval, PHY or data length changed.
+ *
+ * @param params current link parameters.
+ */
+void sid_ble_adapter_link_params_changed(const sid_ble_link_params_t *params);
+
 /**
  * @brief Set a callback for mtu change.
  *
@@ -8,6 +8,17 @@
 #define NRF_BLE_CONNECTION_H
 
 #include <zephyr/bluetooth/conn.h>
+#include <sid_ble_adapter_callbacks.h>
+
+/**
+ * @brief Connection parameter sets requested by the peripheral.
+ */
+typedef enum {
+	/** Short connection interval, used while Sidewalk data is exchanged. */
+	SID_BLE_CONN_PROFILE_THROUGHPUT,
+	/** Long connection interval, used when the link is idle. */
+	SID_BLE_CONN_PROFILE_LOW_POWER,
+} sid_ble_conn_profile_t;
 
 /**
  * @brief Struct with bluetooth connection paramters.
@@ -15,6 +26,10 @@
 typedef struct {
 	struct bt_conn *conn;
 	uint8_t addr[BT_ADDR_SIZE];
+	/** ATT MTU, updated on MTU exchange. */
+	uint16_t mtu;
+	/** Connection interval, PHY and data length. */
+	sid_ble_link_params_t link;
 } sid_ble_conn_params_t;
 
 /**
@@ -29,6 +44,14 @@ void sid_ble_conn_init(void);
  */
 int sid_ble_conn_disconnect(void);
 
+/**
+ * @brief Report Sidewalk data on the link.
+ *
+ * With CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE, the throughput profile is requested if the
+ * link is idle, and the idle timeout is restarted.
+ */
+void sid_ble_conn_activity(void);
+
 /**
  * @brief Deinitialize ble connection module.
  */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_link_quality.h
+ *  @brief RSSI and TX power of the Bluetooth LE connection.
+ */
+
+#ifndef SID_BLE_LINK_QUALITY_H
+#define SID_BLE_LINK_QUALITY_H
+
+#include <zephyr/bluetooth/conn.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Link quality sample.
+ */
+struct sid_ble_lq_sample {
+	/** Uptime of the sample [ms]. */
+	int64_t uptime_ms;
+	/** RSSI of the connection [dBm]. */
+	int8_t rssi;
+	/** TX power of the connection [dBm]. */
+	int8_t tx_power;
+};
+
+/**
+ * @brief Read RSSI of the connection from the controller.
+ *
+ * @note Blocks until the controller responds.
+ *
+ * @param conn connection object.
+ * @param rssi [out] RSSI in dBm.
+ *
+ * @return Zero on success or (negative) error code on failure.
+ */
+int sid_ble_lq_rssi_read(struct bt_conn *conn, int8_t *rssi);
+
+/**
+ * @brief Read TX power of the connection from the controller.
+ *
+ * @note Blocks until the controller responds.
+ *
+ * @param conn connection object.
+ * @param tx_power [out] TX power in dBm.
+ *
+ * @return Zero on success or (negative) error code on failure.
+ */
+int sid_ble_lq_tx_power_read(struct bt_conn *conn, int8_t *tx_power);
+
+/**
+ * @brief Set TX power of the connection.
+ *
+ * @note Blocks until the controller responds.
+ *
+ * @param conn connection object.
+ * @param tx_power requested TX power in dBm, the controller selects the nearest supported level.
+ *
+ * @return Zero on success or (negative) error code on failure.
+ */
+int sid_ble_lq_tx_power_write(struct bt_conn *conn, int8_t tx_power);
+
+/**
+ * @brief Start sampling link quality of Sidewalk connections.
+ *
+ * With CONFIG_SIDEWALK_BLE_LINK_QUALITY, RSSI and TX power of the connection are read every
+ * CONFIG_SIDEWALK_BLE_LINK_QUALITY_INTERVAL_MS in the system workqueue.
+ */
+void sid_ble_lq_init(void);
+
+/**
+ * @brief Stop sampling and drop collected samples.
+ */
+void sid_ble_lq_deinit(void);
+
+/**
+ * @brief Get RSSI of the connection, averaged over the latest samples.
+ *
+ * @param rssi [out] RSSI in dBm.
+ *
+ * @return Zero on success, -ENODATA if there is no sample, -ETIME if the latest sample is
+ *         older than CONFIG_SIDEWALK_BLE_LINK_QUALITY_MAX_AGE_MS.
+ */
+int sid_ble_lq_rssi_get(int8_t *rssi);
+
+/**
+ * @brief Get the latest TX power of the connection.
+ *
+ * @param tx_power [out] TX power in dBm.
+ *
+ * @return Zero on success, -ENODATA if there is no sample, -ETIME if the latest sample is
+ *         older than CONFIG_SIDEWALK_BLE_LINK_QUALITY_MAX_AGE_MS.
+ */
+int sid_ble_lq_tx_power_get(int8_t *tx_power);
+
+/**
+ * @brief Copy the collected samples, the newest first.
+ *
+ * @param samples [out] buffer for the samples.
+ * @param count size of the buffer.
+ *
+ * @return Number of copied samples.
+ */
+size_t sid_ble_lq_history_get(struct sid_ble_lq_sample *samples, size_t count);
+
+#endif /* SID_BLE_LINK_QUALITY_H */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_log_backend.h
+ *  @brief Log backend streaming over the Sidewalk BLE logging service.
+ */
+
+#ifndef SID_BLE_LOG_BACKEND_H
+#define SID_BLE_LOG_BACKEND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Statistics of the BLE log backend.
+ */
+struct sid_ble_log_backend_stats {
+	/** Records written to the ring buffer. */
+	uint32_t records;
+	/** Oldest records dropped to make room for newer ones. */
+	uint32_t dropped;
+	/** Bytes of the dropped records. */
+	uint32_t dropped_bytes;
+	/** Records cut to CONFIG_SIDEWALK_LOG_BACKEND_BLE_RECORD_MAX bytes. */
+	uint32_t truncated;
+	/** Notifications sent. */
+	uint32_t notifications;
+	/** Payload bytes of sent notifications. */
+	uint64_t bytes;
+	/** Notifications rejected by the Bluetooth host. */
+	uint32_t send_errors;
+};
+
+/**
+ * @brief Write a log record to the ring buffer.
+ *
+ * The oldest records are dropped when the buffer is full. The record is sent with the following
+ * ones in notifications of the logging service when the peer is subscribed.
+ *
+ * @note Never blocks, can be called from an interrupt.
+ *
+ * @param data record.
+ * @param len length of the record, longer records are truncated.
+ */
+void sid_ble_log_backend_write(const uint8_t *data, size_t len);
+
+/**
+ * @brief Start sending the buffered records.
+ *
+ * Called when the peer enables notifications of the logging service.
+ */
+void sid_ble_log_backend_kick(void);
+
+/**
+ * @brief Forget the notification in flight and the one waiting to be sent again.
+ *
+ * Called when the link drops or the peer disables notifications of the logging service,
+ * the bytes of a pending notification are counted as dropped.
+ */
+void sid_ble_log_backend_reset(void);
+
+/**
+ * @brief Get statistics of the BLE log backend.
+ *
+ * Batching efficiency is bytes / notifications [B].
+ *
+ * @param stats [out] statistics since boot or the last reset.
+ */
+void sid_ble_log_backend_stats_get(struct sid_ble_log_backend_stats *stats);
+
+/**
+ * @brief Reset statistics of the BLE log backend.
+ */
+void sid_ble_log_backend_stats_reset(void);
+
+#endif /* SID_BLE_LOG_BACKEND_H */
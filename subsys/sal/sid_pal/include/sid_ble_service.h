@@ -17,10 +17,48 @@
 
 typedef struct {
 	struct bt_conn *conn;
-	const struct bt_uuid *uuid;
-	struct bt_gatt_service_static *service;
+	/** Notify characteristic value, see @ref sid_ble_srv_notify_attr_get. */
+	const struct bt_gatt_attr *attr;
+	/** ATT MTU of the connection. */
+	uint16_t mtu;
+	/** Notifications enabled by the peer. */
+	bool subscribed;
 } sid_ble_srv_params_t;
 
+/**
+ * @brief Statistics of notifications sent by @ref sid_ble_send_data.
+ */
+struct sid_ble_send_stats {
+	/** Notifications passed to the Bluetooth host. */
+	uint32_t queued;
+	/** Notifications reported as sent. */
+	uint32_t sent;
+	/** Payload bytes of sent notifications. */
+	uint64_t bytes;
+	/** Sends rejected because all CONFIG_SIDEWALK_BLE_TX_QUEUE_DEPTH slots were in use. */
+	uint32_t queue_full;
+	/** Notifications in flight now. */
+	uint32_t in_flight;
+	/** Largest number of notifications in flight. */
+	uint32_t max_in_flight;
+	/** Connection events in which at least one notification was sent. */
+	uint32_t conn_events;
+	/** Time with at least one notification in flight [ms]. */
+	uint64_t active_ms;
+};
+
+/**
+ * @brief Find the notify characteristic value of a service.
+ *
+ * The attribute table is static, resolve it once and pass it to @ref sid_ble_send_data.
+ *
+ * @param service service object.
+ * @param uuid UUID of the notify characteristic.
+ * @return attribute, NULL if not found.
+ */
+const struct bt_gatt_attr *sid_ble_srv_notify_attr_get(const struct bt_gatt_service_static *service,
+						       const struct bt_uuid *uuid);
+
 /**
  * @brief Send data over BLE.
  *
@@ -31,4 +69,27 @@ typedef struct {
  */
 int sid_ble_send_data(sid_ble_srv_params_t *params, uint8_t *data, uint16_t length);
 
+/**
+ * @brief Get statistics of sent notifications.
+ *
+ * Throughput is bytes * 1000 / active_ms [B/s], notifications per connection event
+ * are sent / conn_events.
+ *
+ * @param stats [out] statistics since boot or the last reset.
+ */
+void sid_ble_send_stats_get(struct sid_ble_send_stats *stats);
+
+/**
+ * @brief Reset statistics of sent notifications.
+ */
+void sid_ble_send_stats_reset(void);
+
+/**
+ * @brief Return all TX slots after the connection is lost.
+ *
+ * Notifications queued on a dropped link are never reported as sent, without the
+ * reset their slots stay taken and @ref sid_ble_send_data fails with -ENOMEM.
+ */
+void sid_ble_send_reset(void);
+
 #endif /* SID_PAL_BLE_SERVICE_H */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_critical_section.h
+ *  @brief Critical sections protecting a single resource of the Sidewalk platform.
+ *
+ * sid_pal_enter_critical_region() serializes everything on one interrupt lock.
+ * A critical section is backed by its own spinlock, so independent resources
+ * do not wait for each other on multicore targets and the code holding it can be
+ * measured separately with CONFIG_SIDEWALK_CRITICAL_SECTION_STATS.
+ */
+
+#ifndef SID_CRITICAL_SECTION_H
+#define SID_CRITICAL_SECTION_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Interrupt masked time of a critical section.
+ */
+struct sid_critical_section_stats {
+	/** Number of times the section was entered. */
+	uint32_t count;
+	/** Longest time the section was held [cycles]. */
+	uint32_t max_cycles;
+	/** Total time the section was held [cycles]. */
+	uint64_t total_cycles;
+};
+
+/**
+ * @brief Critical section, define it with SID_CRITICAL_SECTION_DEFINE.
+ */
+struct sid_critical_section {
+	struct k_spinlock lock;
+	const char *name;
+#if CONFIG_SIDEWALK_CRITICAL_SECTION_STATS
+	struct sid_critical_section_stats stats;
+	uint32_t enter_cycles;
+	sys_snode_t node;
+	bool registered;
+#endif /* CONFIG_SIDEWALK_CRITICAL_SECTION_STATS */
+};
+
+typedef k_spinlock_key_t sid_critical_section_key_t;
+
+/**
+ * @brief Define a critical section.
+ *
+ * @param _var name of the variable.
+ * @param _name name of the section printed with its statistics.
+ */
+#define SID_CRITICAL_SECTION_DEFINE(_var, _name) struct sid_critical_section _var = { .name = _name }
+
+/**
+ * @brief Check if the global Sidewalk critical region is held.
+ *
+ * Code which may sleep must not do so in the region, the nesting counter of
+ * sid_pal_enter_critical_region() is shared by all threads.
+ *
+ * @return true between sid_pal_enter_critical_region() and the matching exit.
+ */
+bool sid_critical_region_is_held(void);
+
+#if CONFIG_SIDEWALK_CRITICAL_SECTION_STATS
+/**
+ * @brief Enter a critical section.
+ *
+ * Interrupts are masked until the section is exited. Sections must not be entered
+ * recursively, but different sections and sid_pal_enter_critical_region() can be nested.
+ *
+ * @param section [in] critical section.
+ * @return key to pass to sid_critical_section_exit().
+ */
+sid_critical_section_key_t sid_critical_section_enter(struct sid_critical_section *section);
+
+/**
+ * @brief Exit a critical section.
+ *
+ * @param section [in] critical section.
+ * @param key [in] key returned by sid_critical_section_enter().
+ */
+void sid_critical_section_exit(struct sid_critical_section *section,
+			       sid_critical_section_key_t key);
+
+/**
+ * @brief Get statistics of a critical section.
+ *
+ * Index 0 is the global Sidewalk critical region, the other sections follow in the order
+ * they were entered for the first time.
+ *
+ * @param index [in] index of the section.
+ * @param name [out] name of the section.
+ * @param stats [out] statistics since boot or the last reset.
+ * @return 0 on success, -ENOENT if there is no section with this index.
+ */
+int sid_critical_section_stats_get(size_t index, const char **name,
+				   struct sid_critical_section_stats *stats);
+
+/**
+ * @brief Reset statistics of all critical sections.
+ */
+void sid_critical_section_stats_reset(void);
+#else
+static inline sid_critical_section_key_t
+sid_critical_section_enter(struct sid_critical_section *section)
+{
+	return k_spin_lock(&section->lock);
+}
+
+static inline void sid_critical_section_exit(struct sid_critical_section *section,
+					     sid_critical_section_key_t key)
+{
+	k_spin_unlock(&section->lock, key);
+}
+#endif /* CONFIG_SIDEWALK_CRITICAL_SECTION_STATS */
+
+#endif /* SID_CRITICAL_SECTION_H */
@@ -116,4 +116,13 @@ int sid_gpio_utils_irq_configure(uint32_t gpio_number, gpio_flags_t irq_flags);
  */
 int sid_gpio_utils_irq_set(uint32_t gpio_number, bool set);
 
+/**
+ * @brief Check if the caller runs in the thread that executes Sidewalk GPIO handlers
+ * 
+ * Handlers are not executed while this thread waits, so it must not wait for a GPIO event.
+ * 
+ * @return true if called from a GPIO handler, false otherwise
+ */
+bool sid_gpio_utils_irq_context(void);
+
 #endif /* SID_GPIO_UTILS_H */
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_log_level.h
+ *  @brief Runtime log levels of the Sidewalk components.
+ */
+
+#ifndef SID_LOG_LEVEL_H
+#define SID_LOG_LEVEL_H
+
+#include <stdint.h>
+
+/**
+ * @brief Sidewalk components with their own log level.
+ */
+enum sid_log_source {
+	/** Sidewalk library, logs through sid_pal_log(). */
+	SID_LOG_SOURCE_STACK,
+	/** Radio drivers and the SPI bus. */
+	SID_LOG_SOURCE_RADIO,
+	/** Crypto and key storage. */
+	SID_LOG_SOURCE_SECURITY,
+	/** Bluetooth LE adapter and GATT services. */
+	SID_LOG_SOURCE_BLE,
+	SID_LOG_SOURCE_COUNT,
+};
+
+/**
+ * @brief Set the log level of a component.
+ *
+ * The level is applied to all log modules of the component. It can not be raised above the
+ * level the modules are compiled with.
+ *
+ * @param source component.
+ * @param level Zephyr log level, LOG_LEVEL_NONE to LOG_LEVEL_DBG.
+ *
+ * @return Level applied to the component, -EINVAL on invalid arguments or -ENOENT if no log
+ *         module of the component is built.
+ */
+int sid_log_level_set(enum sid_log_source source, uint8_t level);
+
+/**
+ * @brief Get the log level of a component.
+ *
+ * @param source component.
+ *
+ * @return Zephyr log level, LOG_LEVEL_NONE for an invalid component.
+ */
+uint8_t sid_log_level_get(enum sid_log_source source);
+
+/**
+ * @brief Get the name of a component.
+ *
+ * @param source component.
+ *
+ * @return Name of the component, NULL for an invalid component.
+ */
+const char *sid_log_source_name(enum sid_log_source source);
+
+#endif /* SID_LOG_LEVEL_H */
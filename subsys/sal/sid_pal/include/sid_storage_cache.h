@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SID_STORAGE_CACHE_H
+#define SID_STORAGE_CACHE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Usage statistics of the key-value storage cache.
+ */
+struct sid_storage_cache_stats {
+	/** Reads served from RAM. */
+	uint32_t read_hits;
+	/** Reads which had to scan the settings backend. */
+	uint32_t read_misses;
+	/** Record writes and deletes requested by Sidewalk. */
+	uint32_t writes;
+	/** Writes merged into a pending write, or equal to the stored value. */
+	uint32_t writes_coalesced;
+	/** Records saved to or deleted from the settings backend. */
+	uint32_t backend_writes;
+	/** Flushes which wrote at least one record. */
+	uint32_t flushes;
+};
+
+/**
+ * @brief Write all pending records to the settings backend.
+ *
+ * Records are written one by one and committed once. Call it before a planned reset,
+ * and from the power-fail warning handler of the application, in thread context.
+ *
+ * @return 0 on success, -errno of the first failed settings operation otherwise.
+ *         Records which failed to be written stay pending.
+ */
+int sid_storage_cache_flush(void);
+
+/**
+ * @brief Get usage statistics of the cache.
+ *
+ * @param stats [out] statistics since boot.
+ */
+void sid_storage_cache_stats_get(struct sid_storage_cache_stats *stats);
+
+#endif /* SID_STORAGE_CACHE_H */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_sw_interrupts.h
+ *  @brief Software interrupt channels with priorities.
+ *
+ * All channels are served by the Sidewalk SWI thread. Every channel has a pending bit,
+ * triggers of a channel before its callback runs are served by one call. After every
+ * callback the pending channel with the highest priority runs next, so radio work waits
+ * at most for one callback of a lower priority channel.
+ *
+ * The software interrupt of sid_pal_swi_ifc.h is the SID_SWI_CHANNEL_RADIO channel.
+ */
+
+#ifndef SID_SW_INTERRUPTS_H
+#define SID_SW_INTERRUPTS_H
+
+#include <sid_pal_swi_ifc.h>
+#include <sid_error.h>
+#include <stdint.h>
+
+/**
+ * @brief Software interrupt channels, from the highest priority.
+ */
+enum sid_swi_channel {
+	/** Sidewalk protocol processing, triggered from the radio events. */
+	SID_SWI_CHANNEL_RADIO,
+	/** Deferred work which is not timing critical. */
+	SID_SWI_CHANNEL_NORMAL,
+	SID_SWI_CHANNEL_COUNT,
+};
+
+/**
+ * @brief Latency histogram buckets.
+ *
+ * Bucket 0 counts latencies below 1 us, bucket i counts latencies from 2^(i-1) us to
+ * 2^i us and the last bucket counts all longer ones.
+ */
+#define SID_SWI_LATENCY_BUCKETS 16
+
+/**
+ * @brief Trigger to run latency of a channel.
+ */
+struct sid_swi_latency {
+	/** Number of callback runs. */
+	uint32_t count;
+	/** Longest latency [us]. */
+	uint32_t max_us;
+	/** Histogram of the latencies. */
+	uint32_t buckets[SID_SWI_LATENCY_BUCKETS];
+};
+
+/**
+ * @brief Set the callback of a channel.
+ *
+ * @param channel [in] software interrupt channel.
+ * @param event_callback [in] callback called from the SWI thread.
+ * @return SID_ERROR_NONE on success, SID_ERROR_NULL_POINTER or SID_ERROR_INVALID_ARGS on
+ *         invalid arguments.
+ */
+sid_error_t sid_swi_channel_start(enum sid_swi_channel channel, sid_pal_swi_cb_t event_callback);
+
+/**
+ * @brief Remove the callback of a channel, a pending trigger is discarded.
+ *
+ * @param channel [in] software interrupt channel.
+ * @return SID_ERROR_NONE on success, SID_ERROR_INVALID_ARGS for an invalid channel.
+ */
+sid_error_t sid_swi_channel_stop(enum sid_swi_channel channel);
+
+/**
+ * @brief Trigger a channel.
+ *
+ * @note Never blocks, can be called from an interrupt.
+ *
+ * @param channel [in] software interrupt channel.
+ * @return SID_ERROR_NONE on success, SID_ERROR_INVALID_STATE before sid_pal_swi_init or if
+ *         the channel has no callback, SID_ERROR_INVALID_ARGS for an invalid channel.
+ */
+sid_error_t sid_swi_channel_trigger(enum sid_swi_channel channel);
+
+/**
+ * @brief Get the name of a channel.
+ *
+ * @param channel [in] software interrupt channel.
+ * @return name of the channel, NULL for an invalid channel.
+ */
+const char *sid_swi_channel_name(enum sid_swi_channel channel);
+
+#if CONFIG_SIDEWALK_SWI_LATENCY_STATS
+/**
+ * @brief Get the latency histogram of a channel.
+ *
+ * The latency is measured from the first trigger after the previous run to the call of
+ * the callback.
+ *
+ * @param channel [in] software interrupt channel.
+ * @param latency [out] histogram since boot or the last reset.
+ * @return SID_ERROR_NONE on success, SID_ERROR_INVALID_ARGS for an invalid channel.
+ */
+sid_error_t sid_swi_latency_get(enum sid_swi_channel channel, struct sid_swi_latency *latency);
+
+/**
+ * @brief Reset the latency histograms of all channels.
+ */
+void sid_swi_latency_reset(void);
+#endif /* CONFIG_SIDEWALK_SWI_LATENCY_STATS */
+
+#endif /* SID_SW_INTERRUPTS_H */
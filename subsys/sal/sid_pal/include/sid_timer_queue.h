@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SID_TIMER_QUEUE_H
+#define SID_TIMER_QUEUE_H
+
+#include <sid_pal_timer_types.h>
+#include <sid_time_ops.h>
+#include <stdbool.h>
+
+/**
+ * @brief Queue of armed Sidewalk timers ordered by alarm.
+ *
+ * The backend is selected with CONFIG_SIDEWALK_TIMER_QUEUE_*.
+ * All functions must be called with the timer critical section held.
+ * Timers with the same alarm expire in the order they were inserted.
+ */
+
+/**
+ * @brief Insert timer to the queue.
+ *
+ * If an already armed timer expires later than @p timer, but not later than the timer
+ * alarm extended by its tolerance, the alarm of @p timer is moved to that timer alarm.
+ *
+ * @param timer [in] timer with alarm and tolerance set, not present in the queue.
+ * @param reschedule [out] true if the timer is the first to expire and the hardware
+ *                         timer has to be started for its alarm.
+ * @return 0 on success, -ENOMEM if the queue is full.
+ */
+int sid_timer_queue_insert(sid_pal_timer_t *timer, bool *reschedule);
+
+/**
+ * @brief Remove timer from the queue.
+ *
+ * @param timer [in] timer present in the queue.
+ */
+void sid_timer_queue_remove(sid_pal_timer_t *timer);
+
+/**
+ * @brief Check if timer is present in the queue.
+ *
+ * @param timer [in] timer initialized with sid_pal_timer_init.
+ * @return true if the timer is armed.
+ */
+bool sid_timer_queue_contains(const sid_pal_timer_t *timer);
+
+/**
+ * @brief Get the first timer to expire.
+ *
+ * @return timer with the lowest alarm, or NULL if the queue is empty.
+ */
+sid_pal_timer_t *sid_timer_queue_peek(void);
+
+/**
+ * @brief Remove and return the first timer to expire, if it is due.
+ *
+ * @param now [in] current time.
+ * @return timer with alarm not greater than @p now, or NULL.
+ */
+sid_pal_timer_t *sid_timer_queue_fetch(const struct sid_timespec *now);
+
+/**
+ * @brief Move timer alarm to the alarm of the next timer, if it is within tolerance.
+ *
+ * @param timer [in,out] timer to be inserted.
+ * @param next [in] armed timer with the lowest alarm greater than the @p timer alarm, or NULL.
+ * @return true if the alarm was moved.
+ */
+static inline bool sid_timer_queue_coalesce(sid_pal_timer_t *timer, const sid_pal_timer_t *next)
+{
+	if (!next) {
+		return false;
+	}
+
+	struct sid_timespec diff = next->alarm;
+
+	sid_time_sub(&diff, &timer->alarm);
+	if (sid_time_gt(&diff, timer->tolerance)) {
+		return false;
+	}
+
+	timer->alarm = next->alarm;
+	return true;
+}
+
+#endif /* SID_TIMER_QUEUE_H */
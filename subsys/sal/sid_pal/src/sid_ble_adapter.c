@@ -10,6 +10,7 @@
 
 #include <sid_error.h>
 #include <sid_pal_ble_adapter_ifc.h>
+#include <sid_ble_adapter.h>
 #include <sid_ble_service.h>
 #include <sid_ble_ama_service.h>
 #if defined(CONFIG_SIDEWALK_VENDOR_SERVICE)
@@ -21,6 +22,7 @@
 #include <sid_ble_adapter_callbacks.h>
 #include <sid_ble_advert.h>
 #include <sid_ble_connection.h>
+#include <sid_ble_link_quality.h>
 
 #include <zephyr/bluetooth/hci.h>
 #include <zephyr/bluetooth/bluetooth.h>
@@ -30,8 +32,6 @@
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/settings/settings.h>
 #include <zephyr/logging/log.h>
-#include <zephyr/sys/byteorder.h>
-#include <zephyr/bluetooth/hci_vs.h>
 
 LOG_MODULE_REGISTER(sid_ble, CONFIG_SIDEWALK_BLE_ADAPTER_LOG_LEVEL);
 
@@ -48,6 +48,7 @@ static sid_error_t ble_adapter_deinit(void);
 static sid_error_t ble_adapter_get_rssi(int8_t *rssi);
 static sid_error_t ble_adapter_get_tx_pwr(int8_t *tx_power);
 static sid_error_t ble_adapter_set_tx_pwr(int8_t tx_power);
+static const struct bt_gatt_attr *srv_notify_attr_get(sid_ble_cfg_service_identifier_t id);
 
 static struct sid_pal_ble_adapter_interface ble_ifc = {
 	.init = ble_adapter_init,
@@ -65,99 +66,6 @@ static struct sid_pal_ble_adapter_interface ble_ifc = {
 
 };
 
-static void read_conn_rssi(uint16_t handle, int8_t *rssi)
-{
-	struct net_buf *buf, *rsp = NULL;
-	struct bt_hci_cp_read_rssi *cp;
-	struct bt_hci_rp_read_rssi *rp;
-
-	int err;
-
-	buf = bt_hci_cmd_create(BT_HCI_OP_READ_RSSI, sizeof(*cp));
-	if (!buf) {
-		LOG_ERR("Unable to allocate command buffer\n");
-		return;
-	}
-
-	cp = net_buf_add(buf, sizeof(*cp));
-	cp->handle = sys_cpu_to_le16(handle);
-
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_RSSI, buf, &rsp);
-	if (err) {
-		uint8_t reason = rsp ? ((struct bt_hci_rp_read_rssi *)rsp->data)->status : 0;
-		LOG_ERR("Read RSSI err: %d reason 0x%02x\n", err, reason);
-		return;
-	}
-
-	rp = (void *)rsp->data;
-	*rssi = rp->rssi;
-
-	net_buf_unref(rsp);
-}
-static void set_tx_power(uint8_t handle_type, uint16_t handle, int8_t tx_pwr_lvl)
-{
-	struct bt_hci_cp_vs_write_tx_power_level *cp;
-	struct bt_hci_rp_vs_write_tx_power_level *rp;
-	struct net_buf *buf, *rsp = NULL;
-	int err;
-
-	buf = bt_hci_cmd_create(BT_HCI_OP_VS_WRITE_TX_POWER_LEVEL, sizeof(*cp));
-	if (!buf) {
-		LOG_ERR("Unable to allocate command buffer\n");
-		return;
-	}
-
-	cp = net_buf_add(buf, sizeof(*cp));
-	cp->handle = sys_cpu_to_le16(handle);
-	cp->handle_type = handle_type;
-	cp->tx_power_level = tx_pwr_lvl;
-
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_VS_WRITE_TX_POWER_LEVEL, buf, &rsp);
-	if (err) {
-		uint8_t reason =
-			rsp ? ((struct bt_hci_rp_vs_write_tx_power_level *)rsp->data)->status : 0;
-		LOG_ERR("Set Tx power err: %d reason 0x%02x\n", err, reason);
-		return;
-	}
-
-	rp = (void *)rsp->data;
-	LOG_ERR("Actual Tx Power: %d\n", rp->selected_tx_power);
-
-	net_buf_unref(rsp);
-}
-
-static void get_tx_power(uint8_t handle_type, uint16_t handle, int8_t *tx_pwr_lvl)
-{
-	struct bt_hci_cp_vs_read_tx_power_level *cp;
-	struct bt_hci_rp_vs_read_tx_power_level *rp;
-	struct net_buf *buf, *rsp = NULL;
-	int err;
-
-	*tx_pwr_lvl = 0xFF;
-	buf = bt_hci_cmd_create(BT_HCI_OP_VS_READ_TX_POWER_LEVEL, sizeof(*cp));
-	if (!buf) {
-		LOG_ERR("Unable to allocate command buffer\n");
-		return;
-	}
-
-	cp = net_buf_add(buf, sizeof(*cp));
-	cp->handle = sys_cpu_to_le16(handle);
-	cp->handle_type = handle_type;
-
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_VS_READ_TX_POWER_LEVEL, buf, &rsp);
-	if (err) {
-		uint8_t reason =
-			rsp ? ((struct bt_hci_rp_vs_read_tx_power_level *)rsp->data)->status : 0;
-		LOG_ERR("Read Tx power err: %d reason 0x%02x\n", err, reason);
-		return;
-	}
-
-	rp = (void *)rsp->data;
-	*tx_pwr_lvl = rp->tx_power_level;
-
-	net_buf_unref(rsp);
-}
-
 static sid_error_t ble_adapter_get_rssi(int8_t *rssi)
 {
 	const sid_ble_conn_params_t *params = sid_ble_conn_params_get();
@@ -165,13 +73,16 @@ static sid_error_t ble_adapter_get_rssi(int8_t *rssi)
 		return SID_ERROR_GENERIC;
 	}
 
-	uint16_t conn_handle = 0;
-	int e = bt_hci_get_conn_handle(params->conn, &conn_handle);
-	if (e != 0) {
-		LOG_ERR("Can not get conn_handle error %d", e);
+#if CONFIG_SIDEWALK_BLE_LINK_QUALITY
+	if (0 == sid_ble_lq_rssi_get(rssi)) {
+		LOG_DBG("BLE RSSI = %d (cached)", *rssi);
+		return SID_ERROR_NONE;
+	}
+#endif /* CONFIG_SIDEWALK_BLE_LINK_QUALITY */
+
+	if (sid_ble_lq_rssi_read(params->conn, rssi)) {
 		return SID_ERROR_GENERIC;
 	}
-	read_conn_rssi(conn_handle, rssi);
 
 	LOG_DBG("BLE RSSI = %d", *rssi);
 	return SID_ERROR_NONE;
@@ -179,37 +90,37 @@ static sid_error_t ble_adapter_get_rssi(int8_t *rssi)
 
 static sid_error_t ble_adapter_get_tx_pwr(int8_t *tx_power)
 {
-	uint16_t conn_handle = 0;
-
 	const sid_ble_conn_params_t *params = sid_ble_conn_params_get();
 	if (params == NULL || params->conn == NULL) {
 		return SID_ERROR_GENERIC;
 	}
 
-	int e = bt_hci_get_conn_handle(params->conn, &conn_handle);
-	if (e != 0) {
-		LOG_ERR("Can not get conn_handle error %d", e);
+#if CONFIG_SIDEWALK_BLE_LINK_QUALITY
+	if (0 == sid_ble_lq_tx_power_get(tx_power)) {
+		LOG_DBG("BLE get tx pwr: %d (cached)", *tx_power);
+		return SID_ERROR_NONE;
+	}
+#endif /* CONFIG_SIDEWALK_BLE_LINK_QUALITY */
+
+	if (sid_ble_lq_tx_power_read(params->conn, tx_power)) {
 		return SID_ERROR_GENERIC;
 	}
-	get_tx_power(BT_HCI_VS_LL_HANDLE_TYPE_CONN, conn_handle, tx_power);
+
 	LOG_DBG("BLE get tx pwr: %d", *tx_power);
 	return SID_ERROR_NONE;
 }
 
 static sid_error_t ble_adapter_set_tx_pwr(int8_t tx_power)
 {
-	uint16_t conn_handle = 0;
-
 	const sid_ble_conn_params_t *params = sid_ble_conn_params_get();
 	if (params == NULL || params->conn == NULL) {
 		return SID_ERROR_GENERIC;
 	}
-	int e = bt_hci_get_conn_handle(params->conn, &conn_handle);
-	if (e != 0) {
-		LOG_ERR("Can not get conn_handle error %d", e);
+
+	if (sid_ble_lq_tx_power_write(params->conn, tx_power)) {
 		return SID_ERROR_GENERIC;
 	}
-	set_tx_power(BT_HCI_VS_LL_HANDLE_TYPE_CONN, conn_handle, tx_power);
+
 	LOG_DBG("BLE set tx pwr: %d", tx_power);
 	return SID_ERROR_NONE;
 }
@@ -266,6 +177,13 @@ static sid_error_t ble_adapter_init(const sid_ble_config_t *cfg)
 	}
 
 	sid_ble_conn_init();
+#if CONFIG_SIDEWALK_BLE_LINK_QUALITY
+	sid_ble_lq_init();
+#endif /* CONFIG_SIDEWALK_BLE_LINK_QUALITY */
+
+	for (int id = AMA_SERVICE; id <= LOGGING_SERVICE; id++) {
+		(void)srv_notify_attr_get(id);
+	}
 
 	return SID_ERROR_NONE;
 }
@@ -319,63 +237,69 @@ static sid_error_t ble_adapter_stop_advertisement(void)
 	return SID_ERROR_NONE;
 }
 
-/* The static literal has lifetime of its context, so as a global its lifetime is static.
-   When it was used in a context of a function, it had been stored on the stack of that function, 
-   and was not valid outside of this function.*/
-static const struct bt_uuid *uuid_ama_service = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
+/**
+ * @brief Notify attribute of a service, resolved once and reused by every send.
+ */
+struct srv_notify {
+	const struct bt_gatt_service_static *(*service_get)(void);
+	const struct bt_uuid *uuid;
+	const struct bt_gatt_attr *attr;
+};
+
+static struct srv_notify srv_notify[LOGGING_SERVICE + 1] = {
+	[AMA_SERVICE] = { .service_get = sid_ble_get_ama_service,
+			  .uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY },
 #if defined(CONFIG_SIDEWALK_VENDOR_SERVICE)
-static const struct bt_uuid *uuid_vnd_service = VND_SID_BT_CHARACTERISTIC_NOTIFY;
+	[VENDOR_SERVICE] = { .service_get = sid_ble_get_vnd_service,
+			     .uuid = VND_SID_BT_CHARACTERISTIC_NOTIFY },
 #endif /* CONFIG_SIDEWALK_VENDOR_SERVICE */
 #if defined(CONFIG_SIDEWALK_LOGGING_SERVICE)
-static const struct bt_uuid *uuid_log_service = LOG_SID_BT_CHARACTERISTIC_NOTIFY;
-#endif /* CONFIG_SIDEWALK_VENDOR_SERVICE */
+	[LOGGING_SERVICE] = { .service_get = sid_ble_get_log_service,
+			      .uuid = LOG_SID_BT_CHARACTERISTIC_NOTIFY },
+#endif /* CONFIG_SIDEWALK_LOGGING_SERVICE */
+};
 
-static sid_ble_srv_params_t get_srv_params(sid_ble_cfg_service_identifier_t id)
+static const struct bt_gatt_attr *srv_notify_attr_get(sid_ble_cfg_service_identifier_t id)
 {
-	switch (id) {
-	case AMA_SERVICE:
-		return (sid_ble_srv_params_t){
-			.conn = sid_ble_conn_params_get()->conn,
-			.service = (struct bt_gatt_service_static *)sid_ble_get_ama_service(),
-			.uuid = uuid_ama_service
-		};
+	if (id >= ARRAY_SIZE(srv_notify) || !srv_notify[id].service_get) {
+		return NULL;
+	}
 
-#if defined(CONFIG_SIDEWALK_VENDOR_SERVICE)
-	case VENDOR_SERVICE:
-		return (sid_ble_srv_params_t){
-			.conn = sid_ble_conn_params_get()->conn,
-			.service = (struct bt_gatt_service_static *)sid_ble_get_vnd_service(),
-			.uuid = uuid_vnd_service
-		};
-#endif /* CONFIG_SIDEWALK_VENDOR_SERVICE */
-#if defined(CONFIG_SIDEWALK_LOGGING_SERVICE)
-	case LOGGING_SERVICE:
-		return (sid_ble_srv_params_t){
-			.conn = sid_ble_conn_params_get()->conn,
-			.service = (struct bt_gatt_service_static *)sid_ble_get_log_service(),
-			.uuid = uuid_log_service
-		};
-#endif /* CONFIG_SIDEWALK_LOGGING_SERVICE */
-	default:
-		return (sid_ble_srv_params_t){ .conn = NULL, .uuid = NULL, .service = NULL };
+	if (!srv_notify[id].attr) {
+		srv_notify[id].attr = sid_ble_srv_notify_attr_get(srv_notify[id].service_get(),
+								  srv_notify[id].uuid);
+		if (!srv_notify[id].attr) {
+			LOG_ERR("Notify attribute of service %d not found", id);
+		}
 	}
+
+	return srv_notify[id].attr;
 }
 
 static sid_error_t ble_adapter_send_data(sid_ble_cfg_service_identifier_t id, uint8_t *data,
 					 uint16_t length)
 {
 	LOG_DBG("Sidewalk -> BLE");
-	sid_ble_srv_params_t srv_params = get_srv_params(id);
-	if (srv_params.service == NULL || srv_params.uuid == NULL) {
+	const struct bt_gatt_attr *attr = srv_notify_attr_get(id);
+	if (!attr) {
 		return SID_ERROR_NOSUPPORT;
 	}
 
+	const sid_ble_conn_params_t *conn_params = sid_ble_conn_params_get();
+	sid_ble_srv_params_t srv_params = {
+		.conn = conn_params ? conn_params->conn : NULL,
+		.attr = attr,
+		.mtu = conn_params ? conn_params->mtu : 0,
+		.subscribed = sid_ble_adapter_notification_enabled(id),
+	};
+
 	int err_code = sid_ble_send_data(&srv_params, data, length);
 	if (-EINVAL == err_code) {
 		return SID_ERROR_INVALID_ARGS;
 	} else if (0 > err_code) {
 		return SID_ERROR_GENERIC;
 	}
+	sid_ble_conn_activity();
 	return SID_ERROR_NONE;
 }
 
@@ -437,6 +361,9 @@ static sid_error_t ble_adapter_disconnect(void)
 static sid_error_t ble_adapter_deinit(void)
 {
 	LOG_DBG("Sidewalk -> BLE");
+#if CONFIG_SIDEWALK_BLE_LINK_QUALITY
+	sid_ble_lq_deinit();
+#endif /* CONFIG_SIDEWALK_BLE_LINK_QUALITY */
 	sid_ble_conn_deinit();
 	sid_ble_advert_deinit();
 	bt_id_delete(BT_ID_SIDEWALK);
@@ -451,6 +378,32 @@ static sid_error_t ble_adapter_deinit(void)
 	return SID_ERROR_NONE;
 }
 
+sid_error_t sid_ble_adapter_send_stats_get(struct sid_ble_adapter_send_stats *stats)
+{
+	if (!stats) {
+		return SID_ERROR_NULL_POINTER;
+	}
+
+	*stats = (struct sid_ble_adapter_send_stats){ .queue_depth =
+							      CONFIG_SIDEWALK_BLE_TX_QUEUE_DEPTH };
+	sid_ble_send_stats_get(&stats->notify);
+
+	if (stats->notify.active_ms) {
+		stats->throughput = stats->notify.bytes * MSEC_PER_SEC / stats->notify.active_ms;
+	}
+	if (stats->notify.conn_events) {
+		stats->per_conn_event_x100 =
+			(uint64_t)stats->notify.sent * 100 / stats->notify.conn_events;
+	}
+
+	return SID_ERROR_NONE;
+}
+
+void sid_ble_adapter_send_stats_reset(void)
+{
+	sid_ble_send_stats_reset();
+}
+
 sid_error_t sid_pal_ble_adapter_create(sid_pal_ble_adapter_interface_t *handle)
 {
 	if (!handle) {
@@ -9,8 +9,12 @@
  */
 
 #include <sid_ble_adapter_callbacks.h>
+#include <sid_ble_connection.h>
+#include <sid_ble_service.h>
+#include <sid_ble_log_backend.h>
 
 #include <zephyr/types.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(sid_ble_adapter_callbacks, CONFIG_SIDEWALK_BLE_ADAPTER_LOG_LEVEL);
@@ -29,6 +33,10 @@ static sid_pal_ble_indication_callback_t notify_sent_cb;
 static sid_pal_ble_connection_callback_t connection_cb;
 static sid_pal_ble_mtu_callback_t mtu_changed_cb;
 static sid_pal_ble_adv_start_callback_t adv_start_cb;
+static sid_ble_link_params_callback_t link_params_cb;
+
+/* Notification state of every service, kept for the send path */
+static ATOMIC_DEFINE(notify_enabled, LOGGING_SERVICE + 1);
 
 sid_error_t sid_ble_adapter_notification_cb_set(sid_pal_ble_indication_callback_t cb)
 {
@@ -53,6 +61,7 @@ sid_error_t sid_ble_adapter_data_cb_set(sid_pal_ble_data_callback_t cb)
 void sid_ble_adapter_data_write(sid_ble_cfg_service_identifier_t id, uint8_t *data, uint16_t length)
 {
 	LOG_DBG("BLE -> Sidewalk");
+	sid_ble_conn_activity();
 	if (data_cb) {
 		data_cb(id, data, length);
 	}
@@ -67,11 +76,19 @@ sid_error_t sid_ble_adapter_notification_changed_cb_set(sid_pal_ble_notify_callb
 void sid_ble_adapter_notification_changed(sid_ble_cfg_service_identifier_t id, bool state)
 {
 	LOG_DBG("BLE -> Sidewalk");
+	if (id <= LOGGING_SERVICE) {
+		atomic_set_bit_to(notify_enabled, id, state);
+	}
 	if (notify_changed_cb) {
 		notify_changed_cb(id, state);
 	}
 }
 
+bool sid_ble_adapter_notification_enabled(sid_ble_cfg_service_identifier_t id)
+{
+	return id <= LOGGING_SERVICE && atomic_test_bit(notify_enabled, id);
+}
+
 sid_error_t sid_ble_adapter_conn_cb_set(sid_pal_ble_connection_callback_t cb)
 {
 	CALLBACK_SET(connection_cb, cb);
@@ -89,11 +106,32 @@ void sid_ble_adapter_conn_connected(const uint8_t *ble_addr)
 void sid_ble_adapter_conn_disconnected(const uint8_t *ble_addr)
 {
 	LOG_DBG("BLE -> Sidewalk");
+	for (int id = 0; id <= LOGGING_SERVICE; id++) {
+		atomic_clear_bit(notify_enabled, id);
+	}
+	sid_ble_send_reset();
+#if defined(CONFIG_SIDEWALK_LOG_BACKEND_BLE)
+	sid_ble_log_backend_reset();
+#endif /* CONFIG_SIDEWALK_LOG_BACKEND_BLE */
 	if (connection_cb) {
 		connection_cb(false, (uint8_t *)ble_addr);
 	}
 }
 
+sid_error_t sid_ble_adapter_link_params_cb_set(sid_ble_link_params_callback_t cb)
+{
+	CALLBACK_SET(link_params_cb, cb);
+	return SID_ERROR_NONE;
+}
+
+void sid_ble_adapter_link_params_changed(const sid_ble_link_params_t *params)
+{
+	LOG_DBG("BLE -> Sidewalk");
+	if (link_params_cb) {
+		link_params_cb(params);
+	}
+}
+
 sid_error_t sid_ble_adapter_mtu_cb_set(sid_pal_ble_mtu_callback_t cb)
 {
 	LOG_DBG("BLE -> Sidewalk");
@@ -53,6 +53,10 @@ static struct bt_le_adv_param adv_param_slow = {
 };
 
 static struct bt_le_ext_adv *adv_set = NULL;
+/* Parameters the adv_set was configured with */
+static const struct bt_le_adv_param *adv_param_current = NULL;
+/* Advertising data changed since it was last written to the adv_set */
+static bool adv_data_dirty = true;
 
 /**
  * @brief Advertising data items values size in bytes.
@@ -77,6 +81,8 @@ K_WORK_DELAYABLE_DEFINE(change_adv_work, change_advertisement_interval);
 static atomic_t adv_state = ATOMIC_INIT(BLE_ADV_DISABLE);
 
 static uint8_t bt_adv_manuf_data[AD_MANUF_DATA_LEN_MAX];
+/* Set once the company ID and data were written to bt_adv_manuf_data */
+static bool bt_adv_manuf_data_valid;
 
 static struct bt_data adv_data[] = {
 	[ADV_DATA_FLAGS] = BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
@@ -107,12 +113,83 @@ static uint8_t advert_manuf_data_copy(uint8_t *data, uint8_t data_len)
 	uint8_t ama_id_len = sizeof(ama_id);
 	uint8_t new_data_len = MIN(data_len, AD_MANUF_DATA_LEN_MAX - ama_id_len);
 
+	if (bt_adv_manuf_data_valid &&
+	    adv_data[ADV_DATA_MANUF_DATA].data_len == new_data_len + ama_id_len &&
+	    !memcmp(&bt_adv_manuf_data[ama_id_len], data, new_data_len)) {
+		return new_data_len + ama_id_len;
+	}
+
 	memcpy(bt_adv_manuf_data, &ama_id, ama_id_len);
 	memcpy(&bt_adv_manuf_data[ama_id_len], data, new_data_len);
+	bt_adv_manuf_data_valid = true;
+	adv_data_dirty = true;
 
 	return new_data_len + ama_id_len;
 }
 
+/**
+ * @brief Configure the adv_set with given parameters.
+ *
+ * With CONFIG_SIDEWALK_BLE_ADV_UPDATE_PARAM the existing set is updated in place,
+ * otherwise it is deleted and created again. The adv_set has to be stopped.
+ *
+ * @param param advertising parameters.
+ *
+ * @return Zero on success or (negative) error code on failure.
+ */
+static int advert_param_set(const struct bt_le_adv_param *param)
+{
+	int err;
+
+#if CONFIG_SIDEWALK_BLE_ADV_UPDATE_PARAM
+	if (adv_set != NULL) {
+		if (adv_param_current == param) {
+			return 0;
+		}
+		err = bt_le_ext_adv_update_param(adv_set, param);
+		if (err) {
+			return err;
+		}
+		adv_param_current = param;
+		return 0;
+	}
+#else
+	err = sid_ble_advert_deinit();
+	if (err) {
+		return err;
+	}
+#endif /* CONFIG_SIDEWALK_BLE_ADV_UPDATE_PARAM */
+
+	err = bt_le_ext_adv_create(param, NULL, &adv_set);
+	if (err) {
+		return err;
+	}
+	adv_param_current = param;
+	adv_data_dirty = true;
+
+	return 0;
+}
+
+/**
+ * @brief Write advertising data to the adv_set, if changed since the last write.
+ *
+ * @return Zero on success or (negative) error code on failure.
+ */
+static int advert_data_set(void)
+{
+	if (!adv_data_dirty) {
+		return 0;
+	}
+
+	int err = bt_le_ext_adv_set_data(adv_set, adv_data, ARRAY_SIZE(adv_data), sd,
+					 ARRAY_SIZE(sd));
+	if (!err) {
+		adv_data_dirty = false;
+	}
+
+	return err;
+}
+
 static void change_advertisement_interval(struct k_work *work)
 {
 	ARG_UNUSED(work);
@@ -128,21 +205,13 @@ static void change_advertisement_interval(struct k_work *work)
 			LOG_ERR("Failed to stop fast adv errno %d (%s)", err, strerror(err));
 			return;
 		}
-		err = bt_le_ext_adv_delete(adv_set);
-		if (err) {
-			atomic_set(&adv_state, BLE_ADV_DISABLE);
-			LOG_ERR("Failed to delete adv set");
-			return;
-		}
-		adv_set = NULL;
-		err = bt_le_ext_adv_create(&adv_param_slow, NULL, &adv_set);
+		err = advert_param_set(&adv_param_slow);
 		if (err) {
 			atomic_set(&adv_state, BLE_ADV_DISABLE);
-			LOG_ERR("Failed to create slow adv set");
+			LOG_ERR("Failed to set slow adv params errno %d (%s)", err, strerror(err));
 			return;
 		}
-		err = bt_le_ext_adv_set_data(adv_set, adv_data, ARRAY_SIZE(adv_data), sd,
-					     ARRAY_SIZE(sd));
+		err = advert_data_set();
 		if (err) {
 			atomic_set(&adv_state, BLE_ADV_DISABLE);
 			LOG_ERR("Failed to set adv data to slow adv errno %d (%s)", err,
@@ -171,6 +240,8 @@ int sid_ble_advert_init(void)
 				strerror(ret));
 			return ret;
 		}
+		adv_param_current = &adv_param_fast;
+		adv_data_dirty = true;
 	}
 
 	return 0;
@@ -185,6 +256,7 @@ int sid_ble_advert_deinit(void)
 			return err;
 		}
 		adv_set = NULL;
+		adv_param_current = NULL;
 	}
 
 	return 0;
@@ -194,16 +266,34 @@ void sid_ble_advert_notify_connection(void)
 {
 	LOG_DBG("Conneciton has been made, cancel change adv");
 	k_work_cancel_delayable(&change_adv_work);
+	/* Connectable advertising is stopped by the stack on connection */
+	atomic_set(&adv_state, BLE_ADV_DISABLE);
 }
 
 int sid_ble_advert_start(void)
 {
 	struct bt_le_ext_adv_start_param ext_adv_start_param = { 0 };
 	int err = 0;
+
+	if (BLE_ADV_DISABLE != atomic_get(&adv_state)) {
+		k_work_cancel_delayable(&change_adv_work);
+		err = bt_le_ext_adv_stop(adv_set);
+		if (err) {
+			atomic_set(&adv_state, BLE_ADV_DISABLE);
+			LOG_ERR("Failed to stop adv errno: %d (%s)", err, strerror(err));
+			return err;
+		}
+	}
+
 	// make sure to always start with fast advertising set
-	sid_ble_advert_deinit();
-	sid_ble_advert_init();
-	err = bt_le_ext_adv_set_data(adv_set, adv_data, ARRAY_SIZE(adv_data), sd, ARRAY_SIZE(sd));
+	err = advert_param_set(&adv_param_fast);
+	if (err) {
+		atomic_set(&adv_state, BLE_ADV_DISABLE);
+		LOG_ERR("Failed to set fast adv params errno: %d (%s)", err, strerror(err));
+		return err;
+	}
+
+	err = advert_data_set();
 	if (err) {
 		atomic_set(&adv_state, BLE_ADV_DISABLE);
 		LOG_ERR("Failed to set fast adv data errno: %d (%s)", err, strerror(err));
@@ -248,9 +338,8 @@ int sid_ble_advert_update(uint8_t *data, uint8_t data_len)
 	int err = 0;
 
 	if (BLE_ADV_DISABLE != state) {
-		/* Update currently advertised set, the other one will be set on start/transition */
-		err = bt_le_ext_adv_set_data(adv_set, adv_data, ARRAY_SIZE(adv_data), sd,
-					     ARRAY_SIZE(sd));
+		/* Update currently advertised set, otherwise data will be set on start */
+		err = advert_data_set();
 	}
 
 	return err;
@@ -10,6 +10,7 @@
 
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/att.h>
 #include <zephyr/logging/log.h>
 
 #include <errno.h>
@@ -24,6 +25,15 @@ LOG_MODULE_REGISTER(sid_ble_conn, CONFIG_SIDEWALK_LOG_LEVEL);
 static void ble_connect_cb(struct bt_conn *conn, uint8_t err);
 static void ble_disconnect_cb(struct bt_conn *conn, uint8_t reason);
 static void ble_mtu_cb(struct bt_conn *conn, uint16_t tx_mtu, uint16_t rx_mtu);
+static void ble_le_param_updated_cb(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+				    uint16_t timeout);
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+static void ble_le_phy_updated_cb(struct bt_conn *conn, struct bt_conn_le_phy_info *param);
+#endif /* CONFIG_BT_USER_PHY_UPDATE */
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+static void ble_le_data_len_updated_cb(struct bt_conn *conn,
+				       struct bt_conn_le_data_len_info *info);
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
 
 static sid_ble_conn_params_t conn_params;
 static sid_ble_conn_params_t *p_conn_params_out;
@@ -31,8 +41,33 @@ static sid_ble_conn_params_t *p_conn_params_out;
 static struct bt_conn_cb conn_callbacks = {
 	.connected = ble_connect_cb,
 	.disconnected = ble_disconnect_cb,
+	.le_param_updated = ble_le_param_updated_cb,
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+	.le_phy_updated = ble_le_phy_updated_cb,
+#endif /* CONFIG_BT_USER_PHY_UPDATE */
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+	.le_data_len_updated = ble_le_data_len_updated_cb,
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
 };
 
+#if defined(CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE)
+static const struct bt_le_conn_param conn_profiles[] = {
+	[SID_BLE_CONN_PROFILE_THROUGHPUT] = BT_LE_CONN_PARAM_INIT(
+		CONFIG_SIDEWALK_BLE_CONN_INT_FAST_MIN, CONFIG_SIDEWALK_BLE_CONN_INT_FAST_MAX, 0,
+		CONFIG_SIDEWALK_BLE_CONN_TIMEOUT),
+	[SID_BLE_CONN_PROFILE_LOW_POWER] = BT_LE_CONN_PARAM_INIT(
+		CONFIG_SIDEWALK_BLE_CONN_INT_SLOW_MIN, CONFIG_SIDEWALK_BLE_CONN_INT_SLOW_MAX,
+		CONFIG_SIDEWALK_BLE_CONN_LATENCY_SLOW, CONFIG_SIDEWALK_BLE_CONN_TIMEOUT),
+};
+
+static atomic_t conn_profile = ATOMIC_INIT(SID_BLE_CONN_PROFILE_LOW_POWER);
+
+static void conn_idle_work_handler(struct k_work *work);
+static void conn_active_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(conn_idle_work, conn_idle_work_handler);
+static K_WORK_DEFINE(conn_active_work, conn_active_work_handler);
+#endif /* CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE */
+
 static struct bt_gatt_cb gatt_callbacks = { .att_mtu_updated = ble_mtu_cb };
 
 /**
@@ -42,17 +77,82 @@ static struct bt_gatt_cb gatt_callbacks = { .att_mtu_updated = ble_mtu_cb };
  * @return true if the connection should be handled by Sidewalk
  * @return false connection is not for Sidewlak
  */
-static bool is_connection_valid(struct bt_conn *conn)
+static bool is_connection_valid(struct bt_conn *conn, struct bt_conn_info *conn_info)
 {
-	struct bt_conn_info conn_info = {};
-
-	if (!conn || bt_conn_get_info(conn, &conn_info) || conn_info.id != BT_ID_SIDEWALK) {
+	if (!conn || bt_conn_get_info(conn, conn_info) || conn_info->id != BT_ID_SIDEWALK) {
 		return false;
 	}
 
 	return true;
 }
 
+#if defined(CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE)
+/* Call with bt_conn_mutex locked */
+static void conn_profile_request(sid_ble_conn_profile_t profile)
+{
+	if (!conn_params.conn) {
+		return;
+	}
+
+	int err = bt_conn_le_param_update(conn_params.conn, &conn_profiles[profile]);
+
+	if (err) {
+		LOG_WRN("Connection parameters update failed (err %d)", err);
+	}
+}
+
+/**
+ * @brief Request the fastest link the peer accepts, the updates are reported by the
+ *        le_phy_updated, le_data_len_updated and le_param_updated callbacks.
+ */
+static void conn_throughput_negotiate(struct bt_conn *conn)
+{
+	int err;
+
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+	err = bt_conn_le_phy_update(conn, BT_CONN_LE_PHY_PARAM_2M);
+	if (err) {
+		LOG_WRN("PHY update failed (err %d)", err);
+	}
+#endif /* CONFIG_BT_USER_PHY_UPDATE */
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+	err = bt_conn_le_data_len_update(conn, BT_LE_DATA_LEN_PARAM_MAX);
+	if (err) {
+		LOG_WRN("Data length update failed (err %d)", err);
+	}
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
+
+	atomic_set(&conn_profile, SID_BLE_CONN_PROFILE_THROUGHPUT);
+	conn_profile_request(SID_BLE_CONN_PROFILE_THROUGHPUT);
+	k_work_reschedule(&conn_idle_work, K_MSEC(CONFIG_SIDEWALK_BLE_CONN_IDLE_TIMEOUT));
+}
+
+static void conn_idle_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	if (atomic_cas(&conn_profile, SID_BLE_CONN_PROFILE_THROUGHPUT,
+		       SID_BLE_CONN_PROFILE_LOW_POWER)) {
+		LOG_DBG("Link idle, low power profile");
+		conn_profile_request(SID_BLE_CONN_PROFILE_LOW_POWER);
+	}
+	k_mutex_unlock(&bt_conn_mutex);
+}
+
+static void conn_active_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
+	if (atomic_get(&conn_profile) == SID_BLE_CONN_PROFILE_THROUGHPUT) {
+		LOG_DBG("Link active, throughput profile");
+		conn_profile_request(SID_BLE_CONN_PROFILE_THROUGHPUT);
+	}
+	k_mutex_unlock(&bt_conn_mutex);
+}
+#endif /* CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE */
+
 /**
  * @brief The function is called when a new connection is established.
  *
@@ -62,8 +162,9 @@ static bool is_connection_valid(struct bt_conn *conn)
 static void ble_connect_cb(struct bt_conn *conn, uint8_t err)
 {
 	const bt_addr_le_t *bt_addr_le = NULL;
+	struct bt_conn_info conn_info = {};
 
-	if (!is_connection_valid(conn)) {
+	if (!is_connection_valid(conn, &conn_info)) {
 		return;
 	}
 
@@ -83,8 +184,22 @@ static void ble_connect_cb(struct bt_conn *conn, uint8_t err)
 
 	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
 	conn_params.conn = bt_conn_ref(conn);
+	conn_params.mtu = BT_ATT_DEFAULT_LE_MTU;
+	conn_params.link = (sid_ble_link_params_t){
+		.interval = conn_info.le.interval,
+		.latency = conn_info.le.latency,
+		.timeout = conn_info.le.timeout,
+		.tx_phy = BT_GAP_LE_PHY_1M,
+		.rx_phy = BT_GAP_LE_PHY_1M,
+		.tx_max_len = BT_GAP_DATA_LEN_DEFAULT,
+		.rx_max_len = BT_GAP_DATA_LEN_DEFAULT,
+	};
 
 	sid_ble_adapter_conn_connected((const uint8_t *)conn_params.addr);
+	sid_ble_adapter_link_params_changed(&conn_params.link);
+#if defined(CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE)
+	conn_throughput_negotiate(conn);
+#endif /* CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE */
 	k_mutex_unlock(&bt_conn_mutex);
 
 	LOG_INF("BT Connected");
@@ -98,15 +213,23 @@ static void ble_connect_cb(struct bt_conn *conn, uint8_t err)
  */
 static void ble_disconnect_cb(struct bt_conn *conn, uint8_t reason)
 {
-	if (!is_connection_valid(conn) || conn_params.conn != conn) {
+	struct bt_conn_info conn_info = {};
+
+	if (!is_connection_valid(conn, &conn_info) || conn_params.conn != conn) {
 		return;
 	}
 
+#if defined(CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE)
+	(void)k_work_cancel_delayable(&conn_idle_work);
+	atomic_set(&conn_profile, SID_BLE_CONN_PROFILE_LOW_POWER);
+#endif /* CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE */
+
 	sid_ble_adapter_conn_disconnected((const uint8_t *)conn_params.addr);
 
 	k_mutex_lock(&bt_conn_mutex, K_FOREVER);
 	bt_conn_unref(conn_params.conn);
 	conn_params.conn = NULL;
+	conn_params.mtu = 0;
 	k_mutex_unlock(&bt_conn_mutex);
 
 	LOG_INF("BT Disconnected Reason: 0x%x = %s", reason, HCI_err_to_str(reason));
@@ -117,8 +240,67 @@ static void ble_mtu_cb(struct bt_conn *conn, uint16_t tx_mtu, uint16_t rx_mtu)
 	ARG_UNUSED(rx_mtu);
 
 	if (!conn_params.conn || conn_params.conn == conn) {
-		sid_ble_adapter_mtu_changed(MIN(tx_mtu, rx_mtu));
+		conn_params.mtu = MIN(tx_mtu, rx_mtu);
+		sid_ble_adapter_mtu_changed(conn_params.mtu);
+	}
+}
+
+static void ble_le_param_updated_cb(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+				    uint16_t timeout)
+{
+	if (!conn_params.conn || conn_params.conn != conn) {
+		return;
+	}
+
+	LOG_INF("Connection interval %u.%02u ms, latency %u, timeout %u ms", interval * 5 / 4,
+		(interval * 125) % 100, latency, timeout * 10);
+	conn_params.link.interval = interval;
+	conn_params.link.latency = latency;
+	conn_params.link.timeout = timeout;
+	sid_ble_adapter_link_params_changed(&conn_params.link);
+}
+
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+static void ble_le_phy_updated_cb(struct bt_conn *conn, struct bt_conn_le_phy_info *param)
+{
+	if (!conn_params.conn || conn_params.conn != conn) {
+		return;
+	}
+
+	LOG_INF("PHY TX %u RX %u", param->tx_phy, param->rx_phy);
+	conn_params.link.tx_phy = param->tx_phy;
+	conn_params.link.rx_phy = param->rx_phy;
+	sid_ble_adapter_link_params_changed(&conn_params.link);
+}
+#endif /* CONFIG_BT_USER_PHY_UPDATE */
+
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+static void ble_le_data_len_updated_cb(struct bt_conn *conn, struct bt_conn_le_data_len_info *info)
+{
+	if (!conn_params.conn || conn_params.conn != conn) {
+		return;
+	}
+
+	LOG_INF("Data length TX %u RX %u", info->tx_max_len, info->rx_max_len);
+	conn_params.link.tx_max_len = info->tx_max_len;
+	conn_params.link.rx_max_len = info->rx_max_len;
+	sid_ble_adapter_link_params_changed(&conn_params.link);
+}
+#endif /* CONFIG_BT_USER_DATA_LEN_UPDATE */
+
+void sid_ble_conn_activity(void)
+{
+#if defined(CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE)
+	if (!conn_params.conn) {
+		return;
+	}
+
+	if (atomic_cas(&conn_profile, SID_BLE_CONN_PROFILE_LOW_POWER,
+		       SID_BLE_CONN_PROFILE_THROUGHPUT)) {
+		k_work_submit(&conn_active_work);
 	}
+	k_work_reschedule(&conn_idle_work, K_MSEC(CONFIG_SIDEWALK_BLE_CONN_IDLE_TIMEOUT));
+#endif /* CONFIG_SIDEWALK_BLE_THROUGHPUT_PROFILE */
 }
 
 const sid_ble_conn_params_t *sid_ble_conn_params_get(void)
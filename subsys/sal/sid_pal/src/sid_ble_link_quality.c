@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_link_quality.c
+ *  @brief RSSI and TX power of the Bluetooth LE connection.
+ */
+
+#include <sid_ble_link_quality.h>
+#include <bt_app_callbacks.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/hci_vs.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+
+#include <errno.h>
+
+LOG_MODULE_REGISTER(sid_ble_lq, CONFIG_SIDEWALK_BLE_ADAPTER_LOG_LEVEL);
+
+int sid_ble_lq_rssi_read(struct bt_conn *conn, int8_t *rssi)
+{
+	struct net_buf *buf, *rsp = NULL;
+	struct bt_hci_cp_read_rssi *cp;
+	struct bt_hci_rp_read_rssi *rp;
+	uint16_t handle = 0;
+	int err;
+
+	if (!conn || !rssi) {
+		return -EINVAL;
+	}
+
+	err = bt_hci_get_conn_handle(conn, &handle);
+	if (err) {
+		LOG_ERR("Can not get conn_handle error %d", err);
+		return err;
+	}
+
+	buf = bt_hci_cmd_create(BT_HCI_OP_READ_RSSI, sizeof(*cp));
+	if (!buf) {
+		LOG_ERR("Unable to allocate command buffer");
+		return -ENOBUFS;
+	}
+
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->handle = sys_cpu_to_le16(handle);
+
+	err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_RSSI, buf, &rsp);
+	if (err) {
+		uint8_t reason = rsp ? ((struct bt_hci_rp_read_rssi *)rsp->data)->status : 0;
+		LOG_ERR("Read RSSI err: %d reason 0x%02x", err, reason);
+		return err;
+	}
+
+	rp = (void *)rsp->data;
+	*rssi = rp->rssi;
+
+	net_buf_unref(rsp);
+
+	return 0;
+}
+
+int sid_ble_lq_tx_power_read(struct bt_conn *conn, int8_t *tx_power)
+{
+	struct bt_hci_cp_vs_read_tx_power_level *cp;
+	struct bt_hci_rp_vs_read_tx_power_level *rp;
+	struct net_buf *buf, *rsp = NULL;
+	uint16_t handle = 0;
+	int err;
+
+	if (!conn || !tx_power) {
+		return -EINVAL;
+	}
+
+	err = bt_hci_get_conn_handle(conn, &handle);
+	if (err) {
+		LOG_ERR("Can not get conn_handle error %d", err);
+		return err;
+	}
+
+	buf = bt_hci_cmd_create(BT_HCI_OP_VS_READ_TX_POWER_LEVEL, sizeof(*cp));
+	if (!buf) {
+		LOG_ERR("Unable to allocate command buffer");
+		return -ENOBUFS;
+	}
+
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->handle = sys_cpu_to_le16(handle);
+	cp->handle_type = BT_HCI_VS_LL_HANDLE_TYPE_CONN;
+
+	err = bt_hci_cmd_send_sync(BT_HCI_OP_VS_READ_TX_POWER_LEVEL, buf, &rsp);
+	if (err) {
+		uint8_t reason =
+			rsp ? ((struct bt_hci_rp_vs_read_tx_power_level *)rsp->data)->status : 0;
+		LOG_ERR("Read Tx power err: %d reason 0x%02x", err, reason);
+		return err;
+	}
+
+	rp = (void *)rsp->data;
+	*tx_power = rp->tx_power_level;
+
+	net_buf_unref(rsp);
+
+	return 0;
+}
+
+#if CONFIG_SIDEWALK_BLE_LINK_QUALITY
+static void lq_tx_power_update(struct bt_conn *conn, int8_t tx_power);
+#endif /* CONFIG_SIDEWALK_BLE_LINK_QUALITY */
+
+int sid_ble_lq_tx_power_write(struct bt_conn *conn, int8_t tx_power)
+{
+	struct bt_hci_cp_vs_write_tx_power_level *cp;
+	struct bt_hci_rp_vs_write_tx_power_level *rp;
+	struct net_buf *buf, *rsp = NULL;
+	uint16_t handle = 0;
+	int err;
+
+	if (!conn) {
+		return -EINVAL;
+	}
+
+	err = bt_hci_get_conn_handle(conn, &handle);
+	if (err) {
+		LOG_ERR("Can not get conn_handle error %d", err);
+		return err;
+	}
+
+	buf = bt_hci_cmd_create(BT_HCI_OP_VS_WRITE_TX_POWER_LEVEL, sizeof(*cp));
+	if (!buf) {
+		LOG_ERR("Unable to allocate command buffer");
+		return -ENOBUFS;
+	}
+
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->handle = sys_cpu_to_le16(handle);
+	cp->handle_type = BT_HCI_VS_LL_HANDLE_TYPE_CONN;
+	cp->tx_power_level = tx_power;
+
+	err = bt_hci_cmd_send_sync(BT_HCI_OP_VS_WRITE_TX_POWER_LEVEL, buf, &rsp);
+	if (err) {
+		uint8_t reason =
+			rsp ? ((struct bt_hci_rp_vs_write_tx_power_level *)rsp->data)->status : 0;
+		LOG_ERR("Set Tx power err: %d reason 0x%02x", err, reason);
+		return err;
+	}
+
+	rp = (void *)rsp->data;
+	LOG_INF("Actual Tx Power: %d", rp->selected_tx_power);
+#if CONFIG_SIDEWALK_BLE_LINK_QUALITY
+	lq_tx_power_update(conn, rp->selected_tx_power);
+#endif /* CONFIG_SIDEWALK_BLE_LINK_QUALITY */
+
+	net_buf_unref(rsp);
+
+	return 0;
+}
+
+#if CONFIG_SIDEWALK_BLE_LINK_QUALITY
+
+/* RSSI average is kept with 4 fractional bits */
+#define LQ_EWMA_FRAC_BITS 4
+
+static void lq_connected(struct bt_conn *conn, uint8_t err);
+static void lq_disconnected(struct bt_conn *conn, uint8_t reason);
+static void lq_sample_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(lq_sample_work, lq_sample_work_handler);
+
+/* HCI commands block until the controller responds, keep them off the system workqueue */
+static K_THREAD_STACK_DEFINE(lq_workq_stack, CONFIG_SIDEWALK_BLE_LINK_QUALITY_STACK_SIZE);
+static struct k_work_q lq_workq;
+
+static struct bt_conn_cb lq_conn_callbacks = {
+	.connected = lq_connected,
+	.disconnected = lq_disconnected,
+};
+
+static struct k_spinlock lq_lock;
+static struct bt_conn *lq_conn;
+static bool lq_enabled;
+
+static struct sid_ble_lq_sample lq_history[CONFIG_SIDEWALK_BLE_LINK_QUALITY_HISTORY];
+static size_t lq_history_head;
+static size_t lq_history_count;
+static int32_t lq_rssi_ewma;
+static int8_t lq_tx_power;
+static bool lq_tx_power_valid;
+
+/* Call with lq_lock held */
+static void lq_reset(void)
+{
+	lq_history_head = 0;
+	lq_history_count = 0;
+	lq_rssi_ewma = 0;
+	lq_tx_power_valid = false;
+}
+
+static void lq_sample_add(int8_t rssi, int8_t tx_power)
+{
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+
+	if (lq_history_count == 0) {
+		lq_rssi_ewma = (int32_t)rssi << LQ_EWMA_FRAC_BITS;
+	} else {
+		lq_rssi_ewma += (((int32_t)rssi << LQ_EWMA_FRAC_BITS) - lq_rssi_ewma) >>
+				CONFIG_SIDEWALK_BLE_LINK_QUALITY_EWMA_SHIFT;
+	}
+
+	lq_history_head = (lq_history_head + 1) % ARRAY_SIZE(lq_history);
+	lq_history[lq_history_head] = (struct sid_ble_lq_sample){
+		.uptime_ms = k_uptime_get(),
+		.rssi = rssi,
+		.tx_power = tx_power,
+	};
+	lq_history_count = MIN(lq_history_count + 1, ARRAY_SIZE(lq_history));
+
+	k_spin_unlock(&lq_lock, key);
+}
+
+static void lq_tx_power_update(struct bt_conn *conn, int8_t tx_power)
+{
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+
+	if (conn == lq_conn) {
+		lq_tx_power = tx_power;
+		lq_tx_power_valid = true;
+	}
+
+	k_spin_unlock(&lq_lock, key);
+}
+
+static void lq_sample_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	struct bt_conn *conn = NULL;
+	bool tx_power_valid;
+	int8_t tx_power;
+	int8_t rssi;
+
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+
+	if (lq_conn) {
+		conn = bt_conn_ref(lq_conn);
+	}
+	tx_power_valid = lq_tx_power_valid;
+	tx_power = lq_tx_power;
+	k_spin_unlock(&lq_lock, key);
+
+	if (!conn) {
+		return;
+	}
+
+	/* TX power changes only on request, it is read once per connection */
+	if (!tx_power_valid && 0 == sid_ble_lq_tx_power_read(conn, &tx_power)) {
+		lq_tx_power_update(conn, tx_power);
+	}
+
+	if (0 == sid_ble_lq_rssi_read(conn, &rssi)) {
+		lq_sample_add(rssi, tx_power);
+	}
+
+	bt_conn_unref(conn);
+	k_work_reschedule_for_queue(&lq_workq, &lq_sample_work,
+				    K_MSEC(CONFIG_SIDEWALK_BLE_LINK_QUALITY_INTERVAL_MS));
+}
+
+static void lq_connected(struct bt_conn *conn, uint8_t err)
+{
+	struct bt_conn_info conn_info = {};
+
+	if (err || !lq_enabled || bt_conn_get_info(conn, &conn_info) ||
+	    conn_info.id != BT_ID_SIDEWALK) {
+		return;
+	}
+
+	struct bt_conn *prev_conn;
+	struct bt_conn *new_conn = bt_conn_ref(conn);
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+
+	prev_conn = lq_conn;
+	lq_conn = new_conn;
+	lq_reset();
+	k_spin_unlock(&lq_lock, key);
+
+	if (prev_conn) {
+		bt_conn_unref(prev_conn);
+	}
+	k_work_reschedule_for_queue(&lq_workq, &lq_sample_work, K_NO_WAIT);
+}
+
+static void lq_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	ARG_UNUSED(reason);
+
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+
+	if (!lq_conn || lq_conn != conn) {
+		k_spin_unlock(&lq_lock, key);
+		return;
+	}
+
+	lq_conn = NULL;
+	lq_reset();
+	k_spin_unlock(&lq_lock, key);
+
+	bt_conn_unref(conn);
+	(void)k_work_cancel_delayable(&lq_sample_work);
+}
+
+void sid_ble_lq_init(void)
+{
+	static bool bt_conn_registered;
+	static bool workq_started;
+
+	if (!workq_started) {
+		const struct k_work_queue_config cfg = { .name = "sid_ble_lq" };
+
+		k_work_queue_init(&lq_workq);
+		k_work_queue_start(&lq_workq, lq_workq_stack,
+				   K_THREAD_STACK_SIZEOF(lq_workq_stack),
+				   K_PRIO_PREEMPT(CONFIG_SIDEWALK_BLE_LINK_QUALITY_PRIORITY), &cfg);
+		workq_started = true;
+	}
+
+	if (!bt_conn_registered) {
+		int err = bt_conn_cb_register(&lq_conn_callbacks);
+
+		if (err && err != -EEXIST) {
+			LOG_ERR("bt_conn_cb_register failed with error: %d", err);
+			return;
+		}
+		bt_conn_registered = true;
+	}
+
+	lq_enabled = true;
+}
+
+void sid_ble_lq_deinit(void)
+{
+	struct bt_conn *conn;
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+
+	lq_enabled = false;
+	conn = lq_conn;
+	lq_conn = NULL;
+	lq_reset();
+	k_spin_unlock(&lq_lock, key);
+
+	if (conn) {
+		bt_conn_unref(conn);
+	}
+	(void)k_work_cancel_delayable(&lq_sample_work);
+}
+
+/* Call with lq_lock held */
+static int lq_latest_check(void)
+{
+	if (lq_history_count == 0) {
+		return -ENODATA;
+	}
+
+	if (k_uptime_get() - lq_history[lq_history_head].uptime_ms >
+	    CONFIG_SIDEWALK_BLE_LINK_QUALITY_MAX_AGE_MS) {
+		return -ETIME;
+	}
+
+	return 0;
+}
+
+int sid_ble_lq_rssi_get(int8_t *rssi)
+{
+	if (!rssi) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+	int err = lq_latest_check();
+
+	if (!err) {
+		/* Round to the nearest dBm */
+		*rssi = (int8_t)((lq_rssi_ewma + BIT(LQ_EWMA_FRAC_BITS - 1)) >> LQ_EWMA_FRAC_BITS);
+	}
+	k_spin_unlock(&lq_lock, key);
+
+	return err;
+}
+
+int sid_ble_lq_tx_power_get(int8_t *tx_power)
+{
+	if (!tx_power) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+	int err = lq_latest_check();
+
+	if (!err && !lq_tx_power_valid) {
+		err = -ENODATA;
+	}
+	if (!err) {
+		*tx_power = lq_tx_power;
+	}
+	k_spin_unlock(&lq_lock, key);
+
+	return err;
+}
+
+size_t sid_ble_lq_history_get(struct sid_ble_lq_sample *samples, size_t count)
+{
+	size_t copied = 0;
+
+	if (!samples) {
+		return 0;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lq_lock);
+
+	count = MIN(count, lq_history_count);
+	for (size_t idx = lq_history_head; copied < count; copied++) {
+		samples[copied] = lq_history[idx];
+		idx = (idx + ARRAY_SIZE(lq_history) - 1) % ARRAY_SIZE(lq_history);
+	}
+	k_spin_unlock(&lq_lock, key);
+
+	return copied;
+}
+
+#endif /* CONFIG_SIDEWALK_BLE_LINK_QUALITY */
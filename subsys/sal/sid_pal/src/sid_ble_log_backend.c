@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_ble_log_backend.c
+ *  @brief Log backend streaming log records in notifications of the BLE logging service.
+ *
+ *  Records are kept in a ring buffer which drops the oldest records when it is full, and are
+ *  packed back to back into notifications of the ATT MTU size. The rest of a record split
+ *  between notifications is moved out of the ring, so the ring always starts with a whole
+ *  record. One notification is in flight at a time and the next one is sent
+ *  CONFIG_SIDEWALK_LOG_BACKEND_BLE_INTERVAL_MS after the previous one completes, so Sidewalk
+ *  notifications keep most of the Bluetooth buffers.
+ *
+ *  Nothing in this file may log, the messages would come back to the backend.
+ */
+
+#include <sid_ble_log_backend.h>
+#include <sid_ble_log_service.h>
+#include <sid_ble_service.h>
+#include <sid_ble_connection.h>
+#include <sid_ble_adapter_callbacks.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_output.h>
+
+#include <errno.h>
+#include <string.h>
+
+/* Opcode and attribute handle of a notification */
+#define NOTIFY_HDR_SIZE 3
+
+#define RING_SIZE CONFIG_SIDEWALK_LOG_BACKEND_BLE_BUFFER_SIZE
+#define RECORD_HDR_SIZE sizeof(uint16_t)
+#define TX_INTERVAL K_MSEC(CONFIG_SIDEWALK_LOG_BACKEND_BLE_INTERVAL_MS)
+
+#define OUTPUT_FLAGS                                                                               \
+	(LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP | LOG_OUTPUT_FLAG_CRLF_LFONLY)
+
+/* Records stored as 16 bit length followed by the record bytes */
+static uint8_t ring[RING_SIZE];
+static size_t ring_head;
+static size_t ring_used;
+/* Unsent rest of the record split between notifications, it is sent before the ring */
+static uint8_t cont_buf[CONFIG_SIDEWALK_LOG_BACKEND_BLE_RECORD_MAX];
+static size_t cont_len;
+static size_t cont_sent;
+static struct k_spinlock ring_lock;
+static struct sid_ble_log_backend_stats stats;
+
+static void tx_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(tx_work, tx_work_handler);
+
+static uint8_t tx_buf[CONFIG_SIDEWALK_LOG_BACKEND_BLE_NOTIFY_MAX];
+static size_t tx_len;
+static struct bt_gatt_notify_params tx_params;
+static const struct bt_gatt_attr *tx_attr;
+static atomic_t tx_in_flight;
+
+static size_t ring_pos(size_t offset)
+{
+	return (ring_head + offset) % RING_SIZE;
+}
+
+static void ring_copy_in(size_t pos, const uint8_t *data, size_t len)
+{
+	size_t first = MIN(len, RING_SIZE - pos);
+
+	memcpy(&ring[pos], data, first);
+	memcpy(ring, &data[first], len - first);
+}
+
+static void ring_copy_out(size_t pos, uint8_t *data, size_t len)
+{
+	size_t first = MIN(len, RING_SIZE - pos);
+
+	memcpy(data, &ring[pos], first);
+	memcpy(&data[first], ring, len - first);
+}
+
+static uint16_t ring_record_len(size_t pos)
+{
+	uint16_t len;
+
+	ring_copy_out(pos, (uint8_t *)&len, sizeof(len));
+	return len;
+}
+
+static void ring_head_pop(uint16_t len)
+{
+	ring_head = ring_pos(RECORD_HDR_SIZE + len);
+	ring_used -= RECORD_HDR_SIZE + len;
+}
+
+static void ring_drop_oldest(void)
+{
+	uint16_t len = ring_record_len(ring_head);
+
+	ring_head_pop(len);
+	stats.dropped++;
+	stats.dropped_bytes += len;
+}
+
+static void record_write(const uint8_t *data, uint16_t len, bool truncated)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+
+	stats.truncated += truncated ? 1 : 0;
+
+	/* A record is never longer than the ring, see the Kconfig ranges */
+	while (RING_SIZE - ring_used < RECORD_HDR_SIZE + len) {
+		ring_drop_oldest();
+	}
+
+	size_t tail = ring_pos(ring_used);
+
+	ring_copy_in(tail, (const uint8_t *)&len, RECORD_HDR_SIZE);
+	ring_copy_in((tail + RECORD_HDR_SIZE) % RING_SIZE, data, len);
+	ring_used += RECORD_HDR_SIZE + len;
+	stats.records++;
+
+	k_spin_unlock(&ring_lock, key);
+
+	/* Records written until the work runs share the notification */
+	k_work_schedule(&tx_work, TX_INTERVAL);
+}
+
+/* Pack the oldest records into the buffer, the last one may continue in the next notification */
+static size_t ring_read(uint8_t *buf, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+	size_t len = MIN(cont_len - cont_sent, size);
+
+	memcpy(buf, &cont_buf[cont_sent], len);
+	cont_sent += len;
+
+	while (ring_used && len < size) {
+		uint16_t rec_len = ring_record_len(ring_head);
+		size_t chunk = MIN(rec_len, size - len);
+
+		ring_copy_out(ring_pos(RECORD_HDR_SIZE), &buf[len], chunk);
+		if (chunk < rec_len) {
+			cont_len = rec_len - chunk;
+			cont_sent = 0;
+			ring_copy_out(ring_pos(RECORD_HDR_SIZE + chunk), cont_buf, cont_len);
+		}
+		len += chunk;
+		ring_head_pop(rec_len);
+	}
+
+	k_spin_unlock(&ring_lock, key);
+
+	return len;
+}
+
+static void tx_done(struct bt_conn *conn, void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(user_data);
+
+	atomic_clear(&tx_in_flight);
+	k_work_schedule(&tx_work, TX_INTERVAL);
+}
+
+static void tx_work_handler(struct k_work *work)
+{
+	const sid_ble_conn_params_t *conn_params = sid_ble_conn_params_get();
+	k_spinlock_key_t key;
+	int err;
+
+	ARG_UNUSED(work);
+
+	if (atomic_get(&tx_in_flight) || !sid_ble_adapter_notification_enabled(LOGGING_SERVICE) ||
+	    !conn_params || !conn_params->conn || conn_params->mtu <= NOTIFY_HDR_SIZE) {
+		return;
+	}
+
+	if (!tx_attr) {
+		tx_attr = sid_ble_srv_notify_attr_get(sid_ble_get_log_service(),
+						      LOG_SID_BT_CHARACTERISTIC_NOTIFY);
+		if (!tx_attr) {
+			return;
+		}
+	}
+
+	/* A notification rejected for lack of buffers is sent again before newer records */
+	if (!tx_len) {
+		tx_len = ring_read(tx_buf, MIN(sizeof(tx_buf), conn_params->mtu - NOTIFY_HDR_SIZE));
+		if (!tx_len) {
+			return;
+		}
+	}
+
+	tx_params = (struct bt_gatt_notify_params){
+		.attr = tx_attr,
+		.data = tx_buf,
+		.len = tx_len,
+		.func = tx_done,
+	};
+
+	atomic_set(&tx_in_flight, 1);
+	err = bt_gatt_notify_cb(conn_params->conn, &tx_params);
+
+	key = k_spin_lock(&ring_lock);
+	if (err) {
+		atomic_clear(&tx_in_flight);
+		stats.send_errors++;
+		if (err != -ENOMEM) {
+			stats.dropped_bytes += tx_len;
+			tx_len = 0;
+		}
+	} else {
+		stats.notifications++;
+		stats.bytes += tx_len;
+		tx_len = 0;
+	}
+	k_spin_unlock(&ring_lock, key);
+
+	if (err == -ENOMEM) {
+		k_work_schedule(&tx_work, TX_INTERVAL);
+	}
+}
+
+void sid_ble_log_backend_write(const uint8_t *data, size_t len)
+{
+	if (!data || !len) {
+		return;
+	}
+
+	record_write(data, MIN(len, CONFIG_SIDEWALK_LOG_BACKEND_BLE_RECORD_MAX),
+		     len > CONFIG_SIDEWALK_LOG_BACKEND_BLE_RECORD_MAX);
+}
+
+void sid_ble_log_backend_kick(void)
+{
+	k_work_schedule(&tx_work, K_NO_WAIT);
+}
+
+void sid_ble_log_backend_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+
+	/* The notification in flight never completes, the pending one has no link to go to */
+	atomic_clear(&tx_in_flight);
+	stats.dropped_bytes += tx_len;
+	tx_len = 0;
+
+	k_spin_unlock(&ring_lock, key);
+}
+
+void sid_ble_log_backend_stats_get(struct sid_ble_log_backend_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+
+	*out = stats;
+
+	k_spin_unlock(&ring_lock, key);
+}
+
+void sid_ble_log_backend_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+
+	stats = (struct sid_ble_log_backend_stats){ 0 };
+
+	k_spin_unlock(&ring_lock, key);
+}
+
+/* Log backend, one formatted or dictionary message is one record */
+static uint8_t record[CONFIG_SIDEWALK_LOG_BACKEND_BLE_RECORD_MAX];
+static size_t record_len;
+static bool record_truncated;
+static uint8_t output_buf[32];
+static uint32_t log_format_current = CONFIG_LOG_BACKEND_SIDEWALK_BLE_OUTPUT_DEFAULT;
+
+static int record_out(uint8_t *data, size_t length, void *ctx)
+{
+	size_t len = MIN(length, sizeof(record) - record_len);
+
+	ARG_UNUSED(ctx);
+
+	memcpy(&record[record_len], data, len);
+	record_len += len;
+	record_truncated |= (len < length);
+
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(log_output_sid_ble, record_out, output_buf, sizeof(output_buf));
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
+
+	ARG_UNUSED(backend);
+
+	record_len = 0;
+	record_truncated = false;
+	log_output_func(&log_output_sid_ble, &msg->log, OUTPUT_FLAGS);
+
+	if (record_len) {
+		record_write(record, record_len, record_truncated);
+	}
+}
+
+static int format_set(const struct log_backend *const backend, uint32_t log_type)
+{
+	ARG_UNUSED(backend);
+
+	if (!log_format_func_t_get(log_type)) {
+		return -EINVAL;
+	}
+
+	log_format_current = log_type;
+	return 0;
+}
+
+static void panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+	/* Bluetooth does not run after a panic, the records stay in the ring buffer */
+}
+
+static const struct log_backend_api log_backend_sid_ble_api = {
+	.process = process,
+	.panic = panic,
+	.format_set = format_set,
+};
+
+LOG_BACKEND_DEFINE(log_backend_sid_ble, log_backend_sid_ble_api, true);
@@ -10,6 +10,7 @@
 
 #include <sid_ble_log_service.h>
 #include <sid_ble_adapter_callbacks.h>
+#include <sid_ble_log_backend.h>
 
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
@@ -38,6 +39,14 @@ static void log_srv_notif_changed(const struct bt_gatt_attr *attr, uint16_t valu
 	ARG_UNUSED(attr);
 	LOG_DBG("Notification for LOGGING_SERVICE is %s.", notif_enabled ? "enabled" : "disabled");
 	sid_ble_adapter_notification_changed(LOGGING_SERVICE, notif_enabled);
+
+#if defined(CONFIG_SIDEWALK_LOG_BACKEND_BLE)
+	if (notif_enabled) {
+		sid_ble_log_backend_kick();
+	} else {
+		sid_ble_log_backend_reset();
+	}
+#endif /* CONFIG_SIDEWALK_LOG_BACKEND_BLE */
 }
 
 static ssize_t log_srv_on_write(struct bt_conn *conn, const struct bt_gatt_attr *attr,
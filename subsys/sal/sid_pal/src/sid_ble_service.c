@@ -11,60 +11,184 @@
 #include <sid_ble_service.h>
 #include <sid_ble_adapter_callbacks.h>
 
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(sid_ble_srv, CONFIG_SIDEWALK_LOG_LEVEL);
 
-static struct bt_gatt_notify_params not_params;
+/*
+ * Completions of one connection event are reported together by the host. A completion
+ * closer than this to the previous one belongs to the same connection event, the shortest
+ * connection interval is 7.5 ms.
+ */
+#define TX_CONN_EVENT_GAP_MS 2
+
+struct tx_slot {
+	struct bt_gatt_notify_params params;
+	uint16_t len;
+};
+
+static struct tx_slot tx_slots[CONFIG_SIDEWALK_BLE_TX_QUEUE_DEPTH];
+static ATOMIC_DEFINE(tx_slots_used, CONFIG_SIDEWALK_BLE_TX_QUEUE_DEPTH);
+
+static struct k_spinlock tx_stats_lock;
+static struct sid_ble_send_stats tx_stats;
+static int64_t tx_active_start;
+static int64_t tx_last_completion;
+
+static struct tx_slot *tx_slot_alloc(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(tx_slots); i++) {
+		if (!atomic_test_and_set_bit(tx_slots_used, i)) {
+			return &tx_slots[i];
+		}
+	}
+
+	return NULL;
+}
+
+static bool tx_slot_free(struct tx_slot *slot)
+{
+	return atomic_test_and_clear_bit(tx_slots_used, slot - tx_slots);
+}
+
+static void tx_stats_queued(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&tx_stats_lock);
+
+	if (tx_stats.in_flight++ == 0) {
+		tx_active_start = k_uptime_get();
+	}
+	tx_stats.max_in_flight = MAX(tx_stats.max_in_flight, tx_stats.in_flight);
+	tx_stats.queued++;
+
+	k_spin_unlock(&tx_stats_lock, key);
+}
+
+static void tx_stats_done(struct tx_slot *slot, bool sent)
+{
+	k_spinlock_key_t key = k_spin_lock(&tx_stats_lock);
+	int64_t now = k_uptime_get();
+
+	if (sent) {
+		tx_stats.sent++;
+		tx_stats.bytes += slot->len;
+		if (!tx_stats.conn_events || now - tx_last_completion >= TX_CONN_EVENT_GAP_MS) {
+			tx_stats.conn_events++;
+		}
+		tx_last_completion = now;
+	}
+	if (--tx_stats.in_flight == 0) {
+		tx_stats.active_ms += now - tx_active_start;
+	}
+
+	k_spin_unlock(&tx_stats_lock, key);
+}
 
 static void notification_sent(struct bt_conn *conn, void *user_data)
 {
-	ARG_UNUSED(user_data);
+	struct tx_slot *slot = (struct tx_slot *)user_data;
+
 	ARG_UNUSED(conn);
 
 	LOG_DBG("Notification sent.");
 
+	/* A slot returned by sid_ble_send_reset is not counted twice. */
+	if (slot && tx_slot_free(slot)) {
+		tx_stats_done(slot, true);
+	}
+
 	sid_ble_adapter_notification_sent();
 }
 
-int sid_ble_send_data(sid_ble_srv_params_t *params, uint8_t *data, uint16_t length)
+const struct bt_gatt_attr *sid_ble_srv_notify_attr_get(const struct bt_gatt_service_static *service,
+						       const struct bt_uuid *uuid)
 {
-	int error_code;
-	const struct bt_gatt_attr *srv_attrs = NULL;
-	uint16_t srv_attr_count = 0;
-	const struct bt_gatt_attr *attr = NULL;
-
-	if (!params) {
-		return -ENOENT;
+	if (!service || !uuid) {
+		return NULL;
 	}
 
-	if (NULL != params->service) {
-		srv_attrs = params->service->attrs;
-		srv_attr_count = params->service->attr_count;
-	}
-	attr = bt_gatt_find_by_uuid(srv_attrs, srv_attr_count, params->uuid);
+	return bt_gatt_find_by_uuid(service->attrs, service->attr_count, uuid);
+}
 
-	if (!attr) {
-		LOG_ERR("Attribute not found.");
+int sid_ble_send_data(sid_ble_srv_params_t *params, uint8_t *data, uint16_t length)
+{
+	int error_code;
+
+	if (!params || !params->attr) {
 		return -ENOENT;
 	}
 
-	if (!data || !length || bt_gatt_get_mtu(params->conn) < length ||
-	    !bt_gatt_is_subscribed(params->conn, attr, BT_GATT_CCC_NOTIFY)) {
+	if (!data || !length || params->mtu < length || !params->subscribed) {
 		return -EINVAL;
 	}
 
-	memset(&not_params, 0, sizeof(not_params));
+	struct tx_slot *slot = tx_slot_alloc();
+
+	if (!slot) {
+		k_spinlock_key_t key = k_spin_lock(&tx_stats_lock);
 
-	not_params.attr = attr;
-	not_params.data = data;
-	not_params.len = length;
-	not_params.func = notification_sent;
+		tx_stats.queue_full++;
+		k_spin_unlock(&tx_stats_lock, key);
+		return -ENOMEM;
+	}
 
-	error_code = bt_gatt_notify_cb(params->conn, &not_params);
+	slot->params = (struct bt_gatt_notify_params){
+		.attr = params->attr,
+		.data = data,
+		.len = length,
+		.func = notification_sent,
+		.user_data = slot,
+	};
+	slot->len = length;
+	tx_stats_queued();
+
+	error_code = bt_gatt_notify_cb(params->conn, &slot->params);
 	if (error_code) {
 		LOG_ERR("Send err:%d.", error_code);
+		if (tx_slot_free(slot)) {
+			tx_stats_done(slot, false);
+		}
 	}
 
 	return error_code;
 }
+
+void sid_ble_send_stats_get(struct sid_ble_send_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&tx_stats_lock);
+
+	*stats = tx_stats;
+	if (tx_stats.in_flight) {
+		stats->active_ms += k_uptime_get() - tx_active_start;
+	}
+
+	k_spin_unlock(&tx_stats_lock, key);
+}
+
+void sid_ble_send_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&tx_stats_lock);
+	uint32_t in_flight = tx_stats.in_flight;
+
+	tx_stats = (struct sid_ble_send_stats){ .in_flight = in_flight };
+	tx_active_start = k_uptime_get();
+
+	k_spin_unlock(&tx_stats_lock, key);
+}
+
+void sid_ble_send_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&tx_stats_lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(tx_slots); i++) {
+		atomic_clear_bit(tx_slots_used, i);
+	}
+	if (tx_stats.in_flight) {
+		tx_stats.active_ms += k_uptime_get() - tx_active_start;
+		tx_stats.in_flight = 0;
+	}
+
+	k_spin_unlock(&tx_stats_lock, key);
+}
@@ -9,19 +9,136 @@
  */
 
 #include <sid_pal_critical_region_ifc.h>
+#include <sid_critical_section.h>
 #include <assert.h>
+#include <errno.h>
 
 #include <zephyr/kernel.h>
 
 static atomic_t count = ATOMIC_INIT(0);
 static unsigned int key = 0;
 
+#if CONFIG_SIDEWALK_CRITICAL_SECTION_STATS
+/* Only the statistics are used, the global region is an interrupt lock */
+static SID_CRITICAL_SECTION_DEFINE(global_region, "global");
+
+/* Sections entered at least once, in that order */
+static sys_slist_t sections = SYS_SLIST_STATIC_INIT(&sections);
+static struct k_spinlock sections_lock;
+
+static void stats_begin(struct sid_critical_section *section)
+{
+	section->enter_cycles = k_cycle_get_32();
+}
+
+static void stats_end(struct sid_critical_section *section)
+{
+	uint32_t cycles = k_cycle_get_32() - section->enter_cycles;
+
+	section->stats.count++;
+	section->stats.total_cycles += cycles;
+	section->stats.max_cycles = MAX(section->stats.max_cycles, cycles);
+}
+
+static void section_register(struct sid_critical_section *section)
+{
+	/* Lock order is sections_lock before the section lock, the section is not held here */
+	k_spinlock_key_t list_key = k_spin_lock(&sections_lock);
+
+	if (!section->registered) {
+		sys_slist_append(&sections, &section->node);
+		section->registered = true;
+	}
+
+	k_spin_unlock(&sections_lock, list_key);
+}
+
+sid_critical_section_key_t sid_critical_section_enter(struct sid_critical_section *section)
+{
+	if (!section->registered) {
+		section_register(section);
+	}
+
+	k_spinlock_key_t section_key = k_spin_lock(&section->lock);
+
+	stats_begin(section);
+	return section_key;
+}
+
+void sid_critical_section_exit(struct sid_critical_section *section,
+			       sid_critical_section_key_t section_key)
+{
+	stats_end(section);
+	k_spin_unlock(&section->lock, section_key);
+}
+
+int sid_critical_section_stats_get(size_t index, const char **name,
+				   struct sid_critical_section_stats *stats)
+{
+	struct sid_critical_section *section = NULL;
+
+	if (index == 0) {
+		unsigned int irq_key = irq_lock();
+
+		*name = global_region.name;
+		*stats = global_region.stats;
+		irq_unlock(irq_key);
+		return 0;
+	}
+
+	k_spinlock_key_t list_key = k_spin_lock(&sections_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sections, section, node) {
+		if (--index == 0) {
+			k_spinlock_key_t section_key = k_spin_lock(&section->lock);
+
+			*name = section->name;
+			*stats = section->stats;
+			k_spin_unlock(&section->lock, section_key);
+			break;
+		}
+	}
+
+	k_spin_unlock(&sections_lock, list_key);
+
+	return section ? 0 : -ENOENT;
+}
+
+void sid_critical_section_stats_reset(void)
+{
+	struct sid_critical_section *section;
+	unsigned int irq_key = irq_lock();
+
+	global_region.stats = (struct sid_critical_section_stats){ 0 };
+	irq_unlock(irq_key);
+
+	k_spinlock_key_t list_key = k_spin_lock(&sections_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sections, section, node) {
+		k_spinlock_key_t section_key = k_spin_lock(&section->lock);
+
+		section->stats = (struct sid_critical_section_stats){ 0 };
+		k_spin_unlock(&section->lock, section_key);
+	}
+
+	k_spin_unlock(&sections_lock, list_key);
+}
+#endif /* CONFIG_SIDEWALK_CRITICAL_SECTION_STATS */
+
+bool sid_critical_region_is_held(void)
+{
+	return atomic_get(&count) > 0;
+}
+
 void sid_pal_enter_critical_region()
 {
 	const unsigned int prev_val = atomic_add(&count, 1);
 
 	if (prev_val == 0) {
 		key = irq_lock();
+#if CONFIG_SIDEWALK_CRITICAL_SECTION_STATS
+		stats_begin(&global_region);
+#endif /* CONFIG_SIDEWALK_CRITICAL_SECTION_STATS */
 	}
 
 	assert(prev_val <= CONFIG_SIDEWALK_CRITICAL_REGION_RE_ENTRY_MAX);
@@ -34,6 +151,9 @@ void sid_pal_exit_critical_region()
 	assert(prev_val > 0);
 
 	if (prev_val == 1) {
+#if CONFIG_SIDEWALK_CRITICAL_SECTION_STATS
+		stats_end(&global_region);
+#endif /* CONFIG_SIDEWALK_CRITICAL_SECTION_STATS */
 		irq_unlock(key);
 	}
 }
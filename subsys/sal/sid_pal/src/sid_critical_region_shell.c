@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_critical_region_shell.c
+ *  @brief Shell commands for the interrupt masked time of the Sidewalk critical sections.
+ */
+
+#include <sid_critical_section.h>
+
+#include <zephyr/shell/shell.h>
+
+static int cmd_sid_critical_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	struct sid_critical_section_stats stats;
+	const char *name;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-12s %10s %10s %12s %10s", "section", "count", "max [us]", "total [us]",
+		    "avg [us]");
+	for (size_t i = 0; sid_critical_section_stats_get(i, &name, &stats) == 0; i++) {
+		unsigned long long total_us = k_cyc_to_us_floor64(stats.total_cycles);
+
+		shell_print(sh, "%-12s %10u %10u %12llu %10llu", name, stats.count,
+			    k_cyc_to_us_ceil32(stats.max_cycles), total_us,
+			    stats.count ? total_us / stats.count : 0ULL);
+	}
+
+	return 0;
+}
+
+static int cmd_sid_critical_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sid_critical_section_stats_reset();
+	shell_print(sh, "Statistics cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_sid_critical,
+	SHELL_CMD_ARG(stats, NULL, "Print interrupt masked time of the critical sections",
+		      cmd_sid_critical_stats, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Clear the statistics", cmd_sid_critical_reset, 1, 0),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(sid_critical, &sub_sid_critical, "Sidewalk critical sections", NULL);
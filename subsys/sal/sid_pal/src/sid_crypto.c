@@ -72,10 +72,43 @@ static bool is_initialized = false;
 /* Prefix for uncompressed public key */
 static const uint8_t secpxxx_key_prefix[SECPxxx_KEY_PREFIX_LEN] = { 0x04 };
 
+#if CONFIG_SIDEWALK_CRYPTO_KEY_CACHE
+/* Longer keys are imported for every operation. */
+#define KEY_CACHE_MAX_KEY_LENGTH (32)
+
+#define FNV_OFFSET_BASIS (2166136261u)
+#define FNV_PRIME (16777619u)
+
+struct key_cache_entry {
+	psa_key_handle_t key_handle;
+	/* Hash of the key material and policy, compared before the key itself. */
+	uint32_t tag;
+	/* Zero for a free entry. */
+	uint32_t last_used;
+	psa_key_usage_t usage_flags;
+	psa_algorithm_t alg;
+	psa_key_type_t type;
+	size_t key_bits;
+	/* Operations currently using the key handle, entry can not be evicted. */
+	uint8_t users;
+	uint8_t key_length;
+	uint8_t key[KEY_CACHE_MAX_KEY_LENGTH];
+};
+
+/* Imported volatile keys reused by AES, AEAD and HMAC operations. */
+static struct key_cache_entry key_cache[CONFIG_SIDEWALK_CRYPTO_KEY_CACHE_SIZE];
+static uint32_t key_cache_clock;
+static K_MUTEX_DEFINE(key_cache_mutex);
+#endif /* CONFIG_SIDEWALK_CRYPTO_KEY_CACHE */
+
 static sid_error_t get_error(psa_status_t psa_erc, const char *func_name);
 static psa_status_t prepare_key(const uint8_t *key, size_t key_length, size_t key_bits,
 				psa_key_usage_t usage_flags, psa_algorithm_t alg,
 				psa_key_type_t type, psa_key_handle_t *key_handle);
+static psa_status_t prepare_cached_key(const uint8_t *key, size_t key_length, size_t key_bits,
+				       psa_key_usage_t usage_flags, psa_algorithm_t alg,
+				       psa_key_type_t type, psa_key_handle_t *key_handle);
+static void release_key(psa_key_handle_t key_handle);
 static psa_status_t aes_execute(psa_cipher_operation_t *operation, sid_pal_aes_params_t *params);
 static psa_status_t aes_encrypt(psa_key_handle_t key_handle, sid_pal_aes_params_t *params);
 static psa_status_t aes_decrypt(psa_key_handle_t key_handle, sid_pal_aes_params_t *params);
@@ -175,6 +208,223 @@ static psa_status_t prepare_key(const uint8_t *key, size_t key_length, size_t ke
 	return status;
 }
 
+#if CONFIG_SIDEWALK_CRYPTO_KEY_CACHE
+static void secure_wipe(void *buffer, size_t size)
+{
+	volatile uint8_t *ptr = buffer;
+
+	while (size--) {
+		*ptr++ = 0;
+	}
+}
+
+static bool key_equal(const uint8_t *a, const uint8_t *b, size_t length)
+{
+	uint8_t diff = 0;
+
+	for (size_t i = 0; i < length; i++) {
+		diff |= a[i] ^ b[i];
+	}
+	return 0 == diff;
+}
+
+static uint32_t hash_update(uint32_t hash, const void *data, size_t size)
+{
+	const uint8_t *bytes = data;
+
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ bytes[i]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+static uint32_t key_cache_tag(const uint8_t *key, size_t key_length, size_t key_bits,
+			      psa_key_usage_t usage_flags, psa_algorithm_t alg,
+			      psa_key_type_t type)
+{
+	uint32_t hash = FNV_OFFSET_BASIS;
+
+	hash = hash_update(hash, key, key_length);
+	hash = hash_update(hash, &key_bits, sizeof(key_bits));
+	hash = hash_update(hash, &usage_flags, sizeof(usage_flags));
+	hash = hash_update(hash, &alg, sizeof(alg));
+	return hash_update(hash, &type, sizeof(type));
+}
+
+static void key_cache_evict(struct key_cache_entry *entry)
+{
+	if (PSA_SUCCESS != psa_destroy_key(entry->key_handle)) {
+		LOG_WRN("Destroy key failed!");
+	}
+	secure_wipe(entry, sizeof(*entry));
+}
+
+static struct key_cache_entry *key_cache_idle_oldest(void)
+{
+	struct key_cache_entry *oldest = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		struct key_cache_entry *entry = &key_cache[i];
+
+		if (entry->last_used && !entry->users &&
+		    (!oldest || entry->last_used < oldest->last_used)) {
+			oldest = entry;
+		}
+	}
+	return oldest;
+}
+
+static void key_cache_clear(void)
+{
+	k_mutex_lock(&key_cache_mutex, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		if (key_cache[i].last_used) {
+			key_cache_evict(&key_cache[i]);
+		}
+	}
+	key_cache_clock = 0;
+	k_mutex_unlock(&key_cache_mutex);
+}
+#endif /* CONFIG_SIDEWALK_CRYPTO_KEY_CACHE */
+
+/**
+ * @brief Get key handle for AES, AEAD and HMAC operations.
+ * The handle is taken from the key cache when the same key was used recently,
+ * otherwise the key is imported and added to the cache.
+ * Every successful call must be followed by release_key().
+ *
+ * @param key - binary key buffer.
+ * @param key_length - key length in bytes.
+ * @param key_bits - key length in bits.
+ * @param usage_flags - define which opeartions are permitted with te key.
+ * @param alg - key permitted-algorithm policy.
+ * @param type - key type.
+ * @param key_handle - handle to key (null when key cannot be set).
+ *
+ * @return PSA_SUCCESS when success, otherwise error code.
+ */
+static psa_status_t prepare_cached_key(const uint8_t *key, size_t key_length, size_t key_bits,
+				       psa_key_usage_t usage_flags, psa_algorithm_t alg,
+				       psa_key_type_t type, psa_key_handle_t *key_handle)
+{
+#if CONFIG_SIDEWALK_CRYPTO_KEY_CACHE
+	struct key_cache_entry *victim = NULL;
+	psa_status_t status;
+	uint32_t tag;
+
+	if (!key_handle || key_length > KEY_CACHE_MAX_KEY_LENGTH) {
+		status = prepare_key(key, key_length, key_bits, usage_flags, alg, type, key_handle);
+		if (PSA_ERROR_INSUFFICIENT_MEMORY == status) {
+			/* Cached keys may hold all PSA key slots, free one and retry once. */
+			k_mutex_lock(&key_cache_mutex, K_FOREVER);
+			victim = key_cache_idle_oldest();
+			if (victim) {
+				key_cache_evict(victim);
+			}
+			k_mutex_unlock(&key_cache_mutex);
+			if (victim) {
+				status = prepare_key(key, key_length, key_bits, usage_flags, alg,
+						     type, key_handle);
+			}
+		}
+		return status;
+	}
+
+	tag = key_cache_tag(key, key_length, key_bits, usage_flags, alg, type);
+
+	k_mutex_lock(&key_cache_mutex, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		struct key_cache_entry *entry = &key_cache[i];
+
+		if (entry->last_used && entry->tag == tag && entry->key_bits == key_bits &&
+		    entry->usage_flags == usage_flags && entry->alg == alg &&
+		    entry->type == type && entry->key_length == key_length &&
+		    key_equal(entry->key, key, key_length)) {
+			entry->users++;
+			entry->last_used = ++key_cache_clock;
+			*key_handle = entry->key_handle;
+			k_mutex_unlock(&key_cache_mutex);
+			return PSA_SUCCESS;
+		}
+
+		if (!entry->users && (!victim || entry->last_used < victim->last_used)) {
+			victim = entry;
+		}
+	}
+
+	status = prepare_key(key, key_length, key_bits, usage_flags, alg, type, key_handle);
+	if (PSA_ERROR_INSUFFICIENT_MEMORY == status) {
+		/* PSA key slots are full, free the least recently used idle key and retry once. */
+		struct key_cache_entry *idle = key_cache_idle_oldest();
+
+		if (idle) {
+			key_cache_evict(idle);
+			if (!victim || victim->last_used) {
+				victim = idle;
+			}
+			status = prepare_key(key, key_length, key_bits, usage_flags, alg, type,
+					     key_handle);
+		}
+	}
+#ifdef CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE
+	/* Persistent Sidewalk keys are never destroyed, there is nothing to cache. */
+	if (PSA_SUCCESS == status && SID_CRYPTO_KEYS_ID_IS_SIDEWALK_KEY(*key_handle)) {
+		victim = NULL;
+	}
+#endif /* CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE */
+	if (PSA_SUCCESS == status && victim) {
+		if (victim->last_used) {
+			key_cache_evict(victim);
+		}
+		victim->key_handle = *key_handle;
+		victim->tag = tag;
+		victim->last_used = ++key_cache_clock;
+		victim->usage_flags = usage_flags;
+		victim->alg = alg;
+		victim->type = type;
+		victim->key_bits = key_bits;
+		victim->users = 1;
+		victim->key_length = key_length;
+		memcpy(victim->key, key, key_length);
+	}
+	k_mutex_unlock(&key_cache_mutex);
+
+	return status;
+#else
+	return prepare_key(key, key_length, key_bits, usage_flags, alg, type, key_handle);
+#endif /* CONFIG_SIDEWALK_CRYPTO_KEY_CACHE */
+}
+
+/**
+ * @brief Release key handle returned by prepare_cached_key().
+ * Cached keys stay imported, other volatile keys are destroyed.
+ *
+ * @param key_handle - handle to key.
+ */
+static void release_key(psa_key_handle_t key_handle)
+{
+#if CONFIG_SIDEWALK_CRYPTO_KEY_CACHE
+	k_mutex_lock(&key_cache_mutex, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		if (key_cache[i].users && key_cache[i].key_handle == key_handle) {
+			key_cache[i].users--;
+			k_mutex_unlock(&key_cache_mutex);
+			return;
+		}
+	}
+	k_mutex_unlock(&key_cache_mutex);
+#endif /* CONFIG_SIDEWALK_CRYPTO_KEY_CACHE */
+
+#ifdef CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE
+	if (SID_CRYPTO_KEYS_ID_IS_SIDEWALK_KEY(key_handle)) {
+		return;
+	}
+#endif /* CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE */
+	if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
+		LOG_WRN("Destroy key failed!");
+	}
+}
+
 /**
  * @brief Perform the AES algorithm.
  * NOTE: The algorithm must be set before calling this function.
@@ -397,6 +647,10 @@ sid_error_t sid_pal_crypto_deinit(void)
 	}
 #endif /* CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE */
 
+#if CONFIG_SIDEWALK_CRYPTO_KEY_CACHE
+	key_cache_clear();
+#endif /* CONFIG_SIDEWALK_CRYPTO_KEY_CACHE */
+
 	is_initialized = false;
 	return SID_ERROR_NONE;
 }
@@ -482,9 +736,9 @@ sid_error_t sid_pal_crypto_hmac(sid_pal_hmac_params_t *params)
 	}
 
 	// NOTE: key_size is in bytes.
-	status = prepare_key(params->key, params->key_size, BYTE_TO_BITS(params->key_size),
-			     PSA_KEY_USAGE_SIGN_HASH, PSA_ALG_HMAC(alg_sha), PSA_KEY_TYPE_HMAC,
-			     &key_handle);
+	status = prepare_cached_key(params->key, params->key_size, BYTE_TO_BITS(params->key_size),
+				    PSA_KEY_USAGE_SIGN_HASH, PSA_ALG_HMAC(alg_sha),
+				    PSA_KEY_TYPE_HMAC, &key_handle);
 
 	if (PSA_SUCCESS == status) {
 		size_t hmac_length;
@@ -517,17 +771,7 @@ sid_error_t sid_pal_crypto_hmac(sid_pal_hmac_params_t *params)
 			}
 		}
 
-#ifdef CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE
-		if (!SID_CRYPTO_KEYS_ID_IS_SIDEWALK_KEY(key_handle)) {
-			if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
-				LOG_WRN("Destroy key failed!");
-			}
-		}
-#else
-		if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
-			LOG_WRN("Destroy key failed!");
-		}
-#endif /* CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE */
+		release_key(key_handle);
 	}
 
 	return get_error(status, __func__);
@@ -575,8 +819,9 @@ sid_error_t sid_pal_crypto_aes_crypt(sid_pal_aes_params_t *params)
 	}
 
 	// NOTE: key_size is in bits.
-	status = prepare_key(params->key, BITS_TO_BYTE(params->key_size), params->key_size,
-			     AES_MODE_TO_USAGE(params->mode), alg, PSA_KEY_TYPE_AES, &key_handle);
+	status = prepare_cached_key(params->key, BITS_TO_BYTE(params->key_size), params->key_size,
+				    AES_MODE_TO_USAGE(params->mode), alg, PSA_KEY_TYPE_AES,
+				    &key_handle);
 
 	if (PSA_SUCCESS == status) {
 		LOG_DBG("Key import success");
@@ -599,20 +844,11 @@ sid_error_t sid_pal_crypto_aes_crypt(sid_pal_aes_params_t *params)
 				(PSA_SUCCESS == status) ? "success." : "failed!");
 		} break;
 		default:
-			return SID_ERROR_INVALID_ARGS;
+			status = PSA_ERROR_INVALID_ARGUMENT;
+			break;
 		}
 
-#ifdef CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE
-		if (!SID_CRYPTO_KEYS_ID_IS_SIDEWALK_KEY(key_handle)) {
-			if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
-				LOG_WRN("Destroy key failed!");
-			}
-		}
-#else
-		if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
-			LOG_WRN("Destroy key failed!");
-		}
-#endif /* CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE */
+		release_key(key_handle);
 	}
 
 	return get_error(status, __func__);
@@ -662,8 +898,9 @@ sid_error_t sid_pal_crypto_aead_crypt(sid_pal_aead_params_t *params)
 	}
 
 	// NOTE: key_size is in bits.
-	status = prepare_key(params->key, BITS_TO_BYTE(params->key_size), params->key_size,
-			     AES_MODE_TO_USAGE(params->mode), alg, PSA_KEY_TYPE_AES, &key_handle);
+	status = prepare_cached_key(params->key, BITS_TO_BYTE(params->key_size), params->key_size,
+				    AES_MODE_TO_USAGE(params->mode), alg, PSA_KEY_TYPE_AES,
+				    &key_handle);
 
 	if (PSA_SUCCESS == status) {
 		LOG_DBG("Key import success.");
@@ -680,20 +917,11 @@ sid_error_t sid_pal_crypto_aead_crypt(sid_pal_aead_params_t *params)
 				(PSA_SUCCESS == status) ? "success." : "failed!");
 			break;
 		default:
-			return SID_ERROR_INVALID_ARGS;
+			status = PSA_ERROR_INVALID_ARGUMENT;
+			break;
 		}
 
-#ifdef CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE
-		if (!SID_CRYPTO_KEYS_ID_IS_SIDEWALK_KEY(key_handle)) {
-			if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
-				LOG_WRN("Destroy key failed!");
-			}
-		}
-#else
-		if (PSA_SUCCESS != psa_destroy_key(key_handle)) {
-			LOG_WRN("Destroy key failed!");
-		}
-#endif /* CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE */
+		release_key(key_handle);
 	}
 
 	return get_error(status, __func__);
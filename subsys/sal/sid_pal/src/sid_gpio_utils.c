@@ -253,3 +253,8 @@ int sid_gpio_utils_irq_set(uint32_t gpio_number, bool set)
 
 	return erc;
 }
+
+bool sid_gpio_utils_irq_context(void)
+{
+	return k_current_get() == &sidewalk_gpio_workq.thread;
+}
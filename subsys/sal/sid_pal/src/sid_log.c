@@ -9,8 +9,10 @@
  */
 
 #include <sid_pal_log_ifc.h>
+#include <sid_log_level.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <errno.h>
 
 #include <zephyr/sys/printk.h>
 #include <zephyr/logging/log.h>
@@ -22,19 +24,117 @@ LOG_MODULE_REGISTER(sidewalk, CONFIG_SIDEWALK_LOG_LEVEL);
 
 #define MSG_LENGTH_MAX (CONFIG_SIDEWALK_LOG_MSG_LENGTH_MAX)
 
-void sid_pal_log(sid_pal_log_severity_t severity, uint32_t num_args, const char *fmt, ...)
+#if CONFIG_SIDEWALK_LOG_RUNTIME_LEVEL
+struct log_source {
+	const char *name;
+	const char *const *modules;
+	size_t modules_cnt;
+};
+
+static const char *const stack_modules[] = { "sidewalk" };
+static const char *const radio_modules[] = { "semtech_busy", "sid_spi_bus", "sid_nrfx_spi_bus" };
+static const char *const security_modules[] = { "sid_crypto", "sid_crypto_key" };
+static const char *const ble_modules[] = {
+	"sid_ble", "sid_ble_advert", "sid_ble_adapter_callbacks", "sid_ble_conn", "sid_ble_lq",
+	"sid_ble_srv", "sid_ble_ama_srv", "sid_ble_vnd_srv", "sid_ble_log_srv",
+};
+
+static const struct log_source log_sources[SID_LOG_SOURCE_COUNT] = {
+	[SID_LOG_SOURCE_STACK] = { "stack", stack_modules, ARRAY_SIZE(stack_modules) },
+	[SID_LOG_SOURCE_RADIO] = { "radio", radio_modules, ARRAY_SIZE(radio_modules) },
+	[SID_LOG_SOURCE_SECURITY] = { "security", security_modules, ARRAY_SIZE(security_modules) },
+	[SID_LOG_SOURCE_BLE] = { "ble", ble_modules, ARRAY_SIZE(ble_modules) },
+};
+
+static uint8_t log_levels[SID_LOG_SOURCE_COUNT] = {
+	[SID_LOG_SOURCE_STACK] = CONFIG_SIDEWALK_LOG_LEVEL,
+	[SID_LOG_SOURCE_RADIO] = CONFIG_SIDEWALK_LOG_LEVEL,
+	[SID_LOG_SOURCE_SECURITY] = CONFIG_SIDEWALK_CRYPTO_LOG_LEVEL,
+	[SID_LOG_SOURCE_BLE] = CONFIG_SIDEWALK_BLE_ADAPTER_LOG_LEVEL,
+};
+
+int sid_log_level_set(enum sid_log_source source, uint8_t level)
 {
-	ARG_UNUSED(num_args);
+	int applied = -ENOENT;
 
-#if !defined(CONFIG_LOG)
-	ARG_UNUSED(severity);
-	ARG_UNUSED(fmt);
-	return;
-#endif /* !defined(CONFIG_LOG) */
+	if (source >= SID_LOG_SOURCE_COUNT || level > LOG_LEVEL_DBG) {
+		return -EINVAL;
+	}
 
-	va_list args;
-	va_start(args, fmt);
+	for (size_t i = 0; i < log_sources[source].modules_cnt; i++) {
+		int id = log_source_id_get(log_sources[source].modules[i]);
+
+		if (id < 0) {
+			continue;
+		}
+		applied = MAX(applied, (int)log_filter_set(NULL, Z_LOG_LOCAL_DOMAIN_ID, id, level));
+	}
+
+	if (applied >= 0) {
+		log_levels[source] = applied;
+	}
+
+	return applied;
+}
+
+uint8_t sid_log_level_get(enum sid_log_source source)
+{
+	return (source < SID_LOG_SOURCE_COUNT) ? log_levels[source] : LOG_LEVEL_NONE;
+}
+
+const char *sid_log_source_name(enum sid_log_source source)
+{
+	return (source < SID_LOG_SOURCE_COUNT) ? log_sources[source].name : NULL;
+}
+#endif /* CONFIG_SIDEWALK_LOG_RUNTIME_LEVEL */
+
+/*
+ * Checked before the message is formatted. Unknown severities are logged as debug.
+ */
+static inline bool log_severity_enabled(sid_pal_log_severity_t severity)
+{
+	severity = MIN(severity, SID_PAL_LOG_SEVERITY_DEBUG);
+#if CONFIG_SIDEWALK_LOG_RUNTIME_LEVEL
+	/* Zephyr log levels start at LOG_LEVEL_ERR = SID_PAL_LOG_SEVERITY_ERROR + 1 */
+	return severity < log_levels[SID_LOG_SOURCE_STACK];
+#elif defined(CONFIG_SIDEWALK_LOG_LEVEL)
+	return severity < CONFIG_SIDEWALK_LOG_LEVEL;
+#else
+	return false;
+#endif /* CONFIG_SIDEWALK_LOG_RUNTIME_LEVEL */
+}
+
+#if CONFIG_SIDEWALK_LOG_DEFERRED
+static uint8_t log_level_get(sid_pal_log_severity_t severity)
+{
+	switch (severity) {
+	case SID_PAL_LOG_SEVERITY_ERROR:
+		return LOG_LEVEL_ERR;
+	case SID_PAL_LOG_SEVERITY_WARNING:
+		return LOG_LEVEL_WRN;
+	case SID_PAL_LOG_SEVERITY_INFO:
+		return LOG_LEVEL_INF;
+	default:
+		return LOG_LEVEL_DBG;
+	}
+}
+
+/*
+ * The format pointer and the raw arguments are packaged into the log buffer, the message is
+ * formatted by the log thread. The format string tells the package the size of every
+ * argument, strings that are not in read-only memory are copied into it.
+ */
+static void log_deferred(sid_pal_log_severity_t severity, const char *fmt, va_list args)
+{
+	z_log_msg_runtime_vcreate(Z_LOG_LOCAL_DOMAIN_ID, (const void *)Z_LOG_CURRENT_DATA(),
+				  log_level_get(severity), NULL, 0, 0, fmt, args);
+}
+#endif /* CONFIG_SIDEWALK_LOG_DEFERRED */
 
+/* Not inlined, so the message buffer is not on the stack in the deferred mode */
+static __noinline void log_formatted(sid_pal_log_severity_t severity, const char *fmt,
+				     va_list args)
+{
 	char buf[MSG_LENGTH_MAX];
 	vsnprintf(buf, sizeof(buf), fmt, args);
 
@@ -56,6 +156,34 @@ void sid_pal_log(sid_pal_log_severity_t severity, uint32_t num_args, const char
 		LOG_WRN("sid pal log unknown severity %d", severity);
 		break;
 	}
+}
+
+void sid_pal_log(sid_pal_log_severity_t severity, uint32_t num_args, const char *fmt, ...)
+{
+	ARG_UNUSED(num_args);
+
+#if !defined(CONFIG_LOG)
+	ARG_UNUSED(severity);
+	ARG_UNUSED(fmt);
+	return;
+#endif /* !defined(CONFIG_LOG) */
+
+	if (!log_severity_enabled(severity)) {
+		return;
+	}
+
+	va_list args;
+	va_start(args, fmt);
+
+#if CONFIG_SIDEWALK_LOG_DEFERRED
+	if (severity <= SID_PAL_LOG_SEVERITY_DEBUG) {
+		log_deferred(severity, fmt, args);
+		va_end(args);
+		return;
+	}
+#endif /* CONFIG_SIDEWALK_LOG_DEFERRED */
+
+	log_formatted(severity, fmt, args);
 
 	va_end(args);
 }
@@ -107,5 +235,10 @@ bool sid_pal_log_get_log_buffer(struct sid_pal_log_buffer *const log_buffer)
 
 sid_pal_log_severity_t sid_log_control_get_current_log_level(void)
 {
+#if CONFIG_SIDEWALK_LOG_RUNTIME_LEVEL
+	/* Errors are always passed to sid_pal_log() and filtered there */
+	return (sid_pal_log_severity_t)MAX(log_levels[SID_LOG_SOURCE_STACK], LOG_LEVEL_ERR) - 1;
+#else
 	return (sid_pal_log_severity_t)SID_PAL_LOG_LEVEL;
+#endif /* CONFIG_SIDEWALK_LOG_RUNTIME_LEVEL */
 }
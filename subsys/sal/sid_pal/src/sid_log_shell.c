@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_log_shell.c
+ *  @brief Shell commands for the runtime log levels of the Sidewalk components.
+ */
+
+#include <sid_log_level.h>
+
+#include <zephyr/shell/shell.h>
+#include <zephyr/logging/log.h>
+
+#include <errno.h>
+#include <string.h>
+
+#define LOG_LEVEL_CMD_HELP                                                                         \
+	"Set log level of a Sidewalk component\n"                                                  \
+	"usage: sid_log level <stack|radio|security|ble|all> <none|err|wrn|inf|dbg>"
+
+static const char *const level_names[] = { "none", "err", "wrn", "inf", "dbg" };
+
+static int level_parse(const char *name)
+{
+	for (int i = 0; i < ARRAY_SIZE(level_names); i++) {
+		if (strcmp(name, level_names[i]) == 0) {
+			return i;
+		}
+	}
+
+	return -EINVAL;
+}
+
+static int source_parse(const char *name)
+{
+	for (int i = 0; i < SID_LOG_SOURCE_COUNT; i++) {
+		if (strcmp(name, sid_log_source_name(i)) == 0) {
+			return i;
+		}
+	}
+
+	return -EINVAL;
+}
+
+static void level_print(const struct shell *sh, enum sid_log_source source)
+{
+	shell_print(sh, "%-10s %s", sid_log_source_name(source),
+		    level_names[sid_log_level_get(source)]);
+}
+
+static int cmd_sid_log_levels(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (int i = 0; i < SID_LOG_SOURCE_COUNT; i++) {
+		level_print(sh, i);
+	}
+
+	return 0;
+}
+
+static int cmd_sid_log_level(const struct shell *sh, size_t argc, char **argv)
+{
+	bool all = (strcmp(argv[1], "all") == 0);
+	int source = all ? 0 : source_parse(argv[1]);
+	int level = level_parse(argv[2]);
+
+	if (source < 0 || level < 0) {
+		shell_help(sh);
+		return -EINVAL;
+	}
+
+	for (int i = source; i < (all ? SID_LOG_SOURCE_COUNT : source + 1); i++) {
+		int applied = sid_log_level_set(i, level);
+
+		if (applied < 0) {
+			shell_warn(sh, "%s: no log module built", sid_log_source_name(i));
+			continue;
+		}
+		if (applied != level) {
+			shell_warn(sh, "%s: limited to the compiled in level %s",
+				   sid_log_source_name(i), level_names[applied]);
+		}
+		level_print(sh, i);
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_sid_log,
+	SHELL_CMD_ARG(levels, NULL, "Print log levels of the Sidewalk components",
+		      cmd_sid_log_levels, 1, 0),
+	SHELL_CMD_ARG(level, NULL, LOG_LEVEL_CMD_HELP, cmd_sid_log_level, 3, 0),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(sid_log, &sub_sid_log, "Sidewalk log levels", NULL);
@@ -54,6 +54,9 @@ static int sid_mfg_storage_secure_read(uint16_t *p_value, uint8_t *buffer, uint1
 static const struct device *flash_dev;
 static uint32_t sid_mfg_version = INVALID_VERSION;
 tlv_ctx tlv_flash;
+#if CONFIG_SIDEWALK_TLV_INDEX
+static tlv_index tlv_flash_index;
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
 
 void sid_pal_mfg_store_init(sid_pal_mfg_store_region_t mfg_store_region)
 {
@@ -74,6 +77,10 @@ void sid_pal_mfg_store_init(sid_pal_mfg_store_region_t mfg_store_region)
 			       .start_offset = mfg_store_region.addr_start,
 			       .end_offset = mfg_store_region.addr_end,
 			       .tlv_storage_start_marker_size = sizeof(struct mfg_header) };
+#if CONFIG_SIDEWALK_TLV_INDEX
+	tlv_flash.index = &tlv_flash_index;
+	tlv_index_invalidate(&tlv_flash);
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
 
 #if CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE
 	err = sid_crypto_keys_init();
@@ -155,6 +162,13 @@ void sid_pal_mfg_store_init(sid_pal_mfg_store_region_t mfg_store_region)
 		sid_mfg_version = SID_PAL_MFG_STORE_TLV_VERSION;
 	}
 
+#if CONFIG_SIDEWALK_TLV_INDEX
+	err = tlv_index_build(&tlv_flash);
+	if (err) {
+		LOG_WRN("Failed to build mfg index errno %d", err);
+	}
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
+
 #if defined(CONFIG_FPROTECT) && !defined(CONFIG_SIDEWALK_MFG_STORAGE_DIAGNOSTIC)
 	err = fprotect_area(PM_MFG_STORAGE_ADDRESS, PM_MFG_STORAGE_SIZE);
 	if (err) {
@@ -223,6 +237,9 @@ int32_t sid_pal_mfg_store_erase(void)
 {
 #if CONFIG_SIDEWALK_MFG_STORAGE_DIAGNOSTIC
 	const size_t mfg_size = tlv_flash.end_offset - tlv_flash.start_offset;
+#if CONFIG_SIDEWALK_TLV_INDEX
+	tlv_index_invalidate(&tlv_flash);
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
 	return tlv_flash.storage_impl.erase(tlv_flash.storage_impl.ctx, tlv_flash.start_offset,
 					    mfg_size);
 #else
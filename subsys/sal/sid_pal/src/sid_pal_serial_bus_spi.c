@@ -8,6 +8,7 @@
 #include <zephyr/pm/device.h>
 #include <zephyr/drivers/spi.h>
 #include <zephyr/devicetree.h>
+#include <zephyr/sys/atomic.h>
 
 #include <sid_pal_serial_bus_ifc.h>
 #include <sid_pal_gpio_ifc.h>
@@ -21,20 +22,52 @@ LOG_MODULE_REGISTER(sid_spi_bus, CONFIG_SPI_BUS_LOG_LEVEL);
 #define SPI_OPTIONS                                                                                \
 	(uint16_t)(SPI_WORD_SET(8) | SPI_TRANSFER_MSB | SPI_OP_MODE_MASTER | SPI_FULL_DUPLEX)
 
+/* Radio drivers send at most: command, data and status segments */
+#define SPI_SG_MAX_BUFS 4
+
+#if CONFIG_SIDEWALK_SPI_BUS_ASYNC
+struct bus_serial_async_t {
+	/* Buffers are used by the driver until the transfer is finished */
+	struct spi_buf tx_buff[SPI_SG_MAX_BUFS];
+	struct spi_buf rx_buff[SPI_SG_MAX_BUFS];
+	struct spi_buf_set tx_set;
+	struct spi_buf_set rx_set;
+	sid_pal_serial_bus_xfer_done_t done;
+	void *context;
+	atomic_t busy;
+};
+#endif /* CONFIG_SIDEWALK_SPI_BUS_ASYNC */
+
 struct bus_serial_ctx_t {
 	const struct sid_pal_serial_bus_iface *iface;
 	const struct device *device;
 	struct spi_config cfg;
+#if CONFIG_SIDEWALK_SPI_BUS_ASYNC
+	struct bus_serial_async_t async;
+#endif /* CONFIG_SIDEWALK_SPI_BUS_ASYNC */
 };
 
 static sid_error_t bus_serial_spi_xfer(const struct sid_pal_serial_bus_iface *iface,
 				       const struct sid_pal_serial_bus_client *client, uint8_t *tx,
 				       uint8_t *rx, size_t xfer_size);
 static sid_error_t bus_serial_spi_destroy(const struct sid_pal_serial_bus_iface *iface);
+static sid_error_t bus_serial_spi_xfer_sg(const struct sid_pal_serial_bus_iface *iface,
+					  const struct sid_pal_serial_bus_client *client,
+					  const struct sid_pal_serial_bus_buf *bufs, size_t count);
+#if CONFIG_SIDEWALK_SPI_BUS_ASYNC
+static sid_error_t bus_serial_spi_xfer_async(const struct sid_pal_serial_bus_iface *iface,
+					     const struct sid_pal_serial_bus_client *client,
+					     const struct sid_pal_serial_bus_buf *bufs, size_t count,
+					     sid_pal_serial_bus_xfer_done_t done, void *context);
+#endif /* CONFIG_SIDEWALK_SPI_BUS_ASYNC */
 
 static const struct sid_pal_serial_bus_iface bus_ops = {
 	.xfer = bus_serial_spi_xfer,
 	.destroy = bus_serial_spi_destroy,
+	.xfer_sg = bus_serial_spi_xfer_sg,
+#if CONFIG_SIDEWALK_SPI_BUS_ASYNC
+	.xfer_async = bus_serial_spi_xfer_async,
+#endif /* CONFIG_SIDEWALK_SPI_BUS_ASYNC */
 };
 
 static struct bus_serial_ctx_t bus_serial_ctx = {
@@ -85,6 +118,108 @@ static sid_error_t bus_serial_spi_xfer(const struct sid_pal_serial_bus_iface *if
 	return ret;
 }
 
+/* spi_buf with NULL buf sends the overrun character or skips the received data */
+static void bus_serial_spi_bufs_set(const struct sid_pal_serial_bus_buf *bufs, size_t count,
+				    struct spi_buf *tx_buff, struct spi_buf *rx_buff)
+{
+	for (size_t i = 0; i < count; i++) {
+		tx_buff[i] = (struct spi_buf){ .buf = (void *)bufs[i].tx, .len = bufs[i].len };
+		rx_buff[i] = (struct spi_buf){ .buf = bufs[i].rx, .len = bufs[i].len };
+	}
+}
+
+static sid_error_t bus_serial_spi_xfer_sg(const struct sid_pal_serial_bus_iface *iface,
+					  const struct sid_pal_serial_bus_client *client,
+					  const struct sid_pal_serial_bus_buf *bufs, size_t count)
+{
+	LOG_DBG("%s(%p, %p, %p, %d)", __func__, iface, client, (void *)bufs, count);
+
+	if (iface != bus_serial_ctx.iface || !bufs || !count || count > SPI_SG_MAX_BUFS ||
+	    !client) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
+	struct spi_buf tx_buff[SPI_SG_MAX_BUFS];
+	struct spi_buf rx_buff[SPI_SG_MAX_BUFS];
+
+	bus_serial_spi_bufs_set(bufs, count, tx_buff, rx_buff);
+
+	struct spi_buf_set tx_set = { .buffers = tx_buff, .count = count };
+	struct spi_buf_set rx_set = { .buffers = rx_buff, .count = count };
+
+	int err = spi_transceive(bus_serial_ctx.device, &bus_serial_ctx.cfg, &tx_set, &rx_set);
+
+	if (err < 0) {
+		LOG_ERR("spi xfer sg err %d", err);
+		return SID_ERROR_GENERIC;
+	}
+
+	return SID_ERROR_NONE;
+}
+
+#if CONFIG_SIDEWALK_SPI_BUS_ASYNC
+static void bus_serial_spi_async_done(const struct device *dev, int result, void *data)
+{
+	struct bus_serial_async_t *async = data;
+	sid_pal_serial_bus_xfer_done_t done = async->done;
+	void *context = async->context;
+
+	ARG_UNUSED(dev);
+
+	if (result < 0) {
+		LOG_ERR("spi xfer async err %d", result);
+	}
+
+	/* Released before the callback, so a thread woken by it can start the next transfer */
+	atomic_clear(&async->busy);
+	done((result < 0) ? SID_ERROR_GENERIC : SID_ERROR_NONE, context);
+}
+
+static sid_error_t bus_serial_spi_xfer_async(const struct sid_pal_serial_bus_iface *iface,
+					     const struct sid_pal_serial_bus_client *client,
+					     const struct sid_pal_serial_bus_buf *bufs, size_t count,
+					     sid_pal_serial_bus_xfer_done_t done, void *context)
+{
+	LOG_DBG("%s(%p, %p, %p, %d)", __func__, iface, client, (void *)bufs, count);
+
+	struct bus_serial_async_t *async = &bus_serial_ctx.async;
+
+	if (iface != bus_serial_ctx.iface || !bufs || !count || count > SPI_SG_MAX_BUFS ||
+	    !client || !done) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
+	if (!atomic_cas(&async->busy, 0, 1)) {
+		return SID_ERROR_BUSY;
+	}
+
+	bus_serial_spi_bufs_set(bufs, count, async->tx_buff, async->rx_buff);
+	async->tx_set = (struct spi_buf_set){ .buffers = async->tx_buff, .count = count };
+	async->rx_set = (struct spi_buf_set){ .buffers = async->rx_buff, .count = count };
+	async->done = done;
+	async->context = context;
+
+	int err = spi_transceive_cb(bus_serial_ctx.device, &bus_serial_ctx.cfg, &async->tx_set,
+				    &async->rx_set, bus_serial_spi_async_done, async);
+
+	if (err == -ENOTSUP) {
+		/* The SPI driver has no asynchronous API, finish the transfer here */
+		err = spi_transceive(bus_serial_ctx.device, &bus_serial_ctx.cfg, &async->tx_set,
+				     &async->rx_set);
+		bus_serial_spi_async_done(bus_serial_ctx.device, err, async);
+		return SID_ERROR_NONE;
+	}
+
+	if (err < 0) {
+		LOG_ERR("spi xfer async start err %d", err);
+		atomic_clear(&async->busy);
+		return SID_ERROR_GENERIC;
+	}
+
+	return SID_ERROR_NONE;
+}
+#endif /* CONFIG_SIDEWALK_SPI_BUS_ASYNC */
+
 static sid_error_t bus_serial_spi_destroy(const struct sid_pal_serial_bus_iface *iface)
 {
 	LOG_DBG("%s(%p)", __func__, iface);
@@ -25,6 +25,10 @@
 
 #include <zephyr/logging/log.h>
 #include <settings_utils.h>
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+#include <sid_storage_cache.h>
+#include <string.h>
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
 
 LOG_MODULE_REGISTER(sid_storage, CONFIG_SIDEWALK_LOG_LEVEL);
 
@@ -41,6 +45,349 @@ static void settings_serialize_group_key(char *serial, size_t serial_size, uint1
 	snprintf(serial, serial_size, "sidewalk/storage/%04x/%04x", group, key);
 }
 
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+/*
+ * Write-back cache of storage records. Entries hold the record value, or remember the
+ * record does not exist. Dirty entries differ from the settings backend and are written
+ * by the flush, which runs CONFIG_SIDEWALK_STORAGE_CACHE_FLUSH_INTERVAL_MS after the first
+ * write, on sid_storage_cache_flush() and when a dirty entry has to be evicted.
+ * Records larger than CONFIG_SIDEWALK_STORAGE_CACHE_DATA_SIZE are not cached.
+ */
+#define CACHE_PRESENT BIT(0)
+#define CACHE_DIRTY BIT(1)
+
+struct storage_cache_entry {
+	uint32_t last_use;
+	uint16_t group;
+	uint16_t key;
+	uint16_t len;
+	uint8_t flags;
+	bool valid;
+	uint8_t data[CONFIG_SIDEWALK_STORAGE_CACHE_DATA_SIZE];
+};
+
+struct storage_cache_load {
+	struct storage_cache_entry *entry;
+	bool found;
+	bool too_large;
+};
+
+static struct storage_cache_entry storage_cache[CONFIG_SIDEWALK_STORAGE_CACHE_ENTRIES];
+static struct sid_storage_cache_stats storage_cache_stats;
+static uint32_t storage_cache_use;
+
+K_MUTEX_DEFINE(storage_cache_mutex);
+
+static void storage_cache_flush_work_handler(struct k_work *work);
+K_WORK_DELAYABLE_DEFINE(storage_cache_flush_work, storage_cache_flush_work_handler);
+
+static int storage_cache_entry_write(struct storage_cache_entry *entry)
+{
+	char serial[STORAGE_SERIAL_SIZE] = { 0 };
+	int rc;
+
+	settings_serialize_group_key(serial, sizeof(serial), entry->group, entry->key);
+	if (entry->flags & CACHE_PRESENT) {
+		rc = settings_save_one(serial, entry->data, entry->len);
+	} else {
+		rc = settings_delete(serial);
+	}
+	if (rc) {
+		LOG_ERR("Failed to write record (%s). Returned errno %d", serial, rc);
+		return rc;
+	}
+
+	entry->flags &= ~CACHE_DIRTY;
+	storage_cache_stats.backend_writes++;
+	return 0;
+}
+
+/* Call with storage_cache_mutex locked */
+static int storage_cache_flush_locked(void)
+{
+	int err = 0;
+	bool written = false;
+
+	for (size_t i = 0; i < ARRAY_SIZE(storage_cache); i++) {
+		struct storage_cache_entry *entry = &storage_cache[i];
+
+		if (!entry->valid || !(entry->flags & CACHE_DIRTY)) {
+			continue;
+		}
+
+		int rc = storage_cache_entry_write(entry);
+
+		if (rc) {
+			err = err ? err : rc;
+			continue;
+		}
+		written = true;
+	}
+
+	if (!written) {
+		return err;
+	}
+
+	storage_cache_stats.flushes++;
+	int rc = settings_commit();
+
+	if (rc) {
+		LOG_ERR("Failed to commit changes. Returned errno %d", rc);
+		err = err ? err : rc;
+	}
+
+	return err;
+}
+
+static void storage_cache_flush_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&storage_cache_mutex, K_FOREVER);
+	(void)storage_cache_flush_locked();
+	k_mutex_unlock(&storage_cache_mutex);
+}
+
+static void storage_cache_flush_schedule(void)
+{
+	if (CONFIG_SIDEWALK_STORAGE_CACHE_FLUSH_INTERVAL_MS > 0) {
+		/* Keeps the earlier deadline if already scheduled */
+		k_work_schedule(&storage_cache_flush_work,
+				K_MSEC(CONFIG_SIDEWALK_STORAGE_CACHE_FLUSH_INTERVAL_MS));
+	}
+}
+
+static struct storage_cache_entry *storage_cache_find(uint16_t group, uint16_t key)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(storage_cache); i++) {
+		struct storage_cache_entry *entry = &storage_cache[i];
+
+		if (entry->valid && entry->group == group && entry->key == key) {
+			entry->last_use = ++storage_cache_use;
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Returns the least recently used clean entry, flushes the cache if all entries are dirty */
+static struct storage_cache_entry *storage_cache_alloc(uint16_t group, uint16_t key)
+{
+	struct storage_cache_entry *victim = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(storage_cache) && !victim; i++) {
+		if (!storage_cache[i].valid) {
+			victim = &storage_cache[i];
+		}
+	}
+
+	for (int pass = 0; pass < 2 && !victim; pass++) {
+		for (size_t i = 0; i < ARRAY_SIZE(storage_cache); i++) {
+			struct storage_cache_entry *entry = &storage_cache[i];
+
+			if (entry->flags & CACHE_DIRTY) {
+				continue;
+			}
+			if (!victim || (int32_t)(entry->last_use - victim->last_use) < 0) {
+				victim = entry;
+			}
+		}
+		if (!victim && storage_cache_flush_locked()) {
+			return NULL;
+		}
+	}
+
+	if (victim) {
+		*victim = (struct storage_cache_entry){
+			.last_use = ++storage_cache_use,
+			.group = group,
+			.key = key,
+			.valid = true,
+		};
+	}
+
+	return victim;
+}
+
+static int storage_cache_load_cb(const char *name, size_t len, settings_read_cb read_cb,
+				 void *cb_arg, void *param)
+{
+	struct storage_cache_load *load = (struct storage_cache_load *)param;
+	const char *next;
+
+	if (settings_name_next(name, &next) != 0) {
+		return 0;
+	}
+	if (len > sizeof(load->entry->data)) {
+		load->too_large = true;
+		return 0;
+	}
+
+	ssize_t rc = read_cb(cb_arg, load->entry->data, len);
+
+	if (rc < 0) {
+		return rc;
+	}
+	load->entry->len = rc;
+	load->found = rc > 0;
+	return 0;
+}
+
+/* Returns the entry of the record, loaded from the backend if needed, or NULL if not cacheable */
+static struct storage_cache_entry *storage_cache_lookup(uint16_t group, uint16_t key)
+{
+	struct storage_cache_entry *entry = storage_cache_find(group, key);
+
+	if (entry) {
+		storage_cache_stats.read_hits++;
+		return entry;
+	}
+
+	storage_cache_stats.read_misses++;
+	entry = storage_cache_alloc(group, key);
+	if (!entry) {
+		return NULL;
+	}
+
+	char serial[STORAGE_SERIAL_SIZE] = { 0 };
+	struct storage_cache_load load = { .entry = entry };
+
+	settings_serialize_group_key(serial, sizeof(serial), group, key);
+	int rc = settings_load_subtree_direct(serial, storage_cache_load_cb, &load);
+
+	if (rc || load.too_large) {
+		entry->valid = false;
+		return NULL;
+	}
+	if (load.found) {
+		entry->flags |= CACHE_PRESENT;
+	}
+
+	return entry;
+}
+
+static bool storage_cache_get(uint16_t group, uint16_t key, void *p_data, uint32_t len,
+			      sid_error_t *result)
+{
+	k_mutex_lock(&storage_cache_mutex, K_FOREVER);
+
+	struct storage_cache_entry *entry = storage_cache_lookup(group, key);
+
+	if (entry) {
+		if (entry->flags & CACHE_PRESENT) {
+			memcpy(p_data, entry->data, MIN(len, entry->len));
+			*result = SID_ERROR_NONE;
+		} else {
+			*result = SID_ERROR_NOT_FOUND;
+		}
+	}
+
+	k_mutex_unlock(&storage_cache_mutex);
+	return entry != NULL;
+}
+
+static bool storage_cache_get_len(uint16_t group, uint16_t key, uint32_t *p_len,
+				  sid_error_t *result)
+{
+	k_mutex_lock(&storage_cache_mutex, K_FOREVER);
+
+	struct storage_cache_entry *entry = storage_cache_lookup(group, key);
+
+	if (entry) {
+		*p_len = (entry->flags & CACHE_PRESENT) ? entry->len : 0;
+		*result = (entry->flags & CACHE_PRESENT) ? SID_ERROR_NONE : SID_ERROR_NOT_FOUND;
+	}
+
+	k_mutex_unlock(&storage_cache_mutex);
+	return entry != NULL;
+}
+
+/* Store the value, or delete the record if p_data is NULL */
+static bool storage_cache_set(uint16_t group, uint16_t key, void const *p_data, uint32_t len,
+			      sid_error_t *result)
+{
+	k_mutex_lock(&storage_cache_mutex, K_FOREVER);
+
+	struct storage_cache_entry *entry = storage_cache_find(group, key);
+
+	storage_cache_stats.writes++;
+	if (len > sizeof(entry->data)) {
+		/* Written through, the cached value is outdated */
+		if (entry) {
+			entry->valid = false;
+		}
+		k_mutex_unlock(&storage_cache_mutex);
+		return false;
+	}
+
+	if (entry) {
+		bool present = entry->flags & CACHE_PRESENT;
+		bool same = p_data ? (present && entry->len == len &&
+				      !memcmp(entry->data, p_data, len)) :
+				     !present;
+
+		if (same || (entry->flags & CACHE_DIRTY)) {
+			storage_cache_stats.writes_coalesced++;
+		}
+		if (same) {
+			*result = SID_ERROR_NONE;
+			k_mutex_unlock(&storage_cache_mutex);
+			return true;
+		}
+	} else {
+		entry = storage_cache_alloc(group, key);
+	}
+
+	if (!entry) {
+		k_mutex_unlock(&storage_cache_mutex);
+		return false;
+	}
+
+	if (p_data) {
+		memcpy(entry->data, p_data, len);
+		entry->len = len;
+		entry->flags = CACHE_PRESENT | CACHE_DIRTY;
+	} else {
+		entry->len = 0;
+		entry->flags = CACHE_DIRTY;
+	}
+	storage_cache_flush_schedule();
+	*result = SID_ERROR_NONE;
+
+	k_mutex_unlock(&storage_cache_mutex);
+	return true;
+}
+
+/* Pending writes to the group are dropped, its records will be deleted from the backend */
+static void storage_cache_group_invalidate(uint16_t group)
+{
+	k_mutex_lock(&storage_cache_mutex, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(storage_cache); i++) {
+		if (storage_cache[i].group == group) {
+			storage_cache[i].valid = false;
+		}
+	}
+	k_mutex_unlock(&storage_cache_mutex);
+}
+
+int sid_storage_cache_flush(void)
+{
+	k_mutex_lock(&storage_cache_mutex, K_FOREVER);
+	int err = storage_cache_flush_locked();
+	k_mutex_unlock(&storage_cache_mutex);
+
+	return err;
+}
+
+void sid_storage_cache_stats_get(struct sid_storage_cache_stats *stats)
+{
+	k_mutex_lock(&storage_cache_mutex, K_FOREVER);
+	*stats = storage_cache_stats;
+	k_mutex_unlock(&storage_cache_mutex);
+}
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
 #ifdef CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE
 static psa_key_id_t storage2key_id(uint16_t group, uint16_t key)
 {
@@ -133,6 +480,18 @@ sid_error_t sid_pal_storage_kv_init()
 	return SID_ERROR_NONE;
 }
 
+sid_error_t sid_pal_storage_kv_deinit(void)
+{
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	(void)k_work_cancel_delayable(&storage_cache_flush_work);
+	if (sid_storage_cache_flush()) {
+		return SID_ERROR_STORAGE_WRITE_FAIL;
+	}
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
+	return SID_ERROR_NONE;
+}
+
 sid_error_t sid_pal_storage_kv_record_get(uint16_t group, uint16_t key, void *p_data, uint32_t len)
 {
 	if (!p_data) {
@@ -151,6 +510,13 @@ sid_error_t sid_pal_storage_kv_record_get(uint16_t group, uint16_t key, void *p_
 	}
 #endif /* CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE */
 
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	sid_error_t result;
+	if (storage_cache_get(group, key, p_data, len, &result)) {
+		return result;
+	}
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
 	char serial[STORAGE_SERIAL_SIZE] = { 0 };
 	settings_serialize_group_key(serial, sizeof(serial), group, key);
 	int rc = settings_utils_load_immediate_value(serial, p_data, len);
@@ -165,6 +531,13 @@ sid_error_t sid_pal_storage_kv_record_get_len(uint16_t group, uint16_t key, uint
 	if (!p_len) {
 		return SID_ERROR_NULL_POINTER;
 	}
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	sid_error_t result;
+	if (storage_cache_get_len(group, key, p_len, &result)) {
+		return result;
+	}
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
 	char serial[STORAGE_SERIAL_SIZE] = { 0 };
 	settings_serialize_group_key(serial, sizeof(serial), group, key);
 	int rc = settings_utils_get_value_size(serial, p_len);
@@ -200,6 +573,13 @@ sid_error_t sid_pal_storage_kv_record_set(uint16_t group, uint16_t key, void con
 	}
 #endif /* CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE */
 
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	sid_error_t result;
+	if (storage_cache_set(group, key, p_data, len, &result)) {
+		return result;
+	}
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
 	char serial[STORAGE_SERIAL_SIZE] = { 0 };
 	settings_serialize_group_key(serial, sizeof(serial), group, key);
 
@@ -227,6 +607,13 @@ sid_error_t sid_pal_storage_kv_record_delete(uint16_t group, uint16_t key)
 	}
 #endif /* CONFIG_SIDEWALK_CRYPTO_PSA_KEY_STORAGE */
 
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	sid_error_t result;
+	if (storage_cache_set(group, key, NULL, 0, &result)) {
+		return result;
+	}
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
 	char serial[STORAGE_SERIAL_SIZE] = { 0 };
 	settings_serialize_group_key(serial, sizeof(serial), group, key);
 	int rc = settings_delete(serial);
@@ -253,6 +640,10 @@ int delete_subtree_cb(const char *key, size_t len, settings_read_cb read_cb, voi
 
 sid_error_t sid_pal_storage_kv_group_delete(uint16_t group)
 {
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	storage_cache_group_invalidate(group);
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
 	char serial[STORAGE_SERIAL_SIZE] = { 0 };
 	settings_serialize_group(serial, sizeof(serial), group);
 	int rc = settings_load_subtree_direct(serial, delete_subtree_cb, (void *)serial);
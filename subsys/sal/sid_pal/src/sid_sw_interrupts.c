@@ -9,7 +9,10 @@
  */
 
 #include <sid_pal_swi_ifc.h>
+#include <sid_sw_interrupts.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <string.h>
 
 #ifndef CONFIG_SIDEWALK_SWI_PRIORITY
 #error "CONFIG_SIDEWALK_SWI_PRIORITY must be defined"
@@ -21,9 +24,116 @@
 
 static K_SEM_DEFINE(swi_trigger_sem, 0, 1);
 
-static sid_pal_swi_cb_t swi_cb;
+/* Bit per channel, set from the first trigger until the callback is called */
+static atomic_t swi_pending = ATOMIC_INIT(0);
+static sid_pal_swi_cb_t swi_cb[SID_SWI_CHANNEL_COUNT];
 static bool is_init = false;
 
+static const char *const channel_names[SID_SWI_CHANNEL_COUNT] = {
+	[SID_SWI_CHANNEL_RADIO] = "radio",
+	[SID_SWI_CHANNEL_NORMAL] = "normal",
+};
+
+#if CONFIG_SIDEWALK_SWI_LATENCY_STATS
+/* Time of the first trigger of a pending channel */
+static uint32_t trigger_cycles[SID_SWI_CHANNEL_COUNT];
+static struct sid_swi_latency latency_stats[SID_SWI_CHANNEL_COUNT];
+static struct k_spinlock latency_lock;
+
+static void latency_record(enum sid_swi_channel channel, uint32_t cycles)
+{
+	uint32_t us = k_cyc_to_us_floor32(cycles);
+	size_t bucket = us ? MIN(32 - __builtin_clz(us), SID_SWI_LATENCY_BUCKETS - 1) : 0;
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	latency_stats[channel].count++;
+	latency_stats[channel].max_us = MAX(latency_stats[channel].max_us, us);
+	latency_stats[channel].buckets[bucket]++;
+
+	k_spin_unlock(&latency_lock, key);
+}
+
+sid_error_t sid_swi_latency_get(enum sid_swi_channel channel, struct sid_swi_latency *latency)
+{
+	if (channel >= SID_SWI_CHANNEL_COUNT || !latency) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	*latency = latency_stats[channel];
+
+	k_spin_unlock(&latency_lock, key);
+	return SID_ERROR_NONE;
+}
+
+void sid_swi_latency_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	memset(latency_stats, 0, sizeof(latency_stats));
+
+	k_spin_unlock(&latency_lock, key);
+}
+#endif /* CONFIG_SIDEWALK_SWI_LATENCY_STATS */
+
+sid_error_t sid_swi_channel_start(enum sid_swi_channel channel, sid_pal_swi_cb_t event_callback)
+{
+	if (!event_callback) {
+		return SID_ERROR_NULL_POINTER;
+	}
+	if (channel >= SID_SWI_CHANNEL_COUNT) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+	swi_cb[channel] = event_callback;
+
+	return SID_ERROR_NONE;
+}
+
+sid_error_t sid_swi_channel_stop(enum sid_swi_channel channel)
+{
+	if (channel >= SID_SWI_CHANNEL_COUNT) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+	swi_cb[channel] = NULL;
+	atomic_clear_bit(&swi_pending, channel);
+
+	return SID_ERROR_NONE;
+}
+
+sid_error_t sid_swi_channel_trigger(enum sid_swi_channel channel)
+{
+	if (channel >= SID_SWI_CHANNEL_COUNT) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+	if (!is_init || !swi_cb[channel]) {
+		return SID_ERROR_INVALID_STATE;
+	}
+
+#if CONFIG_SIDEWALK_SWI_LATENCY_STATS
+	uint32_t now = k_cycle_get_32();
+#endif /* CONFIG_SIDEWALK_SWI_LATENCY_STATS */
+
+	/* Later triggers of a pending channel are served by the same call */
+	if (!atomic_test_and_set_bit(&swi_pending, channel)) {
+#if CONFIG_SIDEWALK_SWI_LATENCY_STATS
+		trigger_cycles[channel] = now;
+#endif /* CONFIG_SIDEWALK_SWI_LATENCY_STATS */
+		k_sem_give(&swi_trigger_sem);
+	}
+
+	return SID_ERROR_NONE;
+}
+
+const char *sid_swi_channel_name(enum sid_swi_channel channel)
+{
+	if (channel >= SID_SWI_CHANNEL_COUNT) {
+		return NULL;
+	}
+
+	return channel_names[channel];
+}
+
 sid_error_t sid_pal_swi_init(void)
 {
 	if (is_init) {
@@ -45,28 +155,17 @@ sid_error_t sid_pal_swi_deinit(void)
 
 sid_error_t sid_pal_swi_start(sid_pal_swi_cb_t event_callback)
 {
-	if (!event_callback) {
-		return SID_ERROR_NULL_POINTER;
-	}
-	swi_cb = event_callback;
-
-	return SID_ERROR_NONE;
+	return sid_swi_channel_start(SID_SWI_CHANNEL_RADIO, event_callback);
 }
 
 sid_error_t sid_pal_swi_stop(void)
 {
-	swi_cb = NULL;
-	return SID_ERROR_NONE;
+	return sid_swi_channel_stop(SID_SWI_CHANNEL_RADIO);
 }
 
 sid_error_t sid_pal_swi_trigger(void)
 {
-	if (!(is_init && swi_cb)) {
-		return SID_ERROR_INVALID_STATE;
-	}
-
-	k_sem_give(&swi_trigger_sem);
-	return SID_ERROR_NONE;
+	return sid_swi_channel_trigger(SID_SWI_CHANNEL_RADIO);
 }
 
 static void swi_task(void *arg1, void *arg2, void *arg3)
@@ -77,8 +176,26 @@ static void swi_task(void *arg1, void *arg2, void *arg3)
 
 	while (1) {
 		k_sem_take(&swi_trigger_sem, K_FOREVER);
-		if (swi_cb) {
-			swi_cb();
+
+		atomic_val_t pending;
+
+		/* Pending channels are checked again after every callback, the highest priority first */
+		while ((pending = atomic_get(&swi_pending)) != 0) {
+			enum sid_swi_channel channel = find_lsb_set(pending) - 1;
+#if CONFIG_SIDEWALK_SWI_LATENCY_STATS
+			uint32_t triggered = trigger_cycles[channel];
+#endif /* CONFIG_SIDEWALK_SWI_LATENCY_STATS */
+
+			atomic_clear_bit(&swi_pending, channel);
+
+			sid_pal_swi_cb_t cb = swi_cb[channel];
+
+			if (cb) {
+#if CONFIG_SIDEWALK_SWI_LATENCY_STATS
+				latency_record(channel, k_cycle_get_32() - triggered);
+#endif /* CONFIG_SIDEWALK_SWI_LATENCY_STATS */
+				cb();
+			}
 		}
 	}
 }
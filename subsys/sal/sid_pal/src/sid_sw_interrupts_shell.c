@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_sw_interrupts_shell.c
+ *  @brief Shell commands for the latency of the Sidewalk software interrupt channels.
+ */
+
+#include <sid_sw_interrupts.h>
+
+#include <zephyr/shell/shell.h>
+
+static void latency_print(const struct shell *sh, enum sid_swi_channel channel)
+{
+	struct sid_swi_latency latency;
+
+	if (sid_swi_latency_get(channel, &latency) != SID_ERROR_NONE) {
+		return;
+	}
+
+	shell_print(sh, "%s: %u runs, max %u us", sid_swi_channel_name(channel), latency.count,
+		    latency.max_us);
+	for (int i = 0; i < SID_SWI_LATENCY_BUCKETS; i++) {
+		if (!latency.buckets[i]) {
+			continue;
+		}
+		if (i == 0) {
+			shell_print(sh, "  %12s %10u", "< 1 us", latency.buckets[i]);
+		} else if (i == SID_SWI_LATENCY_BUCKETS - 1) {
+			shell_print(sh, "  >= %6u us %10u", (uint32_t)BIT(i - 1), latency.buckets[i]);
+		} else {
+			shell_print(sh, "  %5u-%-5u us %10u", (uint32_t)BIT(i - 1), (uint32_t)BIT(i),
+				    latency.buckets[i]);
+		}
+	}
+}
+
+static int cmd_sid_swi_latency(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (int i = 0; i < SID_SWI_CHANNEL_COUNT; i++) {
+		latency_print(sh, i);
+	}
+
+	return 0;
+}
+
+static int cmd_sid_swi_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sid_swi_latency_reset();
+	shell_print(sh, "Latency histograms cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_sid_swi,
+	SHELL_CMD_ARG(latency, NULL, "Print trigger to run latency of the SWI channels",
+		      cmd_sid_swi_latency, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Clear the latency histograms", cmd_sid_swi_reset, 1, 0),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(sid_swi, &sub_sid_swi, "Sidewalk software interrupts", NULL);
@@ -11,10 +11,14 @@
 #include <sid_pal_timer_ifc.h>
 #include <sid_pal_uptime_ifc.h>
 #include <sid_pal_assert_ifc.h>
-#include <sid_pal_critical_region_ifc.h>
 #include <sid_time_ops.h>
+#include <sid_timer_queue.h>
+#include <sid_critical_section.h>
 #include <stdint.h>
 #include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(sid_timer, CONFIG_SIDEWALK_LOG_LEVEL);
 
 #ifdef CONFIG_SIDEWALK_THREAD_TIMER
 #ifndef CONFIG_SIDEWALK_TIMER_PRIORITY
@@ -28,16 +32,18 @@
 static K_SEM_DEFINE(timer_trigger_sem, 0, 1);
 #endif /* CONFIG_SIDEWALK_THREAD_TIMER */
 
-struct sid_pal_timer_ctx {
-	sys_dlist_t list;
-};
+/* Protects the timer queue and the hardware timer, the rest of Sidewalk is not blocked */
+static SID_CRITICAL_SECTION_DEFINE(timer_section, "timer");
 
 static const struct sid_timespec tolerance_lowpower = { .tv_sec = 1, .tv_nsec = 0 };
 static const struct sid_timespec tolerance_precise = { .tv_sec = 0, .tv_nsec = 0 };
 
-static struct sid_pal_timer_ctx sid_pal_timer_ctx = {
-	.list = SYS_DLIST_STATIC_INIT(&sid_pal_timer_ctx.list),
-};
+#if CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY
+/* Due timers detached from the queue, waiting for their callback */
+static sys_dlist_t expired_list = SYS_DLIST_STATIC_INIT(&expired_list);
+/* Alarm the hardware timer was last started for */
+static struct sid_timespec scheduled_alarm = { .tv_sec = UINT32_MAX, .tv_nsec = UINT32_MAX };
+#endif /* CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY */
 
 static void sid_timer_start(const struct sid_timespec *sid_time);
 
@@ -60,95 +66,91 @@ static const struct sid_timespec *sid_pal_timer_get_tolerance(sid_pal_timer_prio
 	return tolerance;
 }
 
-static bool sid_pal_timer_list_in_list(const sid_pal_timer_t *timer)
+#if CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY
+/* Timers being expired are not in the queue, but they count as armed until their callback */
+static bool sid_pal_timer_is_expiring(const sid_pal_timer_t *timer)
 {
-	SID_PAL_ASSERT(timer);
-	bool result = true;
+	sys_dnode_t *node;
 
-	sid_pal_enter_critical_region();
-	if ((0 == timer->node.next) && (0 == timer->node.prev)) {
-		result = false;
+	SYS_DLIST_FOR_EACH_NODE(&expired_list, node) {
+		if (node == &timer->node) {
+			return true;
+		}
 	}
-	sid_pal_exit_critical_region();
+	return false;
+}
+#else
+static bool sid_pal_timer_is_expiring(const sid_pal_timer_t *timer)
+{
+	ARG_UNUSED(timer);
+	return false;
+}
+#endif /* CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY */
+
+static bool sid_pal_timer_queue_contains(const sid_pal_timer_t *timer)
+{
+	SID_PAL_ASSERT(timer);
+
+	sid_critical_section_key_t key = sid_critical_section_enter(&timer_section);
+	bool result = sid_pal_timer_is_expiring(timer) || sid_timer_queue_contains(timer);
+	sid_critical_section_exit(&timer_section, key);
 
 	return result;
 }
 
-static void sid_pal_timer_list_delete(sid_pal_timer_t *timer)
+static void sid_pal_timer_queue_delete(sid_pal_timer_t *timer)
 {
 	SID_PAL_ASSERT(timer);
 
-	sid_pal_enter_critical_region();
-	if (!((0 == timer->node.next) && (0 == timer->node.prev))) {
+	sid_critical_section_key_t key = sid_critical_section_enter(&timer_section);
+	if (sid_pal_timer_is_expiring(timer)) {
 		sys_dlist_remove(&timer->node);
+	} else if (sid_timer_queue_contains(timer)) {
+		sid_timer_queue_remove(timer);
 	}
-	sid_pal_exit_critical_region();
+	sid_critical_section_exit(&timer_section, key);
 }
 
-static void sid_pal_timer_list_insert(struct sid_pal_timer_ctx *ctx, sid_pal_timer_t *timer)
+static int sid_pal_timer_queue_insert(sid_pal_timer_t *timer)
 {
-	SID_PAL_ASSERT(ctx && timer);
-	bool reschedule_required = true;
-
-	sid_pal_enter_critical_region();
-	sys_dnode_t *node = sys_dlist_peek_head(&ctx->list);
-
-	while (node) {
-		sid_pal_timer_t *element = CONTAINER_OF(node, __typeof__(*element), node);
-		if (sid_time_gt(&element->alarm, &timer->alarm)) {
-			struct sid_timespec diff = element->alarm;
-			sid_time_sub(&diff, &timer->alarm);
-			if (!sid_time_gt(&diff, timer->tolerance)) {
-				reschedule_required = false;
-				timer->alarm = element->alarm;
-			}
-			sys_dlist_append(&element->node, &timer->node);
-			break;
-		}
-		reschedule_required = false;
-		node = sys_dlist_peek_next_no_check(&ctx->list, node);
-	}
+	SID_PAL_ASSERT(timer);
+	bool reschedule_required = false;
 
-	if (!node) {
-		sys_dlist_append(&ctx->list, &timer->node);
-	}
+	sid_critical_section_key_t key = sid_critical_section_enter(&timer_section);
+	int err = sid_timer_queue_insert(timer, &reschedule_required);
 	if (reschedule_required) {
 		sid_timer_start(&timer->alarm);
 	}
-	sid_pal_exit_critical_region();
+	sid_critical_section_exit(&timer_section, key);
+
+	return err;
 }
 
-static void sid_pal_timer_list_fetch(struct sid_pal_timer_ctx *ctx,
-				     const struct sid_timespec *non_gt_than,
-				     sid_pal_timer_t **timer)
+#if !CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY
+static void sid_pal_timer_queue_fetch(const struct sid_timespec *non_gt_than,
+				      sid_pal_timer_t **timer)
 {
-	SID_PAL_ASSERT(ctx && non_gt_than && timer);
-	*timer = NULL;
+	SID_PAL_ASSERT(non_gt_than && timer);
 
-	sid_pal_enter_critical_region();
-	sid_pal_timer_t *result = SYS_DLIST_PEEK_HEAD_CONTAINER(&ctx->list, result, node);
-
-	if (result && !sid_time_gt(&result->alarm, non_gt_than)) {
-		*timer = result;
-		sys_dlist_remove(&result->node);
-	}
-	sid_pal_exit_critical_region();
+	sid_critical_section_key_t key = sid_critical_section_enter(&timer_section);
+	*timer = sid_timer_queue_fetch(non_gt_than);
+	sid_critical_section_exit(&timer_section, key);
 }
 
-static void sid_pal_timer_list_get_next_schedule(struct sid_pal_timer_ctx *ctx,
-						 struct sid_timespec *schedule)
+static void sid_pal_timer_queue_get_next_schedule(struct sid_timespec *schedule)
 {
-	SID_PAL_ASSERT(ctx && schedule);
+	SID_PAL_ASSERT(schedule);
 	*schedule = SID_TIME_INFINITY;
 
-	sid_pal_enter_critical_region();
-	sid_pal_timer_t *result = SYS_DLIST_PEEK_HEAD_CONTAINER(&ctx->list, result, node);
+	sid_critical_section_key_t key = sid_critical_section_enter(&timer_section);
+	sid_pal_timer_t *result = sid_timer_queue_peek();
 
 	if (result) {
 		*schedule = result->alarm;
 	}
-	sid_pal_exit_critical_region();
+	sid_critical_section_exit(&timer_section, key);
 }
+#endif /* !CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY */
 
 sid_error_t sid_pal_timer_init(sid_pal_timer_t *timer_storage, sid_pal_timer_cb_t event_callback,
 			       void *event_callback_arg)
@@ -172,7 +174,7 @@ sid_error_t sid_pal_timer_deinit(sid_pal_timer_t *timer_storage)
 		return SID_ERROR_INVALID_ARGS;
 	}
 
-	sid_pal_timer_list_delete(timer_storage);
+	sid_pal_timer_queue_delete(timer_storage);
 	timer_storage->callback = NULL;
 	timer_storage->callback_arg = NULL;
 	return SID_ERROR_NONE;
@@ -195,7 +197,9 @@ sid_error_t sid_pal_timer_arm(sid_pal_timer_t *timer_storage, sid_pal_timer_prio
 	timer_storage->alarm = *when;
 	timer_storage->period = *period;
 	timer_storage->tolerance = sid_pal_timer_get_tolerance(type);
-	sid_pal_timer_list_insert(&sid_pal_timer_ctx, timer_storage);
+	if (sid_pal_timer_queue_insert(timer_storage)) {
+		return SID_ERROR_OUT_OF_RESOURCES;
+	}
 	return SID_ERROR_NONE;
 }
 
@@ -205,7 +209,7 @@ sid_error_t sid_pal_timer_cancel(sid_pal_timer_t *timer_storage)
 		return SID_ERROR_INVALID_ARGS;
 	}
 
-	sid_pal_timer_list_delete(timer_storage);
+	sid_pal_timer_queue_delete(timer_storage);
 	return SID_ERROR_NONE;
 }
 
@@ -215,23 +219,74 @@ bool sid_pal_timer_is_armed(const sid_pal_timer_t *timer_storage)
 		return false;
 	}
 
-	return sid_pal_timer_list_in_list(timer_storage);
+	return sid_pal_timer_queue_contains(timer_storage);
 }
 
+#if CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY
+void sid_pal_timer_event_callback(void *arg, const struct sid_timespec *now)
+{
+	ARG_UNUSED(arg);
+	sid_pal_timer_t *timer = NULL;
+	sid_critical_section_key_t key;
+
+	key = sid_critical_section_enter(&timer_section);
+	while ((timer = sid_timer_queue_fetch(now)) != NULL) {
+		sys_dlist_append(&expired_list, &timer->node);
+	}
+	sid_critical_section_exit(&timer_section, key);
+
+	do {
+		/* Callbacks may cancel timers which are still on the expired list */
+		key = sid_critical_section_enter(&timer_section);
+		timer = SYS_DLIST_PEEK_HEAD_CONTAINER(&expired_list, timer, node);
+		if (timer) {
+			sys_dlist_remove(&timer->node);
+			/*
+			 * Armed again before the callback, as without batching. An earlier
+			 * callback of the batch may have taken the slot of a bounded queue,
+			 * then the periodic timer stops and its callback can arm it again.
+			 */
+			if (!sid_time_is_infinity(&timer->period)) {
+				bool reschedule_required;
+
+				sid_time_add(&timer->alarm, &timer->period);
+				if (sid_timer_queue_insert(timer, &reschedule_required)) {
+					LOG_ERR("Periodic timer %p not rearmed, queue full", timer);
+				}
+			}
+		}
+		sid_critical_section_exit(&timer_section, key);
+
+		if (timer && timer->callback) {
+			timer->callback(timer->callback_arg, (sid_pal_timer_t *)timer);
+		}
+	} while (timer);
+
+	key = sid_critical_section_enter(&timer_section);
+	timer = sid_timer_queue_peek();
+	const struct sid_timespec *next_schedule = timer ? &timer->alarm : &SID_TIME_INFINITY;
+
+	if (!sid_time_eq(next_schedule, &scheduled_alarm)) {
+		sid_timer_start(next_schedule);
+	}
+	sid_critical_section_exit(&timer_section, key);
+}
+#else
 void sid_pal_timer_event_callback(void *arg, const struct sid_timespec *now)
 {
 	ARG_UNUSED(arg);
 	sid_pal_timer_t *timer = NULL;
 
 	do {
-		sid_pal_timer_list_fetch(&sid_pal_timer_ctx, now, &timer);
+		sid_pal_timer_queue_fetch(now, &timer);
 		if (!timer) {
 			break;
 		}
 		if (!sid_time_is_infinity(&timer->period)) {
 			sid_time_add(&timer->alarm, &timer->period);
 
-			sid_pal_timer_list_insert(&sid_pal_timer_ctx, timer);
+			int err = sid_pal_timer_queue_insert(timer);
+			SID_PAL_ASSERT(!err);
 		}
 		if (timer->callback) {
 			timer->callback(timer->callback_arg, (sid_pal_timer_t *)timer);
@@ -240,9 +295,10 @@ void sid_pal_timer_event_callback(void *arg, const struct sid_timespec *now)
 
 	struct sid_timespec next_schedule;
 
-	sid_pal_timer_list_get_next_schedule(&sid_pal_timer_ctx, &next_schedule);
+	sid_pal_timer_queue_get_next_schedule(&next_schedule);
 	sid_timer_start(&next_schedule);
 }
+#endif /* CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY */
 
 static void sid_timer_handler(struct k_timer *timer_data)
 {
@@ -266,6 +322,9 @@ static void sid_timer_start(const struct sid_timespec *sid_time)
 	timer_duration +=
 		(k_ticks_t)k_ms_to_ticks_ceil64(MAX((uint64_t)sid_time->tv_sec * MSEC_PER_SEC, 0));
 	k_timer_start(&sid_timer, Z_TIMEOUT_TICKS(Z_TICK_ABS(timer_duration)), K_NO_WAIT);
+#if CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY
+	scheduled_alarm = *sid_time;
+#endif /* CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY */
 }
 
 #ifdef CONFIG_SIDEWALK_THREAD_TIMER
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_timer_queue_heap.c
+ *  @brief Timer queue kept as a binary min-heap.
+ *
+ *  The heap does not use the list links of the timer node, so they hold
+ *  the position of the timer in the heap (plus one, zero means not armed)
+ *  and the insertion sequence number used to order timers with the same alarm.
+ */
+
+#include <sid_timer_queue.h>
+#include <zephyr/kernel.h>
+#include <errno.h>
+
+static sid_pal_timer_t *heap[CONFIG_SIDEWALK_TIMER_QUEUE_HEAP_SIZE];
+static size_t heap_count;
+static uint32_t heap_sequence;
+
+static inline size_t heap_position_get(const sid_pal_timer_t *timer)
+{
+	return (uintptr_t)timer->node.next;
+}
+
+static inline uint32_t heap_sequence_get(const sid_pal_timer_t *timer)
+{
+	return (uint32_t)(uintptr_t)timer->node.prev;
+}
+
+static inline void heap_sequence_set(sid_pal_timer_t *timer, uint32_t sequence)
+{
+	timer->node.prev = (sys_dnode_t *)(uintptr_t)sequence;
+}
+
+static inline void heap_place(sid_pal_timer_t *timer, size_t index)
+{
+	heap[index] = timer;
+	timer->node.next = (sys_dnode_t *)(uintptr_t)(index + 1);
+}
+
+static bool heap_before(const sid_pal_timer_t *a, const sid_pal_timer_t *b)
+{
+	if (sid_time_gt(&b->alarm, &a->alarm)) {
+		return true;
+	}
+	if (sid_time_gt(&a->alarm, &b->alarm)) {
+		return false;
+	}
+
+	return (int32_t)(heap_sequence_get(a) - heap_sequence_get(b)) < 0;
+}
+
+static void heap_sift_up(size_t index)
+{
+	sid_pal_timer_t *timer = heap[index];
+
+	while (index > 0) {
+		size_t parent = (index - 1) / 2;
+
+		if (!heap_before(timer, heap[parent])) {
+			break;
+		}
+		heap_place(heap[parent], index);
+		index = parent;
+	}
+	heap_place(timer, index);
+}
+
+static void heap_sift_down(size_t index)
+{
+	sid_pal_timer_t *timer = heap[index];
+
+	while (true) {
+		size_t child = 2 * index + 1;
+
+		if (child >= heap_count) {
+			break;
+		}
+		if (child + 1 < heap_count && heap_before(heap[child + 1], heap[child])) {
+			child++;
+		}
+		if (!heap_before(heap[child], timer)) {
+			break;
+		}
+		heap_place(heap[child], index);
+		index = child;
+	}
+	heap_place(timer, index);
+}
+
+/*
+ * Find the first timer with alarm in (alarm, limit].
+ * Subtrees with root greater than alarm cannot contain a better candidate than the root,
+ * and subtrees with root greater than limit contain no candidate at all.
+ */
+static sid_pal_timer_t *heap_find_next(size_t index, const struct sid_timespec *alarm,
+				       const struct sid_timespec *limit, sid_pal_timer_t *best)
+{
+	if (index >= heap_count) {
+		return best;
+	}
+
+	sid_pal_timer_t *element = heap[index];
+
+	if (sid_time_gt(&element->alarm, limit)) {
+		return best;
+	}
+	if (sid_time_gt(&element->alarm, alarm)) {
+		if (!best || heap_before(element, best)) {
+			best = element;
+		}
+		return best;
+	}
+
+	best = heap_find_next(2 * index + 1, alarm, limit, best);
+	return heap_find_next(2 * index + 2, alarm, limit, best);
+}
+
+int sid_timer_queue_insert(sid_pal_timer_t *timer, bool *reschedule)
+{
+	if (heap_count >= ARRAY_SIZE(heap)) {
+		return -ENOMEM;
+	}
+
+	bool coalesced = false;
+
+	heap_sequence_set(timer, heap_sequence++);
+	if (!sid_time_is_zero(timer->tolerance)) {
+		struct sid_timespec limit = timer->alarm;
+
+		sid_time_add(&limit, timer->tolerance);
+		sid_pal_timer_t *next = heap_find_next(0, &timer->alarm, &limit, NULL);
+
+		coalesced = sid_timer_queue_coalesce(timer, next);
+		if (coalesced) {
+			/* Expire just before the timer it was aligned to, as the list does. */
+			heap_sequence_set(timer, heap_sequence_get(next) - 1);
+		}
+	}
+
+	heap[heap_count] = timer;
+	heap_sift_up(heap_count++);
+
+	*reschedule = !coalesced && heap[0] == timer;
+	return 0;
+}
+
+void sid_timer_queue_remove(sid_pal_timer_t *timer)
+{
+	size_t index = heap_position_get(timer) - 1;
+	sid_pal_timer_t *last = heap[--heap_count];
+
+	sys_dnode_init(&timer->node);
+	if (last == timer) {
+		return;
+	}
+
+	heap_place(last, index);
+	if (index > 0 && heap_before(last, heap[(index - 1) / 2])) {
+		heap_sift_up(index);
+	} else {
+		heap_sift_down(index);
+	}
+}
+
+bool sid_timer_queue_contains(const sid_pal_timer_t *timer)
+{
+	return heap_position_get(timer) != 0;
+}
+
+sid_pal_timer_t *sid_timer_queue_peek(void)
+{
+	return heap_count ? heap[0] : NULL;
+}
+
+sid_pal_timer_t *sid_timer_queue_fetch(const struct sid_timespec *now)
+{
+	sid_pal_timer_t *result = sid_timer_queue_peek();
+
+	if (!result || sid_time_gt(&result->alarm, now)) {
+		return NULL;
+	}
+
+	sid_timer_queue_remove(result);
+	return result;
+}
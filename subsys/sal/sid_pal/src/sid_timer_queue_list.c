@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_timer_queue_list.c
+ *  @brief Timer queue kept as a sorted list.
+ */
+
+#include <sid_timer_queue.h>
+#include <zephyr/kernel.h>
+
+static sys_dlist_t timer_list = SYS_DLIST_STATIC_INIT(&timer_list);
+
+int sid_timer_queue_insert(sid_pal_timer_t *timer, bool *reschedule)
+{
+	bool reschedule_required = true;
+	sys_dnode_t *node = sys_dlist_peek_head(&timer_list);
+
+	while (node) {
+		sid_pal_timer_t *element = CONTAINER_OF(node, __typeof__(*element), node);
+		if (sid_time_gt(&element->alarm, &timer->alarm)) {
+			if (sid_timer_queue_coalesce(timer, element)) {
+				reschedule_required = false;
+			}
+			sys_dlist_insert(&element->node, &timer->node);
+			break;
+		}
+		reschedule_required = false;
+		node = sys_dlist_peek_next_no_check(&timer_list, node);
+	}
+
+	if (!node) {
+		sys_dlist_append(&timer_list, &timer->node);
+	}
+
+	*reschedule = reschedule_required;
+	return 0;
+}
+
+void sid_timer_queue_remove(sid_pal_timer_t *timer)
+{
+	sys_dlist_remove(&timer->node);
+}
+
+bool sid_timer_queue_contains(const sid_pal_timer_t *timer)
+{
+	return sys_dnode_is_linked(&timer->node);
+}
+
+sid_pal_timer_t *sid_timer_queue_peek(void)
+{
+	sid_pal_timer_t *result = SYS_DLIST_PEEK_HEAD_CONTAINER(&timer_list, result, node);
+
+	return result;
+}
+
+sid_pal_timer_t *sid_timer_queue_fetch(const struct sid_timespec *now)
+{
+	sid_pal_timer_t *result = sid_timer_queue_peek();
+
+	if (!result || sid_time_gt(&result->alarm, now)) {
+		return NULL;
+	}
+
+	sys_dlist_remove(&result->node);
+	return result;
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sid_timer_queue_wheel.c
+ *  @brief Timer queue kept in a hierarchical timing wheel.
+ *
+ *  Alarms are converted to millisecond ticks. A timer is placed at the level given by
+ *  the highest 6 bit digit in which its tick differs from the wheel base, and in the slot
+ *  given by the value of that digit. With this placement all timers at a lower level expire
+ *  before all timers at a higher level, and within a level lower slots expire first,
+ *  so the first timer is found with one bitmap lookup per level. Slots are kept sorted.
+ *  Timers not reachable by the wheel levels are kept on a sorted overflow list.
+ *  The base follows the uptime passed to fetch, timers whose digit at some level reaches
+ *  the base are moved down to lower levels at that moment.
+ */
+
+#include <sid_timer_queue.h>
+#include <zephyr/kernel.h>
+
+#define WHEEL_SLOT_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_SLOT_BITS)
+#define WHEEL_LEVELS CONFIG_SIDEWALK_TIMER_QUEUE_WHEEL_LEVELS
+
+struct timer_wheel {
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	uint64_t occupied[WHEEL_LEVELS];
+	sys_dlist_t overflow;
+	uint64_t base;
+	bool initialized;
+};
+
+static struct timer_wheel wheel;
+
+static void wheel_init(void)
+{
+	if (wheel.initialized) {
+		return;
+	}
+
+	for (size_t level = 0; level < WHEEL_LEVELS; level++) {
+		for (size_t slot = 0; slot < WHEEL_SLOTS; slot++) {
+			sys_dlist_init(&wheel.slots[level][slot]);
+		}
+	}
+	sys_dlist_init(&wheel.overflow);
+	wheel.initialized = true;
+}
+
+static inline uint64_t wheel_tick(const struct sid_timespec *time)
+{
+	return (uint64_t)time->tv_sec * MSEC_PER_SEC + time->tv_nsec / NSEC_PER_MSEC;
+}
+
+static inline size_t wheel_level(uint64_t tick)
+{
+	if (tick <= wheel.base) {
+		return 0;
+	}
+
+	size_t level = (63 - __builtin_clzll(tick ^ wheel.base)) / WHEEL_SLOT_BITS;
+
+	return MIN(level, WHEEL_LEVELS);
+}
+
+static inline size_t wheel_slot(uint64_t tick, size_t level)
+{
+	return (MAX(tick, wheel.base) >> (level * WHEEL_SLOT_BITS)) & (WHEEL_SLOTS - 1);
+}
+
+static inline uint64_t wheel_slot_mask(size_t first, size_t last)
+{
+	uint64_t mask = (last == WHEEL_SLOTS - 1) ? UINT64_MAX : (BIT64(last + 1) - 1);
+
+	return mask & ~(BIT64(first) - 1);
+}
+
+static void wheel_list_insert(sys_dlist_t *list, sid_pal_timer_t *timer)
+{
+	sys_dnode_t *node = sys_dlist_peek_tail(list);
+
+	/* New timers usually expire last, search from the tail */
+	while (node) {
+		sid_pal_timer_t *element = CONTAINER_OF(node, __typeof__(*element), node);
+		if (!sid_time_gt(&element->alarm, &timer->alarm)) {
+			break;
+		}
+		node = sys_dlist_peek_prev_no_check(list, node);
+	}
+
+	if (node) {
+		sys_dlist_insert(node->next, &timer->node);
+	} else {
+		sys_dlist_prepend(list, &timer->node);
+	}
+}
+
+static void wheel_place(sid_pal_timer_t *timer)
+{
+	uint64_t tick = wheel_tick(&timer->alarm);
+	size_t level = wheel_level(tick);
+
+	if (level == WHEEL_LEVELS) {
+		wheel_list_insert(&wheel.overflow, timer);
+		return;
+	}
+
+	size_t slot = wheel_slot(tick, level);
+
+	wheel_list_insert(&wheel.slots[level][slot], timer);
+	wheel.occupied[level] |= BIT64(slot);
+}
+
+static void wheel_unlink(sid_pal_timer_t *timer, uint64_t tick)
+{
+	size_t level = wheel_level(tick);
+
+	sys_dlist_remove(&timer->node);
+	if (level == WHEEL_LEVELS) {
+		return;
+	}
+
+	size_t slot = wheel_slot(tick, level);
+
+	if (sys_dlist_is_empty(&wheel.slots[level][slot])) {
+		wheel.occupied[level] &= ~BIT64(slot);
+	}
+}
+
+static sid_pal_timer_t *wheel_first_from(size_t level, uint64_t mask)
+{
+	for (; level < WHEEL_LEVELS; level++) {
+		uint64_t occupied = wheel.occupied[level] & mask;
+
+		if (occupied) {
+			sys_dlist_t *list = &wheel.slots[level][__builtin_ctzll(occupied)];
+			sid_pal_timer_t *result = SYS_DLIST_PEEK_HEAD_CONTAINER(list, result, node);
+
+			return result;
+		}
+		mask = UINT64_MAX;
+	}
+
+	sid_pal_timer_t *result = SYS_DLIST_PEEK_HEAD_CONTAINER(&wheel.overflow, result, node);
+
+	return result;
+}
+
+static sid_pal_timer_t *wheel_next(sid_pal_timer_t *timer)
+{
+	uint64_t tick = wheel_tick(&timer->alarm);
+	size_t level = wheel_level(tick);
+	sys_dlist_t *list = (level == WHEEL_LEVELS) ? &wheel.overflow :
+						      &wheel.slots[level][wheel_slot(tick, level)];
+	sys_dnode_t *node = sys_dlist_peek_next(list, &timer->node);
+
+	if (node) {
+		return CONTAINER_OF(node, sid_pal_timer_t, node);
+	}
+	if (level == WHEEL_LEVELS) {
+		return NULL;
+	}
+
+	size_t slot = wheel_slot(tick, level);
+
+	return wheel_first_from(level, slot == WHEEL_SLOTS - 1 ? 0 : ~(BIT64(slot + 1) - 1));
+}
+
+/* Move the base to tick, timers which are no longer at their level are placed again */
+static void wheel_advance(uint64_t tick)
+{
+	if (tick <= wheel.base) {
+		return;
+	}
+
+	sys_dlist_t pending;
+
+	sys_dlist_init(&pending);
+	for (size_t level = 0; level < WHEEL_LEVELS; level++) {
+		size_t shift = level * WHEEL_SLOT_BITS;
+		size_t upper = shift + WHEEL_SLOT_BITS;
+		uint64_t mask = UINT64_MAX;
+
+		if ((wheel.base >> upper) == (tick >> upper)) {
+			size_t from = (wheel.base >> shift) & (WHEEL_SLOTS - 1);
+			size_t to = (tick >> shift) & (WHEEL_SLOTS - 1);
+
+			/* Level 0 keeps the timers due at the base in the base slot */
+			if (level == 0) {
+				mask = wheel_slot_mask(from, to);
+			} else {
+				mask = (from == to) ? 0 : wheel_slot_mask(from + 1, to);
+			}
+		}
+
+		uint64_t moved = wheel.occupied[level] & mask;
+
+		wheel.occupied[level] &= ~moved;
+		while (moved) {
+			sys_dlist_t *list = &wheel.slots[level][__builtin_ctzll(moved)];
+			sys_dnode_t *node;
+
+			while ((node = sys_dlist_get(list)) != NULL) {
+				sys_dlist_append(&pending, node);
+			}
+			moved &= moved - 1;
+		}
+	}
+
+	uint64_t old_base = wheel.base;
+
+	wheel.base = tick;
+	if ((old_base >> (WHEEL_LEVELS * WHEEL_SLOT_BITS)) !=
+	    (tick >> (WHEEL_LEVELS * WHEEL_SLOT_BITS))) {
+		sys_dnode_t *node;
+
+		while ((node = sys_dlist_peek_head(&wheel.overflow)) != NULL) {
+			sid_pal_timer_t *timer = CONTAINER_OF(node, sid_pal_timer_t, node);
+
+			if (wheel_level(wheel_tick(&timer->alarm)) == WHEEL_LEVELS) {
+				break;
+			}
+			sys_dlist_remove(node);
+			sys_dlist_append(&pending, node);
+		}
+	}
+
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		wheel_place(CONTAINER_OF(node, sid_pal_timer_t, node));
+	}
+}
+
+int sid_timer_queue_insert(sid_pal_timer_t *timer, bool *reschedule)
+{
+	uint64_t tick = wheel_tick(&timer->alarm);
+
+	wheel_init();
+	wheel_place(timer);
+
+	/* Timers with the same alarm are in the same slot, before the timer */
+	sid_pal_timer_t *next = sid_time_is_zero(timer->tolerance) ? NULL : wheel_next(timer);
+
+	if (sid_timer_queue_coalesce(timer, next)) {
+		/* Expire just before the timer it was aligned to, as the list does */
+		wheel_unlink(timer, tick);
+		sys_dlist_insert(&next->node, &timer->node);
+		*reschedule = false;
+		return 0;
+	}
+
+	*reschedule = sid_timer_queue_peek() == timer;
+	return 0;
+}
+
+void sid_timer_queue_remove(sid_pal_timer_t *timer)
+{
+	wheel_unlink(timer, wheel_tick(&timer->alarm));
+}
+
+bool sid_timer_queue_contains(const sid_pal_timer_t *timer)
+{
+	return sys_dnode_is_linked(&timer->node);
+}
+
+sid_pal_timer_t *sid_timer_queue_peek(void)
+{
+	wheel_init();
+	return wheel_first_from(0, UINT64_MAX);
+}
+
+sid_pal_timer_t *sid_timer_queue_fetch(const struct sid_timespec *now)
+{
+	wheel_init();
+	wheel_advance(wheel_tick(now));
+
+	sid_pal_timer_t *result = sid_timer_queue_peek();
+
+	if (!result || sid_time_gt(&result->alarm, now)) {
+		return NULL;
+	}
+
+	wheel_unlink(result, wheel_tick(&result->alarm));
+	return result;
+}
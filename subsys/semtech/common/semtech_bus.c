@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file semtech_bus.c
+ *  @brief Radio bus transfers from and to the driver buffers.
+ *
+ *  Commands and payloads of the radio drivers are kept in separate buffers. Buses with
+ *  xfer_sg or xfer_async send them directly, the others need the message in one staging
+ *  buffer.
+ */
+
+#include <semtech_bus.h>
+
+#include <string.h>
+
+static struct semtech_bus_stats bus_stats;
+
+static sid_error_t bus_xfer_staged(const struct sid_pal_serial_bus_iface *iface,
+				   const struct sid_pal_serial_bus_client *client,
+				   uint8_t *staging, size_t staging_size,
+				   const struct sid_pal_serial_bus_buf *bufs, size_t count)
+{
+	size_t size = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		size += bufs[i].len;
+	}
+
+	if (!staging || staging_size < size) {
+		return SID_ERROR_OOM;
+	}
+
+	size_t offset = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		if (bufs[i].tx) {
+			memcpy(&staging[offset], bufs[i].tx, bufs[i].len);
+			bus_stats.bytes_copied += bufs[i].len;
+		} else {
+			memset(&staging[offset], 0, bufs[i].len);
+		}
+		offset += bufs[i].len;
+	}
+
+	sid_error_t err = iface->xfer(iface, client, staging, staging, size);
+
+	if (err != SID_ERROR_NONE) {
+		return err;
+	}
+
+	offset = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (bufs[i].rx) {
+			memcpy(bufs[i].rx, &staging[offset], bufs[i].len);
+			bus_stats.bytes_copied += bufs[i].len;
+		}
+		offset += bufs[i].len;
+	}
+
+	bus_stats.staged_xfers++;
+
+	return SID_ERROR_NONE;
+}
+
+sid_error_t semtech_bus_xfer(const struct sid_pal_serial_bus_iface *iface,
+			     const struct sid_pal_serial_bus_client *client, uint8_t *staging,
+			     size_t staging_size, const struct sid_pal_serial_bus_buf *bufs,
+			     size_t count)
+{
+	if (!iface || !client || !bufs || !count) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
+	if (!iface->xfer_sg) {
+		return bus_xfer_staged(iface, client, staging, staging_size, bufs, count);
+	}
+
+	sid_error_t err = iface->xfer_sg(iface, client, bufs, count);
+
+	if (err == SID_ERROR_NONE) {
+		bus_stats.sg_xfers++;
+	}
+
+	return err;
+}
+
+sid_error_t semtech_bus_xfer_async(const struct sid_pal_serial_bus_iface *iface,
+				   const struct sid_pal_serial_bus_client *client, uint8_t *staging,
+				   size_t staging_size, const struct sid_pal_serial_bus_buf *bufs,
+				   size_t count, sid_pal_serial_bus_xfer_done_t done, void *context)
+{
+	if (!iface || !client || !bufs || !count || !done) {
+		return SID_ERROR_INVALID_ARGS;
+	}
+
+	if (!iface->xfer_async) {
+		done(semtech_bus_xfer(iface, client, staging, staging_size, bufs, count), context);
+		return SID_ERROR_NONE;
+	}
+
+	sid_error_t err = iface->xfer_async(iface, client, bufs, count, done, context);
+
+	if (err == SID_ERROR_NONE) {
+		bus_stats.async_xfers++;
+	}
+
+	return err;
+}
+
+void semtech_bus_stats_get(struct semtech_bus_stats *stats)
+{
+	if (stats) {
+		*stats = bus_stats;
+	}
+}
+
+void semtech_bus_stats_reset(void)
+{
+	memset(&bus_stats, 0, sizeof(bus_stats));
+}
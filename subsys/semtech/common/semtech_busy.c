@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file semtech_busy.c
+ *  @brief Wait for the BUSY line of Semtech radios.
+ */
+
+#include <semtech_busy.h>
+
+#include <sid_pal_delay_ifc.h>
+#include <sid_pal_gpio_ifc.h>
+#if CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ
+#include <sid_gpio_utils.h>
+#include <sid_critical_section.h>
+#endif /* CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(semtech_busy, CONFIG_SIDEWALK_LOG_LEVEL);
+
+/* Poll period without the interrupt, the same as the radio drivers used */
+#define BUSY_POLL_PERIOD_US 10
+/* Poll period before the interrupt is armed */
+#define BUSY_POLL_PERIOD_SHORT_US 1
+
+static struct semtech_busy_stats busy_stats;
+
+#if CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ
+static K_SEM_DEFINE(busy_sem, 0, 1);
+static uint32_t busy_irq_gpio;
+static bool busy_irq_ready;
+
+static void busy_irq_handler(uint32_t gpio, void *arg)
+{
+	ARG_UNUSED(gpio);
+	ARG_UNUSED(arg);
+
+	k_sem_give(&busy_sem);
+}
+#endif /* CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ */
+
+static uint32_t elapsed_us(uint32_t start_cycles)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start_cycles);
+}
+
+/* Read errors are treated as busy, the wait ends with a timeout if they persist */
+static bool busy_is_released(uint32_t gpio)
+{
+	uint8_t busy = 0;
+
+	return sid_pal_gpio_read(gpio, &busy) == SID_ERROR_NONE && !busy;
+}
+
+static bool busy_poll(uint32_t gpio, uint32_t timeout_us, uint32_t period_us)
+{
+	uint32_t start = k_cycle_get_32();
+
+	while (!busy_is_released(gpio)) {
+		if (elapsed_us(start) >= timeout_us) {
+			return false;
+		}
+		sid_pal_delay_us(period_us);
+	}
+
+	return true;
+}
+
+#if CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ
+static bool irq_locked(void)
+{
+	unsigned int key = irq_lock();
+	bool locked = !arch_irq_unlocked(key);
+
+	irq_unlock(key);
+	return locked;
+}
+
+/* Sleeping with interrupts locked or in the critical region would let other threads enter it */
+static bool busy_sleep_allowed(uint32_t gpio)
+{
+	return busy_irq_ready && gpio == busy_irq_gpio && !k_is_in_isr() &&
+	       !sid_gpio_utils_irq_context() && !sid_critical_region_is_held() && !irq_locked();
+}
+
+static bool busy_sleep(uint32_t gpio, uint32_t timeout_us)
+{
+	k_sem_reset(&busy_sem);
+	if (sid_pal_gpio_irq_enable(gpio) != SID_ERROR_NONE) {
+		return busy_poll(gpio, timeout_us, BUSY_POLL_PERIOD_US);
+	}
+
+	/* The edge may have come before the interrupt was enabled */
+	if (!busy_is_released(gpio)) {
+		(void)k_sem_take(&busy_sem, K_USEC(timeout_us));
+	}
+
+	(void)sid_pal_gpio_irq_disable(gpio);
+
+	return busy_is_released(gpio);
+}
+#endif /* CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ */
+
+void semtech_busy_init(uint32_t gpio)
+{
+#if CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ
+	busy_irq_ready = false;
+	if (sid_pal_gpio_set_irq(gpio, SID_PAL_GPIO_IRQ_TRIGGER_FALLING, busy_irq_handler,
+				 NULL) != SID_ERROR_NONE ||
+	    sid_pal_gpio_irq_disable(gpio) != SID_ERROR_NONE) {
+		LOG_WRN("BUSY interrupt not available, polling");
+		return;
+	}
+	busy_irq_gpio = gpio;
+	busy_irq_ready = true;
+#else
+	ARG_UNUSED(gpio);
+#endif /* CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ */
+}
+
+void semtech_busy_deinit(uint32_t gpio)
+{
+#if CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ
+	if (busy_irq_ready && gpio == busy_irq_gpio) {
+		busy_irq_ready = false;
+		(void)sid_pal_gpio_set_irq(gpio, SID_PAL_GPIO_IRQ_TRIGGER_NONE, NULL, NULL);
+	}
+#else
+	ARG_UNUSED(gpio);
+#endif /* CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ */
+}
+
+sid_error_t semtech_busy_wait(uint32_t gpio, uint32_t timeout_us)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t poll_us = timeout_us;
+	uint32_t period_us = BUSY_POLL_PERIOD_US;
+
+#if CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ
+	bool sleep = busy_sleep_allowed(gpio) && timeout_us > CONFIG_SIDEWALK_SUBGHZ_BUSY_POLL_US;
+
+	if (sleep) {
+		poll_us = CONFIG_SIDEWALK_SUBGHZ_BUSY_POLL_US;
+		period_us = BUSY_POLL_PERIOD_SHORT_US;
+	}
+#endif /* CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ */
+
+	bool released = busy_poll(gpio, poll_us, period_us);
+	uint32_t spin_us = elapsed_us(start);
+	uint32_t wait_us = spin_us;
+
+	busy_stats.spin_us += spin_us;
+
+#if CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ
+	if (!released && sleep) {
+		uint32_t sleep_start = k_cycle_get_32();
+
+		released = busy_sleep(gpio, timeout_us > spin_us ? timeout_us - spin_us : 0);
+		uint32_t blocked_us = elapsed_us(sleep_start);
+
+		busy_stats.blocked_us += blocked_us;
+		busy_stats.irq_waits++;
+		wait_us += blocked_us;
+	}
+#endif /* CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ */
+
+	busy_stats.waits++;
+	if (wait_us > busy_stats.max_wait_us) {
+		busy_stats.max_wait_us = wait_us;
+	}
+
+	if (!released) {
+		busy_stats.timeouts++;
+		return SID_ERROR_TIMEOUT;
+	}
+
+	return SID_ERROR_NONE;
+}
+
+void semtech_busy_stats_get(struct semtech_busy_stats *stats)
+{
+	if (stats) {
+		*stats = busy_stats;
+	}
+}
+
+void semtech_busy_stats_reset(void)
+{
+	memset(&busy_stats, 0, sizeof(busy_stats));
+}
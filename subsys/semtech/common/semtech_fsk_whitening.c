@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file semtech_fsk_whitening.c
+ *  @brief Data whitening for the Sidewalk FSK PHY.
+ *
+ *  The 9 bit LFSR does not depend on the data, so for a given seed the whitening
+ *  sequence is always the same. It is generated once for the longest PSDU and
+ *  whitening becomes a XOR with the cached sequence.
+ */
+
+#include <semtech_fsk_whitening.h>
+#include <semtech_fsk_crc.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/sys/util.h>
+
+#define WHITENING_SEQUENCE_LENGTH 255
+/* Dewhitened data is passed to the CRC in blocks, while it is still hot */
+#define DEWHITEN_CRC_BLOCK_SIZE 16
+
+static struct {
+	uint8_t sequence[WHITENING_SEQUENCE_LENGTH];
+	/* LFSR state after the last byte of the sequence */
+	uint16_t lfsr_end;
+	uint16_t seed;
+	/* Set once, after the sequence is written. Concurrent first use writes the same values. */
+	volatile bool valid;
+} whitening_cache;
+
+struct whitening_stream {
+	/* NULL when the cached sequence can not be used */
+	const uint8_t *sequence;
+	uint16_t position;
+	uint16_t lfsr;
+};
+
+static uint8_t whitening_next_mask(uint16_t *lfsr)
+{
+	uint16_t xor_out = 0;
+	uint8_t ret = 0;
+	uint8_t result = 0;
+
+	xor_out = ((*lfsr >> 5) & 0x0F) ^ (*lfsr & 0x0F);
+	*lfsr = (*lfsr >> 4) | (xor_out << 5);
+	ret |= (*lfsr >> 5) & 0x0F;
+
+	xor_out = ((*lfsr >> 5) & 0x0F) ^ (*lfsr & 0x0F);
+	*lfsr = (*lfsr >> 4) | (xor_out << 5);
+	ret |= ((*lfsr >> 1) & 0xf0);
+
+	result |= (ret & 0x80) >> 7;
+	result |= (ret & 0x40) >> 5;
+	result |= (ret & 0x20) >> 3;
+	result |= (ret & 0x10) >> 1;
+	result |= (ret & 0x08) << 1;
+	result |= (ret & 0x04) << 3;
+	result |= (ret & 0x02) << 5;
+	result |= (ret & 0x01) << 7;
+
+	return result;
+}
+
+static uint16_t whitening_lfsr_apply(uint16_t lfsr, const uint8_t *buffer_in, uint8_t *buffer_out,
+				     uint16_t length)
+{
+	for (uint16_t index = 0; index < length; index++) {
+		buffer_out[index] = buffer_in[index] ^ whitening_next_mask(&lfsr);
+	}
+	return lfsr;
+}
+
+static const uint8_t *whitening_sequence_get(uint16_t seed)
+{
+	if (!whitening_cache.valid) {
+		uint16_t lfsr = seed;
+		for (uint16_t i = 0; i < WHITENING_SEQUENCE_LENGTH; i++) {
+			whitening_cache.sequence[i] = whitening_next_mask(&lfsr);
+		}
+		whitening_cache.lfsr_end = lfsr;
+		whitening_cache.seed = seed;
+		whitening_cache.valid = true;
+	}
+
+	return (whitening_cache.seed == seed) ? whitening_cache.sequence : NULL;
+}
+
+static void whitening_stream_init(struct whitening_stream *stream, uint16_t seed)
+{
+	*stream = (struct whitening_stream){ .sequence = whitening_sequence_get(seed),
+					     .position = 0,
+					     .lfsr = seed };
+}
+
+static void whitening_stream_apply(struct whitening_stream *stream, const uint8_t *buffer_in,
+				   uint8_t *buffer_out, uint16_t length)
+{
+	uint16_t index = 0;
+
+	if (stream->sequence) {
+		for (; index < length && stream->position < WHITENING_SEQUENCE_LENGTH;
+		     index++, stream->position++) {
+			buffer_out[index] = buffer_in[index] ^ stream->sequence[stream->position];
+		}
+		if (index == length) {
+			return;
+		}
+		/* Longer than the cached sequence, continue with the LFSR */
+		stream->sequence = NULL;
+		stream->lfsr = whitening_cache.lfsr_end;
+	}
+
+	stream->lfsr = whitening_lfsr_apply(stream->lfsr, buffer_in + index, buffer_out + index,
+					    length - index);
+}
+
+void perform_data_whitening(uint16_t seed, const uint8_t *buffer_in, uint8_t *buffer_out,
+			    uint16_t length)
+{
+	struct whitening_stream stream;
+
+	whitening_stream_init(&stream, seed);
+	whitening_stream_apply(&stream, buffer_in, buffer_out, length);
+}
+
+void semtech_fsk_whitening_lfsr(uint16_t seed, const uint8_t *buffer_in, uint8_t *buffer_out,
+				uint16_t length)
+{
+	(void)whitening_lfsr_apply(seed, buffer_in, buffer_out, length);
+}
+
+uint16_t semtech_fsk_dewhiten_crc16(uint16_t seed, uint8_t *buffer, uint16_t length,
+				    uint16_t crc_data_length)
+{
+	struct whitening_stream stream;
+	uint16_t crc = SEMTECH_FSK_CRC16_INIT;
+	uint16_t offset = 0;
+
+	if (!buffer) {
+		return 0;
+	}
+
+	crc_data_length = MIN(crc_data_length, length);
+	whitening_stream_init(&stream, seed);
+	while (offset < length) {
+		uint16_t block = MIN(DEWHITEN_CRC_BLOCK_SIZE, length - offset);
+		whitening_stream_apply(&stream, buffer + offset, buffer + offset, block);
+		if (offset < crc_data_length) {
+			crc = semtech_fsk_crc16_update(crc, buffer + offset,
+						       MIN(block, crc_data_length - offset));
+		}
+		offset += block;
+	}
+
+	return crc_data_length ? crc : 0;
+}
+
+uint32_t semtech_fsk_dewhiten_crc32(uint16_t seed, uint8_t *buffer, uint16_t length,
+				    uint16_t crc_data_length)
+{
+	struct whitening_stream stream;
+	uint32_t crc = SEMTECH_FSK_CRC32_INIT;
+	uint16_t offset = 0;
+
+	if (!buffer) {
+		return 0;
+	}
+
+	crc_data_length = MIN(crc_data_length, length);
+	whitening_stream_init(&stream, seed);
+	while (offset < length) {
+		uint16_t block = MIN(DEWHITEN_CRC_BLOCK_SIZE, length - offset);
+		whitening_stream_apply(&stream, buffer + offset, buffer + offset, block);
+		if (offset < crc_data_length) {
+			crc = semtech_fsk_crc32_update(crc, buffer + offset,
+						       MIN(block, crc_data_length - offset));
+		}
+		offset += block;
+	}
+
+	return semtech_fsk_crc32_final(crc, crc_data_length);
+}
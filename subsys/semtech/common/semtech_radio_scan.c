@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file semtech_radio_scan.c
+ *  @brief RSSI sampling of a list of channels, paced with a kernel timer.
+ */
+
+#include <semtech_radio_scan.h>
+
+#include <sid_pal_radio_ifc.h>
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+static K_TIMER_DEFINE(scan_timer, NULL, NULL);
+
+int32_t semtech_radio_scan_check(const uint32_t *freqs, size_t count,
+				 const struct semtech_radio_scan_plan *plan,
+				 struct semtech_radio_scan_result *results)
+{
+	if (!freqs || !count || !plan || !results) {
+		return RADIO_ERROR_INVALID_PARAMS;
+	}
+
+	if (plan->samples == 0 || plan->samples > SEMTECH_RADIO_SCAN_MAX_SAMPLES ||
+	    plan->percentile > 100) {
+		return RADIO_ERROR_INVALID_PARAMS;
+	}
+
+	return RADIO_ERROR_NONE;
+}
+
+static void scan_sort(int16_t *samples, size_t count)
+{
+	for (size_t i = 1; i < count; i++) {
+		int16_t sample = samples[i];
+		size_t j = i;
+
+		for (; j > 0 && samples[j - 1] > sample; j--) {
+			samples[j] = samples[j - 1];
+		}
+		samples[j] = sample;
+	}
+}
+
+static void scan_result_set(struct semtech_radio_scan_result *result, int16_t *samples,
+			    size_t count, uint8_t percentile)
+{
+	int32_t sum = 0;
+
+	scan_sort(samples, count);
+	for (size_t i = 0; i < count; i++) {
+		sum += samples[i];
+	}
+
+	result->samples = count;
+	result->mean = sum / (int32_t)count;
+	result->max = samples[count - 1];
+	/* Nearest rank */
+	result->percentile = samples[(percentile * (count - 1) + 50) / 100];
+}
+
+static int32_t scan_channel(const struct semtech_radio_scan_ops *ops, uint32_t freq,
+			    const struct semtech_radio_scan_plan *plan,
+			    struct semtech_radio_scan_result *result)
+{
+	int16_t samples[SEMTECH_RADIO_SCAN_MAX_SAMPLES];
+	size_t count = 0;
+	int32_t err;
+
+	result->freq = freq;
+	result->is_free = true;
+
+	err = ops->tune(freq);
+	if (err != RADIO_ERROR_NONE) {
+		return err;
+	}
+
+	k_timer_start(&scan_timer, K_USEC(plan->settle_us), K_USEC(plan->period_us));
+
+	while (count < plan->samples) {
+		int16_t rssi;
+
+		k_timer_status_sync(&scan_timer);
+		rssi = ops->rssi();
+		if (rssi == INT16_MAX) {
+			err = RADIO_ERROR_HARDWARE_ERROR;
+			break;
+		}
+
+		samples[count++] = rssi;
+		if (rssi > plan->busy_threshold) {
+			result->is_free = false;
+			break;
+		}
+	}
+
+	k_timer_stop(&scan_timer);
+
+	if (count) {
+		scan_result_set(result, samples, count, plan->percentile);
+	}
+
+	return err;
+}
+
+int32_t semtech_radio_scan_run(const struct semtech_radio_scan_ops *ops, const uint32_t *freqs,
+			       size_t count, const struct semtech_radio_scan_plan *plan,
+			       struct semtech_radio_scan_result *results)
+{
+	int32_t err = semtech_radio_scan_check(freqs, count, plan, results);
+
+	if (err != RADIO_ERROR_NONE) {
+		return err;
+	}
+
+	if (!ops || !ops->tune || !ops->rssi) {
+		return RADIO_ERROR_INVALID_PARAMS;
+	}
+
+	memset(results, 0, count * sizeof(*results));
+
+	for (size_t i = 0; i < count; i++) {
+		err = scan_channel(ops, freqs[i], plan, &results[i]);
+		if (err != RADIO_ERROR_NONE) {
+			break;
+		}
+	}
+
+	return err;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SEMTECH_BUS_H
+#define SEMTECH_BUS_H
+
+#include <sid_error.h>
+#include <sid_pal_serial_bus_ifc.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Counters of the radio bus transfers.
+ */
+struct semtech_bus_stats {
+	/** Transfers done with the scatter-gather callback of the bus. */
+	uint32_t sg_xfers;
+	/** Transfers started with the asynchronous callback of the bus. */
+	uint32_t async_xfers;
+	/** Transfers assembled in the staging buffer. */
+	uint32_t staged_xfers;
+	/** Bytes copied to and from the staging buffer. */
+	uint32_t bytes_copied;
+};
+
+/**
+ * @brief Transfer a message made of several segments to the radio.
+ *
+ * If the bus implements xfer_sg, the segments are passed to the bus as they are. Otherwise
+ * the segments are assembled in the staging buffer, transferred in full duplex mode with
+ * xfer and the received data is copied back to the segments. Segments without tx buffer
+ * are sent as zeros in that case.
+ *
+ * @param iface serial bus interface.
+ * @param client serial bus client.
+ * @param staging buffer for buses without xfer_sg, may be NULL if the bus implements it.
+ * @param staging_size size of the staging buffer.
+ * @param bufs segments of the message.
+ * @param count number of segments.
+ * @return SID_ERROR_NONE on success, SID_ERROR_OOM if the message does not fit in the staging
+ *         buffer, error returned by the bus otherwise.
+ */
+sid_error_t semtech_bus_xfer(const struct sid_pal_serial_bus_iface *iface,
+			     const struct sid_pal_serial_bus_client *client, uint8_t *staging,
+			     size_t staging_size, const struct sid_pal_serial_bus_buf *bufs,
+			     size_t count);
+
+/**
+ * @brief Start a transfer of a message made of several segments to the radio.
+ *
+ * If the bus implements xfer_async, the caller can work on other data until done is called.
+ * Otherwise the transfer is done with semtech_bus_xfer and done is called before return.
+ *
+ * @param iface serial bus interface.
+ * @param client serial bus client.
+ * @param staging buffer for buses without xfer_sg and xfer_async, may be NULL otherwise.
+ * @param staging_size size of the staging buffer.
+ * @param bufs segments of the message, valid until done is called.
+ * @param count number of segments.
+ * @param done callback called when the transfer is finished, may be called from interrupt.
+ * @param context pointer passed to done.
+ * @return SID_ERROR_NONE if the transfer was started, error code otherwise. done is called
+ *         only if the transfer was started.
+ */
+sid_error_t semtech_bus_xfer_async(const struct sid_pal_serial_bus_iface *iface,
+				   const struct sid_pal_serial_bus_client *client, uint8_t *staging,
+				   size_t staging_size, const struct sid_pal_serial_bus_buf *bufs,
+				   size_t count, sid_pal_serial_bus_xfer_done_t done,
+				   void *context);
+
+/**
+ * @brief Get the bus transfer counters.
+ *
+ * @param stats [out] counters since boot or the last reset.
+ */
+void semtech_bus_stats_get(struct semtech_bus_stats *stats);
+
+/**
+ * @brief Reset the bus transfer counters.
+ */
+void semtech_bus_stats_reset(void);
+
+#endif /* SEMTECH_BUS_H */
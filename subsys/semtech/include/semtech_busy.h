@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SEMTECH_BUSY_H
+#define SEMTECH_BUSY_H
+
+#include <sid_error.h>
+
+#include <stdint.h>
+
+/**
+ * @brief Statistics of the waits for the radio BUSY line.
+ */
+struct semtech_busy_stats {
+	/** Number of waits. */
+	uint32_t waits;
+	/** Waits that slept until the BUSY interrupt. */
+	uint32_t irq_waits;
+	/** Waits that ended with a timeout. */
+	uint32_t timeouts;
+	/** Total time the CPU was polling the BUSY line [us]. */
+	uint64_t spin_us;
+	/** Total time the caller slept waiting for the BUSY interrupt [us]. */
+	uint64_t blocked_us;
+	/** Longest wait [us]. */
+	uint32_t max_wait_us;
+};
+
+/**
+ * @brief Prepare the BUSY line for waits.
+ *
+ * With CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ the falling edge interrupt is configured on the line.
+ * If that fails, waits poll the line.
+ *
+ * @param gpio GPIO of the BUSY line, configured as input.
+ */
+void semtech_busy_init(uint32_t gpio);
+
+/**
+ * @brief Release the BUSY line interrupt.
+ *
+ * @param gpio GPIO of the BUSY line.
+ */
+void semtech_busy_deinit(uint32_t gpio);
+
+/**
+ * @brief Wait until the radio releases the BUSY line.
+ *
+ * The line is polled for CONFIG_SIDEWALK_SUBGHZ_BUSY_POLL_US, then the caller sleeps until
+ * the interrupt. The line is polled for the whole wait without CONFIG_SIDEWALK_SUBGHZ_BUSY_IRQ,
+ * in interrupt context, in the thread that runs GPIO handlers, with interrupts locked and in
+ * the Sidewalk critical region.
+ *
+ * @param gpio GPIO of the BUSY line.
+ * @param timeout_us maximum time to wait.
+ * @return SID_ERROR_NONE if the line is low, SID_ERROR_TIMEOUT otherwise.
+ */
+sid_error_t semtech_busy_wait(uint32_t gpio, uint32_t timeout_us);
+
+/**
+ * @brief Get the statistics of the BUSY waits.
+ *
+ * @param stats [out] statistics since boot or the last reset.
+ */
+void semtech_busy_stats_get(struct semtech_busy_stats *stats);
+
+/**
+ * @brief Reset the statistics of the BUSY waits.
+ */
+void semtech_busy_stats_reset(void);
+
+#endif /* SEMTECH_BUSY_H */
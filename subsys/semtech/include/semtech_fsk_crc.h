@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SEMTECH_FSK_CRC_H
+#define SEMTECH_FSK_CRC_H
+
+#include <stdint.h>
+
+#define SEMTECH_FSK_CRC16_INIT 0x0000
+#define SEMTECH_FSK_CRC32_INIT 0xFFFFFFFF
+
+/**
+ * @brief Compute FSK PHY CRC16 with the kernel selected by CONFIG_SIDEWALK_SUBGHZ_FSK_CRC_*.
+ *
+ * @param buffer data to compute the CRC on.
+ * @param length number of bytes in buffer.
+ * @return CRC16 value, 0 when buffer is NULL or length is 0.
+ */
+uint16_t compute_crc16(const uint8_t *buffer, uint16_t length);
+
+/**
+ * @brief Compute FSK PHY CRC32 with the kernel selected by CONFIG_SIDEWALK_SUBGHZ_FSK_CRC_*.
+ *
+ * @param buffer data to compute the CRC on.
+ * @param length number of bytes in buffer.
+ * @return CRC32 value, 0 when buffer is NULL or length is 0.
+ */
+uint32_t compute_crc32(const uint8_t *buffer, uint16_t length);
+
+/**
+ * @brief Continue CRC16 computation over the next part of the data.
+ *
+ * Start with SEMTECH_FSK_CRC16_INIT. After the last part the value is the same as
+ * compute_crc16 over the whole data.
+ *
+ * @param crc value returned for the previous part.
+ * @param buffer next part of the data.
+ * @param length number of bytes in buffer.
+ * @return updated CRC16 value.
+ */
+uint16_t semtech_fsk_crc16_update(uint16_t crc, const uint8_t *buffer, uint16_t length);
+
+/**
+ * @brief Continue CRC32 computation over the next part of the data.
+ *
+ * Start with SEMTECH_FSK_CRC32_INIT and finish with semtech_fsk_crc32_final.
+ *
+ * @param crc value returned for the previous part.
+ * @param buffer next part of the data.
+ * @param length number of bytes in buffer.
+ * @return updated CRC32 value.
+ */
+uint32_t semtech_fsk_crc32_update(uint32_t crc, const uint8_t *buffer, uint16_t length);
+
+/**
+ * @brief Finish CRC32 computation, the result is the same as compute_crc32 over the whole data.
+ *
+ * @param crc value returned by semtech_fsk_crc32_update for the last part.
+ * @param length total number of bytes passed to semtech_fsk_crc32_update.
+ * @return CRC32 value.
+ */
+uint32_t semtech_fsk_crc32_final(uint32_t crc, uint16_t length);
+
+/*
+ * Kernels below give results identical to compute_crc16 and compute_crc32.
+ * They are exposed for tests and benchmarks.
+ */
+
+/* Bit at a time, no lookup tables. */
+uint16_t semtech_fsk_crc16_bitwise(const uint8_t *buffer, uint16_t length);
+uint32_t semtech_fsk_crc32_bitwise(const uint8_t *buffer, uint16_t length);
+
+/* Nibble at a time, 96 bytes of lookup tables. */
+uint16_t semtech_fsk_crc16_nibble(const uint8_t *buffer, uint16_t length);
+uint32_t semtech_fsk_crc32_nibble(const uint8_t *buffer, uint16_t length);
+
+/* Byte at a time, 1.5 kB of lookup tables. */
+uint16_t semtech_fsk_crc16_byte(const uint8_t *buffer, uint16_t length);
+uint32_t semtech_fsk_crc32_byte(const uint8_t *buffer, uint16_t length);
+
+/* Four bytes at a time, 6 kB of lookup tables. */
+uint16_t semtech_fsk_crc16_slice_by_4(const uint8_t *buffer, uint16_t length);
+uint32_t semtech_fsk_crc32_slice_by_4(const uint8_t *buffer, uint16_t length);
+
+#endif /* SEMTECH_FSK_CRC_H */
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SEMTECH_FSK_WHITENING_H
+#define SEMTECH_FSK_WHITENING_H
+
+#include <stdint.h>
+
+/**
+ * @brief Whiten or dewhiten FSK PHY data.
+ *
+ * The whitening sequence of the first seed used is generated once and kept in RAM,
+ * data is then XORed with it. Other seeds step the LFSR for every byte.
+ *
+ * @param seed whitening seed.
+ * @param buffer_in data to process.
+ * @param buffer_out processed data, can be the same as buffer_in.
+ * @param length number of bytes to process.
+ */
+void perform_data_whitening(uint16_t seed, const uint8_t *buffer_in, uint8_t *buffer_out,
+			    uint16_t length);
+
+/**
+ * @brief Dewhiten received data in place and compute CRC16 in the same pass.
+ *
+ * Result is the same as perform_data_whitening followed by compute_crc16.
+ *
+ * @param seed whitening seed.
+ * @param buffer received data, dewhitened on return.
+ * @param length number of bytes to dewhiten.
+ * @param crc_data_length number of bytes from the start of buffer covered by the CRC.
+ * @return CRC16 of the dewhitened data, 0 when buffer is NULL or crc_data_length is 0.
+ */
+uint16_t semtech_fsk_dewhiten_crc16(uint16_t seed, uint8_t *buffer, uint16_t length,
+				    uint16_t crc_data_length);
+
+/**
+ * @brief Dewhiten received data in place and compute CRC32 in the same pass.
+ *
+ * Result is the same as perform_data_whitening followed by compute_crc32.
+ *
+ * @param seed whitening seed.
+ * @param buffer received data, dewhitened on return.
+ * @param length number of bytes to dewhiten.
+ * @param crc_data_length number of bytes from the start of buffer covered by the CRC.
+ * @return CRC32 of the dewhitened data, 0 when buffer is NULL or crc_data_length is 0.
+ */
+uint32_t semtech_fsk_dewhiten_crc32(uint16_t seed, uint8_t *buffer, uint16_t length,
+				    uint16_t crc_data_length);
+
+/**
+ * @brief Whitening that steps the LFSR for every byte, without the cached sequence.
+ *
+ * Exposed for tests and benchmarks.
+ */
+void semtech_fsk_whitening_lfsr(uint16_t seed, const uint8_t *buffer_in, uint8_t *buffer_out,
+				uint16_t length);
+
+#endif /* SEMTECH_FSK_WHITENING_H */
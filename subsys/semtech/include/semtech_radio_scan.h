@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file semtech_radio_scan.h
+ *  @brief Noise floor and channel free scan of a list of channels.
+ */
+
+#ifndef SEMTECH_RADIO_SCAN_H
+#define SEMTECH_RADIO_SCAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Maximum number of RSSI samples per channel. */
+#define SEMTECH_RADIO_SCAN_MAX_SAMPLES 64
+
+/**
+ * @brief How every channel of the scan is sampled.
+ */
+struct semtech_radio_scan_plan {
+	/** RSSI samples per channel, 1 to SEMTECH_RADIO_SCAN_MAX_SAMPLES. */
+	uint16_t samples;
+	/** Time between samples [us]. */
+	uint32_t period_us;
+	/** Time from tuning to the channel to the first sample [us]. */
+	uint32_t settle_us;
+	/** Percentile of the samples reported in the result, 0 to 100. */
+	uint8_t percentile;
+	/**
+	 * The channel is busy and its sampling stops at the first sample above this level [dBm].
+	 * INT16_MAX takes all samples.
+	 */
+	int16_t busy_threshold;
+};
+
+/**
+ * @brief RSSI of one channel.
+ */
+struct semtech_radio_scan_result {
+	/** Frequency of the channel [Hz]. */
+	uint32_t freq;
+	/** Mean of the samples [dBm]. */
+	int16_t mean;
+	/** Highest sample [dBm]. */
+	int16_t max;
+	/** Requested percentile of the samples [dBm]. */
+	int16_t percentile;
+	/** Number of samples taken. */
+	uint16_t samples;
+	/** No sample was above the busy threshold. */
+	bool is_free;
+};
+
+/**
+ * @brief Radio operations used by the scan.
+ */
+struct semtech_radio_scan_ops {
+	/**
+	 * Tune the receiver to the channel and keep receiving.
+	 *
+	 * @return RADIO_ERROR_NONE on success, radio error code otherwise.
+	 */
+	int32_t (*tune)(uint32_t freq);
+	/**
+	 * Read the instantaneous RSSI.
+	 *
+	 * @return RSSI in dBm, INT16_MAX on error.
+	 */
+	int16_t (*rssi)(void);
+};
+
+/**
+ * @brief Scan a list of channels.
+ *
+ * The radio has to be in standby. It is kept in continuous RX with the radio interrupt
+ * disabled while the channels are sampled, and is left in standby on the last channel.
+ *
+ * @note Must be called from a thread. Samples are paced with a kernel timer and the thread
+ *       sleeps between them.
+ *
+ * @param freqs frequencies of the channels [Hz].
+ * @param count number of channels.
+ * @param plan how every channel is sampled.
+ * @param results [out] one result per channel.
+ * @return RADIO_ERROR_NONE on success, radio error code otherwise.
+ */
+int32_t semtech_radio_scan_channels(const uint32_t *freqs, size_t count,
+				    const struct semtech_radio_scan_plan *plan,
+				    struct semtech_radio_scan_result *results);
+
+/**
+ * @brief Sample the channels with the radio operations.
+ *
+ * Helper for the radio drivers, which put the radio in continuous RX before and back to
+ * standby after the call.
+ *
+ * @param ops radio operations.
+ * @param freqs frequencies of the channels [Hz].
+ * @param count number of channels.
+ * @param plan how every channel is sampled.
+ * @param results [out] one result per channel.
+ * @return RADIO_ERROR_NONE on success, radio error code otherwise.
+ */
+int32_t semtech_radio_scan_run(const struct semtech_radio_scan_ops *ops, const uint32_t *freqs,
+			       size_t count, const struct semtech_radio_scan_plan *plan,
+			       struct semtech_radio_scan_result *results);
+
+/**
+ * @brief Check the arguments of a scan.
+ *
+ * @return RADIO_ERROR_NONE if the scan can be run, RADIO_ERROR_INVALID_PARAMS otherwise.
+ */
+int32_t semtech_radio_scan_check(const uint32_t *freqs, size_t count,
+				 const struct semtech_radio_scan_plan *plan,
+				 struct semtech_radio_scan_result *results);
+
+#endif /* SEMTECH_RADIO_SCAN_H */
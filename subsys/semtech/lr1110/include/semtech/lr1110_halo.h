@@ -43,6 +43,8 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <semtech_fsk_crc.h>
+#include <semtech_fsk_whitening.h>
 
 /*
  * -----------------------------------------------------------------------------
@@ -65,39 +67,6 @@ extern "C" {
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
  */
 
-/**
- * perform data whitening
- *
- * @param [in] seed             whitening seed
- * @param [in] buffer_in        pointer to the buffer that needs to be updated
- * @param [in] buffer_out       pointer to the updated buffer
- * @param [in] length           length of the buffer to perform data whitnening
- *
- */
-void perform_data_whitening( uint16_t seed, const uint8_t* buffer_in, uint8_t* buffer_out, uint16_t length );
-
-/**
- * compute crc16
- *
- *
- * @param [in] context          buffer on which crc16 needed to be calculated
- * @param [in] command          length of the buffer that is passed
- *
- * @retval status     calculated crc16 value
- */
-uint16_t compute_crc16( const uint8_t* buffer, uint16_t length );
-
-/**
- * compute crc32
- *
- *
- * @param [in] context          buffer on which crc32 needed to be calculated
- * @param [in] command          length of the buffer that is passed
- *
- * @retval status     calculated crc32 value
- */
-uint32_t compute_crc32( const uint8_t* buffer, uint16_t length );
-
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,8 @@
 
 #include <sid_pal_delay_ifc.h>
 #include <sid_pal_serial_bus_ifc.h>
+#include <semtech_bus.h>
+#include <semtech_busy.h>
 
 #include "halo_lr1110_radio.h"
 #include "lr1110_radio.h"
@@ -28,23 +30,14 @@
 #define SEMTECH_STDBY_STATE_DELAY_US       10
 #define SEMTECH_MAX_WAIT_ON_BUSY_CNT_US    40000
 
+static const uint8_t lr1110_nop = 0;
+
 static sid_error_t lr1110_wait_on_busy(const halo_drv_semtech_ctx_t *drv_ctx)
 {
     assert(drv_ctx);
 
-    uint8_t is_radio_busy = 0;
-    uint16_t cnt = 0;
-    sid_error_t err = SID_ERROR_NONE;
-
-    while (cnt++ < SEMTECH_MAX_WAIT_ON_BUSY_CNT_US) {
-        err = sid_pal_gpio_read(drv_ctx->config->gpios.radio_busy, &is_radio_busy);
-        if ((err == SID_ERROR_NONE) && !is_radio_busy) {
-           break;
-        }
-        sid_pal_delay_us(SEMTECH_STDBY_STATE_DELAY_US);
-    }
-
-    if (cnt >= SEMTECH_MAX_WAIT_ON_BUSY_CNT_US) {
+    if (semtech_busy_wait(drv_ctx->config->gpios.radio_busy,
+          SEMTECH_MAX_WAIT_ON_BUSY_CNT_US * SEMTECH_STDBY_STATE_DELAY_US) != SID_ERROR_NONE) {
         return SID_ERROR_BUSY;
     }
     return SID_ERROR_NONE;
@@ -74,23 +67,30 @@ static lr1110_hal_status_t lr1110_hal_rdwr(const halo_drv_semtech_ctx_t* cctx,
     }
 #endif
 
-    size_t size = command_length;
-    uint8_t *buff = (void*)command;
+    /* Stat1 and Stat2 are clocked out while the command is sent */
+    uint8_t stat[2] = {0};
+    size_t stat_len = (command_length < sizeof(stat)) ? command_length : sizeof(stat);
+    struct sid_pal_serial_bus_buf bufs[3];
+    size_t count = 0;
+
+    bufs[count++] = (struct sid_pal_serial_bus_buf){ .tx = command, .rx = stat, .len = stat_len };
+    if (command_length > stat_len) {
+        bufs[count++] = (struct sid_pal_serial_bus_buf){ .tx = &command[stat_len],
+                                                         .len = command_length - stat_len };
+    }
     if (!read && data_length > 0) {
-        buff  = ctx->config->internal_buffer.p;
-        size += data_length;
-        memcpy(buff                 , command, command_length);
-        memcpy(&buff[command_length], data,    data_length);
+        bufs[count++] = (struct sid_pal_serial_bus_buf){ .tx = data, .len = data_length };
     }
 
-    uint8_t *empty = &ctx->config->internal_buffer.p[size];
-    int err = ctx->bus_iface->xfer(ctx->bus_iface, &ctx->config->bus_selector, buff, empty, size);
+    sid_error_t err = semtech_bus_xfer(ctx->bus_iface, &ctx->config->bus_selector,
+                                       ctx->config->internal_buffer.p,
+                                       ctx->config->internal_buffer.size, bufs, count);
     if (err != SID_ERROR_NONE) {
         return LR1110_HAL_STATUS_ERROR;
     }
 
-    ctx->last.stat1 = empty[0];
-    ctx->last.stat2 = empty[1];
+    ctx->last.stat1 = stat[0];
+    ctx->last.stat2 = stat[1];
     if (!(ctx->last.stat1 & STATUS_OK_MASK) && ctx->last.command) {
         SID_HAL_LOG_WARNING("LR1110: Command 0x%.4X failed; Stat1 0x%.2X", ctx->last.command, ctx->last.stat1);
     }
@@ -99,7 +99,7 @@ static lr1110_hal_status_t lr1110_hal_rdwr(const halo_drv_semtech_ctx_t* cctx,
 
 #ifdef LOCAL_DEBUG
     SID_HAL_LOG_INFO("Read back");
-    SID_HAL_LOG_HEXDUMP_INFO(empty, size);
+    SID_HAL_LOG_HEXDUMP_INFO(stat, sizeof(stat));
 #endif
 
     if (!read) {
@@ -110,27 +110,30 @@ static lr1110_hal_status_t lr1110_hal_rdwr(const halo_drv_semtech_ctx_t* cctx,
         return LR1110_HAL_STATUS_ERROR;
     }
 
-    size = data_length + 1;
-    buff = ctx->config->internal_buffer.p;
-    empty = &buff[size];
-    memset(buff, 0, size*2);
-    err = ctx->bus_iface->xfer(ctx->bus_iface, &ctx->config->bus_selector, empty, buff, size);
+    /* The response is read in place, NOPs are sent meanwhile */
+    memset(data, 0, data_length);
+    struct sid_pal_serial_bus_buf rsp[] = {
+        { .tx = &lr1110_nop, .rx = stat, .len = 1 },
+        { .tx = data, .rx = data, .len = data_length },
+    };
+
+    err = semtech_bus_xfer(ctx->bus_iface, &ctx->config->bus_selector,
+                           ctx->config->internal_buffer.p,
+                           ctx->config->internal_buffer.size, rsp, sizeof(rsp) / sizeof(rsp[0]));
     if (err != SID_ERROR_NONE) {
         return LR1110_HAL_STATUS_ERROR;
     }
 
-    ctx->last.stat1 = buff[0];
+    ctx->last.stat1 = stat[0];
     if (!(ctx->last.stat1 & STATUS_OK_MASK) && ctx->last.command) {
         SID_HAL_LOG_WARNING("LR1110: Command rsp 0x%.4X failed; Stat1 0x%.2X", ctx->last.command, ctx->last.stat1);
     }
 
 #ifdef LOCAL_DEBUG
     SID_HAL_LOG_INFO("Data");
-    SID_HAL_LOG_HEXDUMP_INFO(buff, size);
+    SID_HAL_LOG_HEXDUMP_INFO(data, data_length);
 #endif
 
-    memcpy(data, &buff[1], data_length);
-
     return LR1110_HAL_STATUS_OK;
 }
 
@@ -19,6 +19,8 @@
 #include <sid_time_ops.h>
 #include <sid_clock_ifc.h>
 #include <sid_pal_delay_ifc.h>
+#include <semtech_busy.h>
+#include <semtech_radio_scan.h>
 
 #define LR1110_DEFAULT_LORA_IRQ_MASK       (LR1110_SYSTEM_IRQ_ALL_MASK & ~(LR1110_SYSTEM_IRQ_PREAMBLE_DETECTED | \
                                             LR1110_SYSTEM_IRQ_SYNC_WORD_HEADER_VALID))
@@ -78,6 +80,7 @@ static int32_t radio_lr1110_platform_init(void)
             SID_PAL_GPIO_DIRECTION_INPUT) != SID_ERROR_NONE) {
             goto ret;
         }
+        semtech_busy_init(drv_ctx.config->gpios.radio_busy);
     }
 
     if (drv_ctx.config->gpios.tx_bypass != HALO_GPIO_NOT_CONNECTED) {
@@ -1068,11 +1071,11 @@ int32_t sid_pal_radio_is_channel_free(uint32_t freq, int16_t threshold, uint32_t
 
 enable_irq:
 
+    // Do not update err on success of the function calls below
     if ((irq_err = sid_pal_radio_standby()) != RADIO_ERROR_NONE) {
         err = irq_err;
     }
 
-    // Do not update err on success of the function calls below
     if ((irq_err = radio_enable_irq(&drv_ctx)) != RADIO_ERROR_NONE) {
         err = irq_err;
         goto ret;
@@ -1155,6 +1158,74 @@ ret:
     return err;
 }
 
+static int32_t radio_scan_tune(uint32_t freq)
+{
+    int32_t err;
+
+    // Image calibration of a new band is done in standby
+    if (drv_ctx.radio_state != SID_PAL_RADIO_RX ||
+        lr1110_get_freq_band(freq) != lr1110_get_freq_band(drv_ctx.radio_freq_hz)) {
+        if ((err = sid_pal_radio_standby()) != RADIO_ERROR_NONE) {
+            return err;
+        }
+
+        if ((err = sid_pal_radio_set_frequency(freq)) != RADIO_ERROR_NONE) {
+            return err;
+        }
+
+        return sid_pal_radio_start_continuous_rx();
+    }
+
+    if (lr1110_radio_set_rf_freq(&drv_ctx, freq) != LR1110_STATUS_OK) {
+        return RADIO_ERROR_HARDWARE_ERROR;
+    }
+    drv_ctx.radio_freq_hz = freq;
+
+    // Restart the reception on the new frequency
+    if (lr1110_radio_set_rx_with_timeout_in_rtc_step(&drv_ctx, LR1110_RX_CONTINUOUS_VAL)
+            != LR1110_STATUS_OK) {
+        return RADIO_ERROR_HARDWARE_ERROR;
+    }
+
+    return RADIO_ERROR_NONE;
+}
+
+int32_t semtech_radio_scan_channels(const uint32_t *freqs, size_t count,
+                                    const struct semtech_radio_scan_plan *plan,
+                                    struct semtech_radio_scan_result *results)
+{
+    static const struct semtech_radio_scan_ops scan_ops = {
+        .tune = radio_scan_tune,
+        .rssi = sid_pal_radio_rssi,
+    };
+    int32_t err, irq_err;
+
+    if ((err = semtech_radio_scan_check(freqs, count, plan, results)) != RADIO_ERROR_NONE) {
+        return err;
+    }
+
+    if (drv_ctx.radio_state != SID_PAL_RADIO_STANDBY) {
+        return RADIO_ERROR_INVALID_STATE;
+    }
+
+    if ((err = radio_disable_irq(&drv_ctx)) != RADIO_ERROR_NONE) {
+        return err;
+    }
+
+    err = semtech_radio_scan_run(&scan_ops, freqs, count, plan, results);
+
+    // Do not update err on success of the function calls below
+    if ((irq_err = sid_pal_radio_standby()) != RADIO_ERROR_NONE) {
+        err = irq_err;
+    }
+
+    if ((irq_err = radio_enable_irq(&drv_ctx)) != RADIO_ERROR_NONE) {
+        err = irq_err;
+    }
+
+    return err;
+}
+
 int32_t sid_pal_radio_get_radio_state_transition_delays(sid_pal_radio_state_transition_timings_t *state_delay)
 {
     *state_delay = drv_ctx.config->state_timings;
@@ -1295,5 +1366,8 @@ int32_t sid_pal_radio_init(sid_pal_radio_event_notify_t notify, sid_pal_radio_ir
 
 int32_t sid_pal_radio_deinit(void)
 {
+    if (drv_ctx.config != NULL && drv_ctx.config->gpios.radio_busy != HALO_GPIO_NOT_CONNECTED) {
+        semtech_busy_deinit(drv_ctx.config->gpios.radio_busy);
+    }
     return RADIO_ERROR_NONE;
 }
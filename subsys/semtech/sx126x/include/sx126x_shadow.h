@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sx126x_shadow.h
+ *  @brief Shadow of the SX126x configuration written over SPI.
+ */
+
+#ifndef SX126X_SHADOW_H
+#define SX126X_SHADOW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Configuration commands tracked by the shadow.
+ */
+enum sx126x_shadow_cmd {
+	SX126X_SHADOW_DIO_IRQ_PARAMS,
+	SX126X_SHADOW_RF_FREQUENCY,
+	SX126X_SHADOW_PKT_TYPE,
+	SX126X_SHADOW_MOD_PARAMS,
+	SX126X_SHADOW_PKT_PARAMS,
+	SX126X_SHADOW_TX_PARAMS,
+	SX126X_SHADOW_PA_CONFIG,
+	SX126X_SHADOW_GFSK_SYNC_WORD,
+	SX126X_SHADOW_LORA_SYNC_WORD,
+	SX126X_SHADOW_CMD_COUNT,
+};
+
+/**
+ * @brief Statistics of the tracked commands.
+ */
+struct sx126x_shadow_stats {
+	/** Commands sent to the radio. */
+	uint32_t written[SX126X_SHADOW_CMD_COUNT];
+	/** Commands skipped, because the radio already had the same configuration. */
+	uint32_t elided[SX126X_SHADOW_CMD_COUNT];
+	/** Number of times the whole shadow was dropped. */
+	uint32_t invalidations;
+};
+
+/**
+ * @brief Check if the write would not change the radio configuration.
+ *
+ * Always false without CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW.
+ *
+ * @param command command buffer, opcode first.
+ * @param command_length size of the command buffer.
+ * @param data data written after the command, may be NULL.
+ * @param data_length size of the data.
+ * @return true if the radio already has the configuration and the write can be skipped.
+ */
+bool sx126x_shadow_match(const uint8_t *command, uint16_t command_length, const uint8_t *data,
+			 uint16_t data_length);
+
+/**
+ * @brief Record a write sent to the radio.
+ *
+ * @param command command buffer, opcode first.
+ * @param command_length size of the command buffer.
+ * @param data data written after the command, may be NULL.
+ * @param data_length size of the data.
+ * @param written true if the radio accepted the write. The shadow of a failed write is dropped.
+ */
+void sx126x_shadow_store(const uint8_t *command, uint16_t command_length, const uint8_t *data,
+			 uint16_t data_length, bool written);
+
+/**
+ * @brief Drop the whole shadow.
+ *
+ * Called when the radio may have lost its configuration: reset, sleep and wakeup.
+ */
+void sx126x_shadow_invalidate(void);
+
+/**
+ * @brief Get the statistics of the tracked commands.
+ *
+ * @param stats [out] statistics since boot or the last reset.
+ */
+void sx126x_shadow_stats_get(struct sx126x_shadow_stats *stats);
+
+/**
+ * @brief Reset the statistics of the tracked commands.
+ */
+void sx126x_shadow_stats_reset(void);
+
+#endif /* SX126X_SHADOW_H */
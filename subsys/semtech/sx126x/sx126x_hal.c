@@ -14,6 +14,7 @@
 
 #include <sx126x.h>
 #include <sx126x_radio.h>
+#include <sx126x_shadow.h>
 
 #ifdef MARS_SPI_BUS_WORKAROUND
 #include "board_hal.h"
@@ -131,6 +132,7 @@ sx126x_hal_status_t sx126x_hal_reset(const void *ctx)
 
         drv_ctx = (halo_drv_semtech_ctx_t *)ctx;
 
+        sx126x_shadow_invalidate();
         sid_pal_delay_us(10*1000);
         err = RADIO_ERROR_HARDWARE_ERROR;
         if (sid_pal_gpio_set_direction(drv_ctx->config->gpio_power,
@@ -163,6 +165,8 @@ sx126x_hal_status_t sx126x_hal_wakeup(const void *context)
 
     sid_pal_enter_critical_region();
 
+    sx126x_shadow_invalidate();
+
     /* wake up the gpio driver */
     set_gpio_cfg_awake(drv_ctx);
 
@@ -240,7 +244,15 @@ sx126x_hal_status_t sx126x_hal_write(const void* context, const uint8_t* command
             break;
         }
 
-        if (sx126x_hal_rdwr(context, command, command_length, (uint8_t *)data, data_length, false) != RADIO_ERROR_NONE) {
+        // Skip the transfer if the radio already has this configuration
+        if (sx126x_shadow_match(command, command_length, data, data_length)) {
+            status = SX126X_STATUS_OK;
+            break;
+        }
+
+        bool written = sx126x_hal_rdwr(context, command, command_length, (uint8_t *)data, data_length, false) == RADIO_ERROR_NONE;
+        sx126x_shadow_store(command, command_length, data, data_length, written);
+        if (!written) {
             break;
         }
         status = SX126X_STATUS_OK;
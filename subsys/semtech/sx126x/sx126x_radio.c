@@ -12,6 +12,9 @@
 #include <sid_pal_delay_ifc.h>
 #include <sid_time_ops.h>
 #include <sid_time_types.h>
+#include <semtech_bus.h>
+#include <semtech_busy.h>
+#include <semtech_radio_scan.h>
 
 #ifdef MARS_SPI_BUS_WORKAROUND
 #include "board_hal.h"
@@ -71,6 +74,7 @@ static int32_t radio_sx126x_platform_init(void)
             SID_PAL_GPIO_DIRECTION_INPUT) != SID_ERROR_NONE) {
             goto ret;
         }
+        semtech_busy_init(drv_ctx.config->gpio_radio_busy);
     }
 
     if (drv_ctx.config->gpio_tx_bypass != HALO_GPIO_NOT_CONNECTED) {
@@ -155,17 +159,6 @@ static int32_t radio_disable_irq(void)
     return RADIO_ERROR_NONE;
 }
 
-static int32_t sx126x_check_status(void)
-{
-    uint8_t is_radio_busy;
-    if (sid_pal_gpio_read(drv_ctx.config->gpio_radio_busy,
-                          &is_radio_busy) != SID_ERROR_NONE) {
-        return RADIO_ERROR_HARDWARE_ERROR;
-    }
-
-    return is_radio_busy ? RADIO_ERROR_BUSY: RADIO_ERROR_NONE;
-}
-
 static int32_t radio_set_modem_to_lora_mode(void)
 {
     if (sx126x_set_pkt_type(&drv_ctx, SX126X_PKT_TYPE_LORA) != SX126X_STATUS_OK) {
@@ -243,17 +236,8 @@ const halo_drv_semtech_ctx_t* sx126x_get_drv_ctx(void)
 
 int32_t sx126x_wait_on_busy(void)
 {
-    uint16_t cnt = 0;
-
-    while(cnt++ < SEMTECH_MAX_WAIT_ON_BUSY_CNT_US) {
-        if (sx126x_check_status() == RADIO_ERROR_NONE) {
-            break;
-        }
-
-        sid_pal_delay_us(SEMTECH_STDBY_STATE_DELAY_US);
-    }
-
-    if (cnt >= SEMTECH_MAX_WAIT_ON_BUSY_CNT_US) {
+    if (semtech_busy_wait(drv_ctx.config->gpio_radio_busy,
+          SEMTECH_MAX_WAIT_ON_BUSY_CNT_US * SEMTECH_STDBY_STATE_DELAY_US) != SID_ERROR_NONE) {
         return RADIO_ERROR_HARDWARE_ERROR;
     }
 
@@ -268,7 +252,7 @@ void set_lora_exit_mode(sid_pal_radio_cad_param_exit_mode_t cad_exit_mode)
 int32_t sx126x_radio_bus_xfer(const uint8_t *cmd_buffer, uint16_t cmd_buffer_size, uint8_t *buffer,
                                    uint16_t size, uint8_t read_offset)
 {
-
+#if MARS_SPI_BUS_WORKAROUND
     if (drv_ctx.config->internal_buffer.p == NULL || cmd_buffer == NULL) {
         return RADIO_ERROR_INVALID_PARAMS;
     }
@@ -286,11 +270,7 @@ int32_t sx126x_radio_bus_xfer(const uint8_t *cmd_buffer, uint16_t cmd_buffer_siz
 
     if (bus_iface->xfer(bus_iface, &drv_ctx.config->bus_selector,
         drv_ctx.config->internal_buffer.p,
-#if MARS_SPI_BUS_WORKAROUND
         &drv_ctx.config->internal_buffer.p[read_offset? read_offset: 0],
-#else
-        drv_ctx.config->internal_buffer.p,
-#endif
         size + cmd_buffer_size) != SID_ERROR_NONE) {
         return RADIO_ERROR_IO_ERROR;
     }
@@ -300,6 +280,30 @@ int32_t sx126x_radio_bus_xfer(const uint8_t *cmd_buffer, uint16_t cmd_buffer_siz
     }
 
     return RADIO_ERROR_NONE;
+#else
+    if (cmd_buffer == NULL || (read_offset != 0 && read_offset != cmd_buffer_size)) {
+        return RADIO_ERROR_INVALID_PARAMS;
+    }
+
+    /* Command and data go straight from and to the caller buffers */
+    struct sid_pal_serial_bus_buf bufs[] = {
+        { .tx = cmd_buffer, .rx = NULL, .len = cmd_buffer_size },
+        { .tx = read_offset ? NULL : buffer, .rx = read_offset ? buffer : NULL, .len = size },
+    };
+    size_t count = (buffer != NULL && size > 0) ? 2 : 1;
+
+    sid_error_t err = semtech_bus_xfer(drv_ctx.bus_iface, &drv_ctx.config->bus_selector,
+                                       drv_ctx.config->internal_buffer.p,
+                                       drv_ctx.config->internal_buffer.size, bufs, count);
+    if (err == SID_ERROR_OOM) {
+        return RADIO_ERROR_NOMEM;
+    }
+    if (err != SID_ERROR_NONE) {
+        return RADIO_ERROR_IO_ERROR;
+    }
+
+    return RADIO_ERROR_NONE;
+#endif /* MARS_SPI_BUS_WORKAROUND */
 }
 
 int32_t radio_sx126x_set_radio_mode(bool rf_en, bool tx_en)
@@ -1233,6 +1237,73 @@ ret:
     return err;
 }
 
+static int32_t radio_scan_tune(uint32_t freq)
+{
+    int32_t err;
+
+    // Image calibration of a new band is done in standby
+    if (drv_ctx.radio_state != SID_PAL_RADIO_RX ||
+        sx126x_get_freq_band(freq) != sx126x_get_freq_band(drv_ctx.radio_freq_hz)) {
+        if ((err = sid_pal_radio_standby()) != RADIO_ERROR_NONE) {
+            return err;
+        }
+
+        if ((err = sid_pal_radio_set_frequency(freq)) != RADIO_ERROR_NONE) {
+            return err;
+        }
+
+        return sid_pal_radio_start_continuous_rx();
+    }
+
+    if (sx126x_set_rf_freq(&drv_ctx, freq) != SX126X_STATUS_OK) {
+        return RADIO_ERROR_HARDWARE_ERROR;
+    }
+    drv_ctx.radio_freq_hz = freq;
+
+    // Restart the reception on the new frequency
+    if (sx126x_set_rx(&drv_ctx, SX126X_RX_CONTINUOUS_VAL) != SX126X_STATUS_OK) {
+        return RADIO_ERROR_HARDWARE_ERROR;
+    }
+
+    return RADIO_ERROR_NONE;
+}
+
+int32_t semtech_radio_scan_channels(const uint32_t *freqs, size_t count,
+                                    const struct semtech_radio_scan_plan *plan,
+                                    struct semtech_radio_scan_result *results)
+{
+    static const struct semtech_radio_scan_ops scan_ops = {
+        .tune = radio_scan_tune,
+        .rssi = sid_pal_radio_rssi,
+    };
+    int32_t err, irq_err;
+
+    if ((err = semtech_radio_scan_check(freqs, count, plan, results)) != RADIO_ERROR_NONE) {
+        return err;
+    }
+
+    if (drv_ctx.radio_state != SID_PAL_RADIO_STANDBY) {
+        return RADIO_ERROR_INVALID_STATE;
+    }
+
+    if ((err = radio_disable_irq()) != RADIO_ERROR_NONE) {
+        return err;
+    }
+
+    err = semtech_radio_scan_run(&scan_ops, freqs, count, plan, results);
+
+    // Do not update err on success of the function calls below
+    if ((irq_err = sid_pal_radio_standby()) != RADIO_ERROR_NONE) {
+        err = irq_err;
+    }
+
+    if ((irq_err = radio_enable_irq()) != RADIO_ERROR_NONE) {
+        err = irq_err;
+    }
+
+    return err;
+}
+
 int32_t sid_pal_radio_get_radio_state_transition_delays(sid_pal_radio_state_transition_timings_t *state_delay)
 {
     *state_delay = drv_ctx.config->state_timings;
@@ -1360,5 +1431,8 @@ int32_t sid_pal_radio_init(sid_pal_radio_event_notify_t notify, sid_pal_radio_ir
 
 int32_t sid_pal_radio_deinit(void)
 {
+    if (drv_ctx.config != NULL && drv_ctx.config->gpio_radio_busy != HALO_GPIO_NOT_CONNECTED) {
+        semtech_busy_deinit(drv_ctx.config->gpio_radio_busy);
+    }
     return RADIO_ERROR_NONE;
 }
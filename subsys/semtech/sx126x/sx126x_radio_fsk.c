@@ -151,20 +151,30 @@ int32_t radio_fsk_process_rx_done(halo_drv_semtech_ctx_t *drv_ctx, radio_fsk_rx_
             break;
         }
 
-        if (phy_hdr.is_data_whitening_enabled) {
-            perform_data_whitening(SX126X_FSK_WHITENING_SEED, buffer, buffer, length_temp);
-        }
-
+        // dewhitening and CRC are done in a single pass over the buffer
         switch( phy_hdr.fcs_type ) {
             case RADIO_FSK_FCS_TYPE_0:
                 crc_length = sizeof(uint32_t);
-                crc        = compute_crc32(buffer, length_temp - crc_length);
+                if (phy_hdr.is_data_whitening_enabled) {
+                    crc = semtech_fsk_dewhiten_crc32(SX126X_FSK_WHITENING_SEED, buffer, length_temp,
+                                                     length_temp - crc_length);
+                } else {
+                    crc = compute_crc32(buffer, length_temp - crc_length);
+                }
                 break;
             case RADIO_FSK_FCS_TYPE_1:
                 crc_length = sizeof(uint16_t);
-                crc        = compute_crc16(buffer, length_temp - crc_length);
+                if (phy_hdr.is_data_whitening_enabled) {
+                    crc = semtech_fsk_dewhiten_crc16(SX126X_FSK_WHITENING_SEED, buffer, length_temp,
+                                                     length_temp - crc_length);
+                } else {
+                    crc = compute_crc16(buffer, length_temp - crc_length);
+                }
                 break;
             default:
+                if (phy_hdr.is_data_whitening_enabled) {
+                    perform_data_whitening(SX126X_FSK_WHITENING_SEED, buffer, buffer, length_temp);
+                }
                 radio_rx_packet->payload_len = 0;
                 err = RADIO_ERROR_GENERIC;
                 *rx_done_status = RADIO_FSK_RX_DONE_STATUS_UNKNOWN_ERROR;
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file sx126x_shadow.c
+ *  @brief Skip SX126x configuration commands that repeat the last written value.
+ */
+
+#include <sx126x_shadow.h>
+
+#include <sx126x.h>
+#include <sx126x_regs.h>
+
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+/* The longest tracked write is the 8 byte GFSK sync word after the register address */
+#define SHADOW_ENTRY_MAX_SIZE (SX126X_SIZE_WRITE_REGISTER + 8)
+
+struct shadow_entry {
+	/* Zero if the value on the radio is unknown */
+	uint8_t len;
+	uint8_t value[SHADOW_ENTRY_MAX_SIZE];
+};
+
+static struct sx126x_shadow_stats shadow_stats;
+
+#if CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW
+static struct shadow_entry shadow[SX126X_SHADOW_CMD_COUNT];
+#endif /* CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW */
+
+static enum sx126x_shadow_cmd shadow_cmd_get(const uint8_t *command, uint16_t command_length)
+{
+	uint16_t addr;
+
+	switch (command[0]) {
+	case SX126X_SET_DIOIRQPARAMS:
+		return SX126X_SHADOW_DIO_IRQ_PARAMS;
+	case SX126X_SET_RFFREQUENCY:
+		return SX126X_SHADOW_RF_FREQUENCY;
+	case SX126X_SET_PACKETTYPE:
+		return SX126X_SHADOW_PKT_TYPE;
+	case SX126X_SET_MODULATIONPARAMS:
+		return SX126X_SHADOW_MOD_PARAMS;
+	case SX126X_SET_PACKETPARAMS:
+		return SX126X_SHADOW_PKT_PARAMS;
+	case SX126X_SET_TXPARAMS:
+		return SX126X_SHADOW_TX_PARAMS;
+	case SX126X_SET_PACONFIG:
+		return SX126X_SHADOW_PA_CONFIG;
+	case SX126X_WRITE_REGISTER:
+		if (command_length < SX126X_SIZE_WRITE_REGISTER) {
+			break;
+		}
+		addr = ((uint16_t)command[1] << 8) | command[2];
+		if (addr == SX126X_REG_SYNCWORDBASEADDRESS) {
+			return SX126X_SHADOW_GFSK_SYNC_WORD;
+		}
+		if (addr == SX126X_REG_LR_SYNCWORD) {
+			return SX126X_SHADOW_LORA_SYNC_WORD;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return SX126X_SHADOW_CMD_COUNT;
+}
+
+#if CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW
+static void shadow_entry_drop(enum sx126x_shadow_cmd cmd)
+{
+	shadow[cmd].len = 0;
+}
+
+static void shadow_entry_set(enum sx126x_shadow_cmd cmd, const uint8_t *command,
+			     uint16_t command_length, const uint8_t *data, uint16_t data_length)
+{
+	struct shadow_entry *entry = &shadow[cmd];
+
+	if (command_length + data_length > sizeof(entry->value)) {
+		shadow_entry_drop(cmd);
+		return;
+	}
+
+	memcpy(entry->value, command, command_length);
+	if (data_length) {
+		memcpy(&entry->value[command_length], data, data_length);
+	}
+	entry->len = command_length + data_length;
+}
+
+static bool shadow_entry_equal(enum sx126x_shadow_cmd cmd, const uint8_t *command,
+			       uint16_t command_length, const uint8_t *data, uint16_t data_length)
+{
+	const struct shadow_entry *entry = &shadow[cmd];
+
+	if (entry->len == 0 || entry->len != command_length + data_length) {
+		return false;
+	}
+
+	return memcmp(entry->value, command, command_length) == 0 &&
+	       (data_length == 0 || memcmp(&entry->value[command_length], data, data_length) == 0);
+}
+#endif /* CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW */
+
+bool sx126x_shadow_match(const uint8_t *command, uint16_t command_length, const uint8_t *data,
+			 uint16_t data_length)
+{
+#if CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW
+	enum sx126x_shadow_cmd cmd;
+
+	if (command == NULL || command_length == 0 || (data == NULL && data_length)) {
+		return false;
+	}
+
+	cmd = shadow_cmd_get(command, command_length);
+	if (cmd == SX126X_SHADOW_CMD_COUNT ||
+	    !shadow_entry_equal(cmd, command, command_length, data, data_length)) {
+		return false;
+	}
+
+	shadow_stats.elided[cmd]++;
+	return true;
+#else
+	ARG_UNUSED(command);
+	ARG_UNUSED(command_length);
+	ARG_UNUSED(data);
+	ARG_UNUSED(data_length);
+
+	return false;
+#endif /* CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW */
+}
+
+void sx126x_shadow_store(const uint8_t *command, uint16_t command_length, const uint8_t *data,
+			 uint16_t data_length, bool written)
+{
+	enum sx126x_shadow_cmd cmd;
+
+	if (command == NULL || command_length == 0 || (data == NULL && data_length)) {
+		return;
+	}
+
+	if (command[0] == SX126X_SET_SLEEP) {
+		sx126x_shadow_invalidate();
+		return;
+	}
+
+	cmd = shadow_cmd_get(command, command_length);
+	if (cmd == SX126X_SHADOW_CMD_COUNT) {
+		return;
+	}
+
+	if (written) {
+		shadow_stats.written[cmd]++;
+	}
+
+#if CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW
+	if (cmd == SX126X_SHADOW_PKT_TYPE) {
+		/* Modulation and packet parameters are interpreted for the packet type */
+		shadow_entry_drop(SX126X_SHADOW_MOD_PARAMS);
+		shadow_entry_drop(SX126X_SHADOW_PKT_PARAMS);
+		shadow_entry_drop(SX126X_SHADOW_GFSK_SYNC_WORD);
+		shadow_entry_drop(SX126X_SHADOW_LORA_SYNC_WORD);
+	}
+
+	if (written) {
+		shadow_entry_set(cmd, command, command_length, data, data_length);
+	} else {
+		shadow_entry_drop(cmd);
+	}
+#endif /* CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW */
+}
+
+void sx126x_shadow_invalidate(void)
+{
+#if CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW
+	memset(shadow, 0, sizeof(shadow));
+#endif /* CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW */
+	shadow_stats.invalidations++;
+}
+
+void sx126x_shadow_stats_get(struct sx126x_shadow_stats *stats)
+{
+	if (stats) {
+		*stats = shadow_stats;
+	}
+}
+
+void sx126x_shadow_stats_reset(void)
+{
+	memset(&shadow_stats, 0, sizeof(shadow_stats));
+}
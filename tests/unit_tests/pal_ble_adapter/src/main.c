@@ -17,6 +17,8 @@
 #include <cmock_sid_ble_connection.h>
 #include <cmock_sid_ble_adapter_callbacks.h>
 #include <cmock_sid_ble_service.h>
+#include <cmock_sid_ble_link_quality.h>
+#include <sid_ble_adapter.h>
 #include <errno.h>
 #include <bt_app_callbacks.h>
 
@@ -107,6 +109,7 @@ typedef struct {
 
 static sid_ble_config_t test_ble_cfg;
 static data_callback_test_t data_cb_test;
+static struct bt_gatt_attr test_notify_attr;
 
 void setUp(void)
 {
@@ -115,6 +118,11 @@ void setUp(void)
 	memset(&data_cb_test, 0x00, sizeof(data_cb_test));
 	cmock_sid_ble_adapter_callbacks_Init();
 	cmock_sid_ble_advert_Init();
+	__cmock_sid_ble_srv_notify_attr_get_IgnoreAndReturn(&test_notify_attr);
+	__cmock_sid_ble_adapter_notification_enabled_IgnoreAndReturn(true);
+	__cmock_sid_ble_conn_activity_Ignore();
+	__cmock_sid_ble_lq_init_Ignore();
+	__cmock_sid_ble_lq_deinit_Ignore();
 }
 
 void tearDown(void)
@@ -382,6 +390,35 @@ void test_ble_adapter_send_data_unsupported(void)
 			  p_test_ble_ifc->send(FAKE_SERVICE, data, sizeof(data)));
 }
 
+void test_ble_adapter_send_stats(void)
+{
+	struct sid_ble_send_stats notify = {
+		.sent = 30, .bytes = 6000, .conn_events = 20, .active_ms = 500
+	};
+	struct sid_ble_adapter_send_stats stats;
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NULL_POINTER, sid_ble_adapter_send_stats_get(NULL));
+
+	__cmock_sid_ble_send_stats_get_ExpectAnyArgs();
+	__cmock_sid_ble_send_stats_get_ReturnMemThruPtr_stats(&notify, sizeof(notify));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_ble_adapter_send_stats_get(&stats));
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_TX_QUEUE_DEPTH, stats.queue_depth);
+	TEST_ASSERT_EQUAL(30, stats.notify.sent);
+	TEST_ASSERT_EQUAL(12000, stats.throughput);
+	TEST_ASSERT_EQUAL(150, stats.per_conn_event_x100);
+
+	/* Nothing sent yet */
+	notify = (struct sid_ble_send_stats){ 0 };
+	__cmock_sid_ble_send_stats_get_ExpectAnyArgs();
+	__cmock_sid_ble_send_stats_get_ReturnMemThruPtr_stats(&notify, sizeof(notify));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_ble_adapter_send_stats_get(&stats));
+	TEST_ASSERT_EQUAL(0, stats.throughput);
+	TEST_ASSERT_EQUAL(0, stats.per_conn_event_x100);
+
+	__cmock_sid_ble_send_stats_reset_Expect();
+	sid_ble_adapter_send_stats_reset();
+}
+
 void test_ble_adapter_disconnect(void)
 {
 	sid_pal_ble_adapter_interface_t p_test_ble_ifc;
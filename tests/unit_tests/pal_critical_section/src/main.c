@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <sid_critical_section.h>
+#include <sid_pal_critical_region_ifc.h>
+
+#include <zephyr/kernel.h>
+#include <errno.h>
+#include <string.h>
+
+#define HOLD_US 200
+
+static SID_CRITICAL_SECTION_DEFINE(section_a, "a");
+static SID_CRITICAL_SECTION_DEFINE(section_b, "b");
+
+static struct sid_critical_section_stats stats_find(const char *section_name)
+{
+	struct sid_critical_section_stats stats;
+	const char *name;
+
+	for (size_t i = 0; sid_critical_section_stats_get(i, &name, &stats) == 0; i++) {
+		if (strcmp(name, section_name) == 0) {
+			return stats;
+		}
+	}
+
+	TEST_FAIL_MESSAGE("section not registered");
+	return stats;
+}
+
+static void section_hold(struct sid_critical_section *section, uint32_t hold_us)
+{
+	sid_critical_section_key_t key = sid_critical_section_enter(section);
+
+	k_busy_wait(hold_us);
+	sid_critical_section_exit(section, key);
+}
+
+void setUp(void)
+{
+	sid_critical_section_stats_reset();
+}
+
+/******************************************************************
+* sid_critical_section
+* ****************************************************************/
+
+void test_section_stats(void)
+{
+	struct sid_critical_section_stats stats;
+
+	section_hold(&section_a, HOLD_US);
+	section_hold(&section_a, 2 * HOLD_US);
+
+	stats = stats_find("a");
+	TEST_ASSERT_EQUAL(2, stats.count);
+	TEST_ASSERT_UINT32_WITHIN(k_us_to_cyc_ceil32(HOLD_US / 2), k_us_to_cyc_ceil32(2 * HOLD_US),
+				  stats.max_cycles);
+	TEST_ASSERT_TRUE(stats.total_cycles >= k_us_to_cyc_floor32(3 * HOLD_US));
+	TEST_ASSERT_TRUE(stats.total_cycles >= stats.max_cycles);
+}
+
+void test_sections_independent(void)
+{
+	sid_critical_section_key_t key_a = sid_critical_section_enter(&section_a);
+	sid_critical_section_key_t key_b = sid_critical_section_enter(&section_b);
+
+	k_busy_wait(HOLD_US);
+	sid_critical_section_exit(&section_b, key_b);
+	sid_critical_section_exit(&section_a, key_a);
+	section_hold(&section_b, 0);
+
+	TEST_ASSERT_EQUAL(1, stats_find("a").count);
+	TEST_ASSERT_EQUAL(2, stats_find("b").count);
+	TEST_ASSERT_TRUE(stats_find("a").max_cycles >= stats_find("b").max_cycles);
+}
+
+void test_global_region_stats(void)
+{
+	struct sid_critical_section_stats stats;
+	const char *name;
+
+	/* Nested entries are one interrupt masked period */
+	sid_pal_enter_critical_region();
+	sid_pal_enter_critical_region();
+	k_busy_wait(HOLD_US);
+	sid_pal_exit_critical_region();
+	sid_pal_exit_critical_region();
+
+	TEST_ASSERT_EQUAL(0, sid_critical_section_stats_get(0, &name, &stats));
+	TEST_ASSERT_EQUAL_STRING("global", name);
+	TEST_ASSERT_EQUAL(1, stats.count);
+	TEST_ASSERT_TRUE(stats.max_cycles >= k_us_to_cyc_floor32(HOLD_US));
+}
+
+void test_section_in_global_region(void)
+{
+	sid_pal_enter_critical_region();
+	section_hold(&section_a, HOLD_US);
+	sid_pal_exit_critical_region();
+
+	TEST_ASSERT_EQUAL(1, stats_find("global").count);
+	TEST_ASSERT_EQUAL(1, stats_find("a").count);
+}
+
+void test_section_registered_once(void)
+{
+	struct sid_critical_section_stats stats;
+	const char *name;
+	size_t count = 0;
+
+	section_hold(&section_a, 0);
+	section_hold(&section_b, 0);
+	section_hold(&section_a, 0);
+
+	while (sid_critical_section_stats_get(count, &name, &stats) == 0) {
+		count++;
+	}
+	TEST_ASSERT_EQUAL(3, count);
+	TEST_ASSERT_EQUAL(-ENOENT, sid_critical_section_stats_get(count, &name, &stats));
+}
+
+void test_stats_reset(void)
+{
+	section_hold(&section_a, HOLD_US);
+	sid_critical_section_stats_reset();
+
+	TEST_ASSERT_EQUAL(0, stats_find("a").count);
+	TEST_ASSERT_EQUAL(0, stats_find("a").max_cycles);
+	TEST_ASSERT_EQUAL(0, stats_find("a").total_cycles);
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include <sid_pal_crypto_ifc.h>
+#include <zephyr/sys/util.h>
+
+#include "benchmark.h"
+#include "psa_fakes.h"
+
+#define AES_IV_SIZE (16)
+#define AES_TEST_DATA_BLOCK_SIZE (32)
+#define NS_PER_SECOND (1000000000ULL)
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * NS_PER_SECOND + ts.tv_nsec;
+}
+
+void benchmark_cmac(const char *name, const uint8_t (*keys)[BENCHMARK_KEY_LENGTH],
+		    size_t key_count)
+{
+	uint8_t data[AES_TEST_DATA_BLOCK_SIZE] = {};
+	uint8_t iv[AES_IV_SIZE] = {};
+	uint8_t out[AES_TEST_DATA_BLOCK_SIZE];
+	sid_pal_aes_params_t params = {
+		.algo = SID_PAL_AES_CMAC_128,
+		.mode = SID_PAL_CRYPTO_MAC_CALCULATE,
+		.key_size = BENCHMARK_KEY_LENGTH * 8,
+		.iv = iv,
+		.iv_size = sizeof(iv),
+		.in = data,
+		.in_size = sizeof(data),
+		.out = out,
+		.out_size = sizeof(out),
+	};
+	uint32_t import_count = psa_import_key_fake.call_count;
+	uint32_t destroy_count = psa_destroy_key_fake.call_count;
+	uint64_t start = now_ns();
+
+	for (int i = 0; i < BENCHMARK_OPERATIONS; i++) {
+		params.key = keys[i % key_count];
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_aes_crypt(&params));
+	}
+
+	uint64_t elapsed = MAX(now_ns() - start, 1);
+
+	import_count = psa_import_key_fake.call_count - import_count;
+	destroy_count = psa_destroy_key_fake.call_count - destroy_count;
+	printf("%s: %llu ops/s, %u imports and %u destroys for %d operations\n", name,
+	       (unsigned long long)BENCHMARK_OPERATIONS * NS_PER_SECOND / elapsed, import_count,
+	       destroy_count, BENCHMARK_OPERATIONS);
+}
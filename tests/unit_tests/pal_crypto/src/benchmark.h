@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BENCHMARK_KEY_LENGTH (16)
+#define BENCHMARK_OPERATIONS (20000)
+
+/**
+ * @brief Run AES-CMAC with the keys used round robin and print ops/s and PSA key calls.
+ *
+ * PSA calls are fakes, so ops/s shows only the overhead of sid_crypto.c itself.
+ * On hardware every import and destroy is a round trip to the crypto driver.
+ *
+ * @param name [in] name of the run.
+ * @param keys [in] AES-128 keys.
+ * @param key_count [in] number of keys.
+ */
+void benchmark_cmac(const char *name, const uint8_t (*keys)[BENCHMARK_KEY_LENGTH],
+		    size_t key_count);
+
+#endif /* BENCHMARK_H */
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <string.h>
+#include <sid_pal_crypto_ifc.h>
+#include <zephyr/sys/util.h>
+
+#include "benchmark.h"
+#include "psa_fakes.h"
+
+#define KEY_CACHE_SIZE (CONFIG_SIDEWALK_CRYPTO_KEY_CACHE_SIZE)
+
+#define AES_128_KEY_LENGTH (BENCHMARK_KEY_LENGTH)
+#define AES_128_KEY_BITS (128)
+#define AES_IV_SIZE (16)
+#define AES_TEST_DATA_BLOCK_SIZE (32)
+#define HMAC_LONG_KEY_SIZE (64)
+#define SHA256_LEN (32)
+
+static mbedtls_svc_key_id_t last_key_id;
+static int import_out_of_memory;
+static uint8_t keys[2 * KEY_CACHE_SIZE][AES_128_KEY_LENGTH];
+static uint8_t data[AES_TEST_DATA_BLOCK_SIZE];
+static uint8_t iv[AES_IV_SIZE];
+static uint8_t out[AES_TEST_DATA_BLOCK_SIZE];
+
+static psa_status_t import_key_custom_fake(const psa_key_attributes_t *attributes,
+					   const uint8_t *data, size_t data_length,
+					   mbedtls_svc_key_id_t *key)
+{
+	if (import_out_of_memory) {
+		import_out_of_memory--;
+		return PSA_ERROR_INSUFFICIENT_MEMORY;
+	}
+	*key = ++last_key_id;
+	return psa_import_key_fake.return_val;
+}
+
+static sid_error_t aes_operation(const uint8_t *key, sid_pal_aes_algo_t algo,
+				 sid_pal_aes_mode_t mode)
+{
+	sid_pal_aes_params_t params = {
+		.algo = algo,
+		.mode = mode,
+		.key = key,
+		.key_size = AES_128_KEY_BITS,
+		.iv = iv,
+		.iv_size = sizeof(iv),
+		.in = data,
+		.in_size = sizeof(data),
+		.out = out,
+		.out_size = sizeof(out),
+	};
+
+	return sid_pal_crypto_aes_crypt(&params);
+}
+
+static sid_error_t cmac(const uint8_t *key)
+{
+	return aes_operation(key, SID_PAL_AES_CMAC_128, SID_PAL_CRYPTO_MAC_CALCULATE);
+}
+
+/*************************************************************************
+* setUp & tearDown
+* ***********************************************************************/
+void setUp(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+	FFF_RESET_HISTORY();
+
+	psa_import_key_fake.custom_fake = import_key_custom_fake;
+	import_out_of_memory = 0;
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+		memset(keys[i], i + 1, sizeof(keys[i]));
+	}
+}
+
+void tearDown(void)
+{
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_deinit());
+}
+
+/*************************************************************************
+* KEY CACHE
+* ***********************************************************************/
+void test_key_cache_reuses_imported_key(void)
+{
+	for (int i = 0; i < 10; i++) {
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	}
+	TEST_ASSERT_EQUAL(1, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_destroy_key_fake.call_count);
+	TEST_ASSERT_EQUAL(10, psa_mac_compute_fake.call_count);
+	TEST_ASSERT_EQUAL(last_key_id, psa_mac_compute_fake.arg0_val);
+}
+
+void test_key_cache_policy_is_part_of_the_key(void)
+{
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  aes_operation(keys[0], SID_PAL_AES_CTR_128, SID_PAL_CRYPTO_ENCRYPT));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  aes_operation(keys[0], SID_PAL_AES_CTR_128, SID_PAL_CRYPTO_DECRYPT));
+	TEST_ASSERT_EQUAL(3, psa_import_key_fake.call_count);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  aes_operation(keys[0], SID_PAL_AES_CTR_128, SID_PAL_CRYPTO_DECRYPT));
+	TEST_ASSERT_EQUAL(3, psa_import_key_fake.call_count);
+}
+
+void test_key_cache_evicts_least_recently_used(void)
+{
+	for (size_t i = 0; i < KEY_CACHE_SIZE; i++) {
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[i]));
+	}
+	/* Use the first key again, the second one becomes the oldest. */
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	TEST_ASSERT_EQUAL(KEY_CACHE_SIZE, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_destroy_key_fake.call_count);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[KEY_CACHE_SIZE]));
+	TEST_ASSERT_EQUAL(KEY_CACHE_SIZE + 1, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(1, psa_destroy_key_fake.call_count);
+	if (KEY_CACHE_SIZE > 1) {
+		/* Handle of the second imported key. */
+		TEST_ASSERT_EQUAL(2, psa_destroy_key_fake.arg0_val);
+	}
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	TEST_ASSERT_EQUAL(KEY_CACHE_SIZE + 1, psa_import_key_fake.call_count);
+}
+
+void test_key_cache_failed_import_is_not_cached(void)
+{
+	psa_import_key_fake.return_val = PSA_ERROR_NOT_PERMITTED;
+	TEST_ASSERT_EQUAL(SID_ERROR_NO_PERMISSION, cmac(keys[0]));
+
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	TEST_ASSERT_EQUAL(2, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	TEST_ASSERT_EQUAL(2, psa_import_key_fake.call_count);
+}
+
+void test_key_cache_failed_operation_keeps_key(void)
+{
+	psa_mac_compute_fake.return_val = PSA_ERROR_BAD_STATE;
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_STATE, cmac(keys[0]));
+
+	psa_mac_compute_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	TEST_ASSERT_EQUAL(1, psa_import_key_fake.call_count);
+}
+
+void test_key_cache_long_hmac_key_is_not_cached(void)
+{
+	uint8_t key[HMAC_LONG_KEY_SIZE];
+	uint8_t digest[SHA256_LEN];
+	sid_pal_hmac_params_t params = {
+		.algo = SID_PAL_HASH_SHA256,
+		.key = key,
+		.key_size = sizeof(key),
+		.data = data,
+		.data_size = sizeof(data),
+		.digest = digest,
+		.digest_size = sizeof(digest),
+	};
+
+	memset(key, 0xA5, sizeof(key));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_hmac(&params));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_hmac(&params));
+	TEST_ASSERT_EQUAL(2, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(2, psa_destroy_key_fake.call_count);
+
+	params.key_size = SHA256_LEN;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_hmac(&params));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_hmac(&params));
+	TEST_ASSERT_EQUAL(3, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(2, psa_destroy_key_fake.call_count);
+}
+
+void test_key_cache_out_of_key_slots_evicts_idle_key(void)
+{
+	for (size_t i = 0; i < KEY_CACHE_SIZE; i++) {
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[i]));
+	}
+
+	import_out_of_memory = 1;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[KEY_CACHE_SIZE]));
+	TEST_ASSERT_EQUAL(KEY_CACHE_SIZE + 2, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(1, psa_destroy_key_fake.call_count);
+	/* Handle of the least recently used key. */
+	TEST_ASSERT_EQUAL(1, psa_destroy_key_fake.arg0_val);
+
+	/* The retried key is cached, the evicted one is imported again. */
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[KEY_CACHE_SIZE]));
+	TEST_ASSERT_EQUAL(KEY_CACHE_SIZE + 2, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	TEST_ASSERT_EQUAL(KEY_CACHE_SIZE + 3, psa_import_key_fake.call_count);
+}
+
+void test_key_cache_out_of_key_slots_for_long_key(void)
+{
+	uint8_t key[HMAC_LONG_KEY_SIZE];
+	uint8_t digest[SHA256_LEN];
+	sid_pal_hmac_params_t params = {
+		.algo = SID_PAL_HASH_SHA256,
+		.key = key,
+		.key_size = sizeof(key),
+		.data = data,
+		.data_size = sizeof(data),
+		.digest = digest,
+		.digest_size = sizeof(digest),
+	};
+
+	memset(key, 0xA5, sizeof(key));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+
+	import_out_of_memory = 1;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_hmac(&params));
+	TEST_ASSERT_EQUAL(3, psa_import_key_fake.call_count);
+	/* The cached key and the long key after the operation. */
+	TEST_ASSERT_EQUAL(2, psa_destroy_key_fake.call_count);
+	TEST_ASSERT_EQUAL(1, psa_destroy_key_fake.arg0_history[0]);
+}
+
+void test_key_cache_out_of_key_slots_without_idle_key(void)
+{
+	import_out_of_memory = 1;
+	TEST_ASSERT_EQUAL(SID_ERROR_OOM, cmac(keys[0]));
+	TEST_ASSERT_EQUAL(1, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(0, psa_destroy_key_fake.call_count);
+
+	/* Only one retry after an eviction. */
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	import_out_of_memory = 2;
+	TEST_ASSERT_EQUAL(SID_ERROR_OOM, cmac(keys[1]));
+	TEST_ASSERT_EQUAL(4, psa_import_key_fake.call_count);
+	TEST_ASSERT_EQUAL(1, psa_destroy_key_fake.call_count);
+}
+
+void test_key_cache_deinit_destroys_keys(void)
+{
+	for (size_t i = 0; i < KEY_CACHE_SIZE; i++) {
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[i]));
+	}
+	TEST_ASSERT_EQUAL(0, psa_destroy_key_fake.call_count);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_deinit());
+	TEST_ASSERT_EQUAL(KEY_CACHE_SIZE, psa_destroy_key_fake.call_count);
+
+	/* Keys are imported again after init. */
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, cmac(keys[0]));
+	TEST_ASSERT_EQUAL(KEY_CACHE_SIZE + 1, psa_import_key_fake.call_count);
+}
+
+/*************************************************************************
+* BENCHMARK
+* ***********************************************************************/
+static void benchmark(const char *name, size_t key_count)
+{
+	/* Start with empty cache. */
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_deinit());
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+
+	benchmark_cmac(name, keys, key_count);
+}
+
+void test_key_cache_benchmark(void)
+{
+	benchmark("key cache hit", KEY_CACHE_SIZE);
+	/* Keys used round robin, one more than fits the cache, every operation imports. */
+	benchmark("key cache miss", KEY_CACHE_SIZE + 1);
+
+	TEST_ASSERT_EQUAL(KEY_CACHE_SIZE + BENCHMARK_OPERATIONS, psa_import_key_fake.call_count);
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
@@ -10,103 +10,8 @@
 #include <sid_pal_crypto_ifc.h>
 #include <zephyr/sys/util.h>
 
-#include <zephyr/fff.h>
-#include <psa/crypto.h>
-#include <psa/crypto_types.h>
-#include <psa/crypto_values.h>
-
-DEFINE_FFF_GLOBALS;
-
-/*************************************************************************
-* Create fake functions for tests.
-* ***********************************************************************/
-FAKE_VALUE_FUNC(psa_status_t, psa_crypto_init);
-FAKE_VALUE_FUNC(psa_status_t, psa_generate_random, uint8_t *, size_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_hash_compute, psa_algorithm_t, const uint8_t *, size_t, uint8_t *,
-		size_t, size_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_import_key, const psa_key_attributes_t *, const uint8_t *, size_t,
-		mbedtls_svc_key_id_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_destroy_key, mbedtls_svc_key_id_t);
-FAKE_VOID_FUNC(psa_reset_key_attributes, psa_key_attributes_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_mac_sign_setup, psa_mac_operation_t *, mbedtls_svc_key_id_t,
-		psa_algorithm_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_mac_update, psa_mac_operation_t *, const uint8_t *, size_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_mac_sign_finish, psa_mac_operation_t *, uint8_t *, size_t,
-		size_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_mac_compute, mbedtls_svc_key_id_t, psa_algorithm_t,
-		const uint8_t *, size_t, uint8_t *, size_t, size_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_cipher_encrypt_setup, psa_cipher_operation_t *,
-		mbedtls_svc_key_id_t, psa_algorithm_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_cipher_decrypt_setup, psa_cipher_operation_t *,
-		mbedtls_svc_key_id_t, psa_algorithm_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_cipher_abort, psa_cipher_operation_t *)
-FAKE_VALUE_FUNC(psa_status_t, psa_cipher_set_iv, psa_cipher_operation_t *, const uint8_t *, size_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_cipher_update, psa_cipher_operation_t *, const uint8_t *, size_t,
-		uint8_t *, size_t, size_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_cipher_finish, psa_cipher_operation_t *, uint8_t *, size_t,
-		size_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_verify_message, psa_key_handle_t, psa_algorithm_t,
-		const uint8_t *, size_t, const uint8_t *, size_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_sign_message, psa_key_handle_t, psa_algorithm_t, const uint8_t *,
-		size_t, uint8_t *, size_t, size_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_generate_key, const psa_key_attributes_t *,
-		mbedtls_svc_key_id_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_export_key, mbedtls_svc_key_id_t, uint8_t *, size_t, size_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_export_public_key, mbedtls_svc_key_id_t, uint8_t *, size_t,
-		size_t *);
-
-FAKE_VALUE_FUNC(psa_status_t, psa_aead_set_lengths, psa_aead_operation_t *, size_t, size_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_aead_set_nonce, psa_aead_operation_t *, const uint8_t *, size_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_aead_update_ad, psa_aead_operation_t *, const uint8_t *, size_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_aead_update, psa_aead_operation_t *, const uint8_t *, size_t,
-		uint8_t *, size_t, size_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_aead_finish, psa_aead_operation_t *, uint8_t *, size_t, size_t *,
-		uint8_t *, size_t, size_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_aead_verify, psa_aead_operation_t *, uint8_t *, size_t, size_t *,
-		const uint8_t *, size_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_aead_encrypt_setup, psa_aead_operation_t *, mbedtls_svc_key_id_t,
-		psa_algorithm_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_aead_decrypt_setup, psa_aead_operation_t *, mbedtls_svc_key_id_t,
-		psa_algorithm_t);
-FAKE_VALUE_FUNC(psa_status_t, psa_aead_abort, psa_aead_operation_t *);
-FAKE_VALUE_FUNC(psa_status_t, psa_raw_key_agreement, psa_algorithm_t, mbedtls_svc_key_id_t,
-		const uint8_t *, size_t, uint8_t *, size_t, size_t *);
-/*************************************************************************
-* Create fake functions for tests end.
-* ***********************************************************************/
-
-#define FFF_FAKES_LIST(FAKE)                                                                       \
-	FAKE(psa_crypto_init)                                                                      \
-	FAKE(psa_generate_random)                                                                  \
-	FAKE(psa_hash_compute)                                                                     \
-	FAKE(psa_import_key)                                                                       \
-	FAKE(psa_destroy_key)                                                                      \
-	FAKE(psa_reset_key_attributes)                                                             \
-	FAKE(psa_mac_sign_setup)                                                                   \
-	FAKE(psa_mac_update)                                                                       \
-	FAKE(psa_mac_sign_finish)                                                                  \
-	FAKE(psa_mac_compute)                                                                      \
-	FAKE(psa_cipher_abort)                                                                     \
-	FAKE(psa_cipher_encrypt_setup)                                                             \
-	FAKE(psa_cipher_decrypt_setup)                                                             \
-	FAKE(psa_cipher_set_iv)                                                                    \
-	FAKE(psa_cipher_update)                                                                    \
-	FAKE(psa_cipher_finish)                                                                    \
-	FAKE(psa_verify_message)                                                                   \
-	FAKE(psa_sign_message)                                                                     \
-	FAKE(psa_generate_key)                                                                     \
-	FAKE(psa_export_key)                                                                       \
-	FAKE(psa_export_public_key)                                                                \
-	FAKE(psa_aead_decrypt_setup)                                                               \
-	FAKE(psa_aead_encrypt_setup)                                                               \
-	FAKE(psa_aead_verify)                                                                      \
-	FAKE(psa_aead_finish)                                                                      \
-	FAKE(psa_aead_update)                                                                      \
-	FAKE(psa_aead_update_ad)                                                                   \
-	FAKE(psa_aead_set_nonce)                                                                   \
-	FAKE(psa_aead_set_lengths)                                                                 \
-	FAKE(psa_aead_abort)                                                                       \
-	FAKE(psa_raw_key_agreement)
+#include "benchmark.h"
+#include "psa_fakes.h"
 
 #define RNG_BUFF_MAX_SIZE (128)
 
@@ -2503,6 +2408,25 @@ void test_sid_pal_crypto_ecc_ecdh_SECP256R1_buffer_overflow(void)
 * END ECDH
 * ***********************************************************************/
 
+/*************************************************************************
+* BENCHMARK
+* ***********************************************************************/
+void test_sid_pal_crypto_benchmark(void)
+{
+	static uint8_t keys[2][BENCHMARK_KEY_LENGTH];
+
+	for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+		memset(keys[i], i + 1, sizeof(keys[i]));
+	}
+	psa_crypto_init_fake.return_val = PSA_SUCCESS;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_crypto_init());
+	psa_import_key_fake.return_val = PSA_SUCCESS;
+	psa_mac_compute_fake.return_val = PSA_SUCCESS;
+
+	/* Without the key cache every operation imports and destroys the key. */
+	benchmark_cmac("no key cache", keys, ARRAY_SIZE(keys));
+}
+
 /* It is required to be added to each test. That is because unity is using
  * different main signature (returns int) and zephyr expects main which does
  * not return value.
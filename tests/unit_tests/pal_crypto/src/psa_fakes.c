@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "psa_fakes.h"
+
+DEFINE_FFF_GLOBALS;
+
+/*************************************************************************
+* Fake PSA functions for tests.
+* ***********************************************************************/
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_crypto_init);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_generate_random, uint8_t *, size_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_hash_compute, psa_algorithm_t, const uint8_t *, size_t,
+		       uint8_t *, size_t, size_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_import_key, const psa_key_attributes_t *, const uint8_t *,
+		       size_t, mbedtls_svc_key_id_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_destroy_key, mbedtls_svc_key_id_t);
+DEFINE_FAKE_VOID_FUNC(psa_reset_key_attributes, psa_key_attributes_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_sign_setup, psa_mac_operation_t *,
+		       mbedtls_svc_key_id_t, psa_algorithm_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_update, psa_mac_operation_t *, const uint8_t *,
+		       size_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_sign_finish, psa_mac_operation_t *, uint8_t *, size_t,
+		       size_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_compute, mbedtls_svc_key_id_t, psa_algorithm_t,
+		       const uint8_t *, size_t, uint8_t *, size_t, size_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_cipher_encrypt_setup, psa_cipher_operation_t *,
+		       mbedtls_svc_key_id_t, psa_algorithm_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_cipher_decrypt_setup, psa_cipher_operation_t *,
+		       mbedtls_svc_key_id_t, psa_algorithm_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_cipher_abort, psa_cipher_operation_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_cipher_set_iv, psa_cipher_operation_t *, const uint8_t *,
+		       size_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_cipher_update, psa_cipher_operation_t *, const uint8_t *,
+		       size_t, uint8_t *, size_t, size_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_cipher_finish, psa_cipher_operation_t *, uint8_t *, size_t,
+		       size_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_verify_message, psa_key_handle_t, psa_algorithm_t,
+		       const uint8_t *, size_t, const uint8_t *, size_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_sign_message, psa_key_handle_t, psa_algorithm_t,
+		       const uint8_t *, size_t, uint8_t *, size_t, size_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_generate_key, const psa_key_attributes_t *,
+		       mbedtls_svc_key_id_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_export_key, mbedtls_svc_key_id_t, uint8_t *, size_t,
+		       size_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_export_public_key, mbedtls_svc_key_id_t, uint8_t *, size_t,
+		       size_t *);
+
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_aead_set_lengths, psa_aead_operation_t *, size_t, size_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_aead_set_nonce, psa_aead_operation_t *, const uint8_t *,
+		       size_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_aead_update_ad, psa_aead_operation_t *, const uint8_t *,
+		       size_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_aead_update, psa_aead_operation_t *, const uint8_t *,
+		       size_t, uint8_t *, size_t, size_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_aead_finish, psa_aead_operation_t *, uint8_t *, size_t,
+		       size_t *, uint8_t *, size_t, size_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_aead_verify, psa_aead_operation_t *, uint8_t *, size_t,
+		       size_t *, const uint8_t *, size_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_aead_encrypt_setup, psa_aead_operation_t *,
+		       mbedtls_svc_key_id_t, psa_algorithm_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_aead_decrypt_setup, psa_aead_operation_t *,
+		       mbedtls_svc_key_id_t, psa_algorithm_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_aead_abort, psa_aead_operation_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_raw_key_agreement, psa_algorithm_t, mbedtls_svc_key_id_t,
+		       const uint8_t *, size_t, uint8_t *, size_t, size_t *);
+/*************************************************************************
+* Fake PSA functions for tests end.
+* ***********************************************************************/
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <sid_pal_log_ifc.h>
+#include <sid_log_level.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_msg.h>
+#include <zephyr/sys/cbprintf.h>
+#include <string.h>
+#include <errno.h>
+
+#define BENCH_CALLS 50
+#define BENCH_STACK_SIZE 2048
+
+/* Backend that renders the messages, to check what the log thread prints */
+static char rendered[128];
+static size_t rendered_len;
+static uint32_t rendered_cnt;
+
+static int render_out(int c, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if (rendered_len < sizeof(rendered) - 1) {
+		rendered[rendered_len++] = (char)c;
+	}
+	return c;
+}
+
+static void test_backend_process(const struct log_backend *const backend,
+				 union log_msg_generic *msg)
+{
+	size_t len;
+	uint8_t *package = log_msg_get_package(&msg->log, &len);
+
+	rendered_len = 0;
+	if (len) {
+		cbpprintf(render_out, NULL, package);
+	}
+	rendered[rendered_len] = '\0';
+	rendered_cnt++;
+}
+
+static const struct log_backend_api test_backend_api = {
+	.process = test_backend_process,
+};
+
+LOG_BACKEND_DEFINE(sid_log_test_backend, test_backend_api, true);
+
+static K_THREAD_STACK_DEFINE(bench_stack, BENCH_STACK_SIZE);
+static struct k_thread bench_thread;
+static uint32_t bench_cycles;
+
+void setUp(void)
+{
+	sid_log_level_set(SID_LOG_SOURCE_STACK, LOG_LEVEL_DBG);
+	sid_pal_log_flush();
+	rendered_cnt = 0;
+}
+
+/******************************************************************
+* sid_pal_log_ifc
+* ****************************************************************/
+
+void test_log_rendered_by_log_thread(void)
+{
+	char text[] = "text";
+
+	sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 3, "value %d %s 0x%x", 42, text, 0xbeef);
+	/* The string argument is copied, the buffer can be reused before the log is printed */
+	strcpy(text, "xxx");
+	sid_pal_log_flush();
+
+	TEST_ASSERT_EQUAL(1, rendered_cnt);
+	TEST_ASSERT_EQUAL_STRING("value 42 text 0xbeef", rendered);
+}
+
+void test_log_severity(void)
+{
+	sid_pal_log(SID_PAL_LOG_SEVERITY_ERROR, 0, "Sidewalk log Error");
+	sid_pal_log(SID_PAL_LOG_SEVERITY_WARNING, 0, "Sidewalk log Warning");
+	sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 0, "Sidewalk log Info");
+	sid_pal_log(SID_PAL_LOG_SEVERITY_DEBUG, 0, "Sidewalk log Debug");
+	sid_pal_log_flush();
+
+	TEST_ASSERT_EQUAL(4, rendered_cnt);
+	TEST_ASSERT_EQUAL_STRING("Sidewalk log Debug", rendered);
+}
+
+void test_log_runtime_level(void)
+{
+	TEST_ASSERT_EQUAL(LOG_LEVEL_WRN, sid_log_level_set(SID_LOG_SOURCE_STACK, LOG_LEVEL_WRN));
+	TEST_ASSERT_EQUAL(LOG_LEVEL_WRN, sid_log_level_get(SID_LOG_SOURCE_STACK));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_WARNING, sid_log_control_get_current_log_level());
+
+	sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 0, "Sidewalk log Info");
+	sid_pal_log(SID_PAL_LOG_SEVERITY_DEBUG, 0, "Sidewalk log Debug");
+	sid_pal_log(SID_PAL_LOG_SEVERITY_WARNING, 0, "Sidewalk log Warning");
+	sid_pal_log_flush();
+	TEST_ASSERT_EQUAL(1, rendered_cnt);
+	TEST_ASSERT_EQUAL_STRING("Sidewalk log Warning", rendered);
+
+	TEST_ASSERT_EQUAL(LOG_LEVEL_NONE, sid_log_level_set(SID_LOG_SOURCE_STACK, LOG_LEVEL_NONE));
+	TEST_ASSERT_EQUAL(SID_PAL_LOG_SEVERITY_ERROR, sid_log_control_get_current_log_level());
+	sid_pal_log(SID_PAL_LOG_SEVERITY_ERROR, 0, "Sidewalk log Error");
+	sid_pal_log_flush();
+	TEST_ASSERT_EQUAL(1, rendered_cnt);
+
+	TEST_ASSERT_EQUAL(LOG_LEVEL_DBG, sid_log_level_set(SID_LOG_SOURCE_STACK, LOG_LEVEL_DBG));
+	sid_pal_log(SID_PAL_LOG_SEVERITY_DEBUG, 0, "Sidewalk log Debug");
+	sid_pal_log_flush();
+	TEST_ASSERT_EQUAL(2, rendered_cnt);
+}
+
+void test_log_runtime_level_invalid(void)
+{
+	TEST_ASSERT_EQUAL(-EINVAL, sid_log_level_set(SID_LOG_SOURCE_COUNT, LOG_LEVEL_DBG));
+	TEST_ASSERT_EQUAL(-EINVAL, sid_log_level_set(SID_LOG_SOURCE_STACK, LOG_LEVEL_DBG + 1));
+	/* No BLE log module in the test */
+	TEST_ASSERT_EQUAL(-ENOENT, sid_log_level_set(SID_LOG_SOURCE_BLE, LOG_LEVEL_DBG));
+	TEST_ASSERT_EQUAL_STRING("ble", sid_log_source_name(SID_LOG_SOURCE_BLE));
+	TEST_ASSERT_NULL(sid_log_source_name(SID_LOG_SOURCE_COUNT));
+}
+
+static void bench_thread_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < BENCH_CALLS; i++) {
+		uint32_t start = k_cycle_get_32();
+
+		sid_pal_log(SID_PAL_LOG_SEVERITY_INFO, 4, "%s: rssi %d snr %d freq %u", "rx_done",
+			    -87 - i, 7, 915000000U);
+		bench_cycles += k_cycle_get_32() - start;
+	}
+}
+
+/*
+ * Prints the cycles spent in sid_pal_log() by the caller and the stack high-water of the
+ * calling thread, to be compared with the formatted scenario.
+ */
+void test_log_caller_benchmark(void)
+{
+	size_t unused = 0;
+
+	bench_cycles = 0;
+	k_thread_create(&bench_thread, bench_stack, K_THREAD_STACK_SIZEOF(bench_stack),
+			bench_thread_fn, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_thread_join(&bench_thread, K_FOREVER);
+	TEST_ASSERT_EQUAL(0, k_thread_stack_space_get(&bench_thread, &unused));
+	sid_pal_log_flush();
+
+	TEST_ASSERT_EQUAL(BENCH_CALLS, rendered_cnt);
+	TEST_ASSERT_EQUAL_STRING("rx_done: rssi -136 snr 7 freq 915000000", rendered);
+
+	printk("%s: %u cycles (%u ns) per call, stack high-water %u bytes\n",
+	       IS_ENABLED(CONFIG_SIDEWALK_LOG_DEFERRED) ? "deferred" : "formatted",
+	       bench_cycles / BENCH_CALLS,
+	       (uint32_t)k_cyc_to_ns_floor64(bench_cycles / BENCH_CALLS),
+	       (uint32_t)(K_THREAD_STACK_SIZEOF(bench_stack) - unused));
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
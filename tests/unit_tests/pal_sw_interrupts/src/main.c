@@ -5,6 +5,10 @@
  */
 #include <zephyr/ztest.h>
 #include <sid_pal_swi_ifc.h>
+#include <sid_sw_interrupts.h>
+#include <zephyr/kernel.h>
+
+#define RUNS_MAX 8
 
 void mock_callback(void)
 {
@@ -61,3 +65,136 @@ ZTEST(swi_tests, test_swi_trigger_negative)
 }
 
 ZTEST_SUITE(swi_tests, NULL, NULL, swi_init_start, swi_stop_deinit, NULL);
+
+/* Channels, in the order their callbacks ran */
+static enum sid_swi_channel runs[RUNS_MAX];
+static size_t runs_cnt;
+static int normal_retrigger;
+
+static void run_record(enum sid_swi_channel channel)
+{
+	zassert_true(runs_cnt < RUNS_MAX);
+	runs[runs_cnt++] = channel;
+}
+
+static void radio_callback(void)
+{
+	run_record(SID_SWI_CHANNEL_RADIO);
+}
+
+static void normal_callback(void)
+{
+	run_record(SID_SWI_CHANNEL_NORMAL);
+
+	if (normal_retrigger) {
+		normal_retrigger--;
+		zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_NORMAL), SID_ERROR_NONE);
+		zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_RADIO), SID_ERROR_NONE);
+	}
+}
+
+static void channels_start(void *fixture)
+{
+	ARG_UNUSED(fixture);
+	runs_cnt = 0;
+	normal_retrigger = 0;
+	sid_swi_latency_reset();
+	zassert_equal(sid_pal_swi_init(), SID_ERROR_NONE);
+	zassert_equal(sid_swi_channel_start(SID_SWI_CHANNEL_RADIO, radio_callback), SID_ERROR_NONE);
+	zassert_equal(sid_swi_channel_start(SID_SWI_CHANNEL_NORMAL, normal_callback),
+		      SID_ERROR_NONE);
+}
+
+static void channels_stop(void *fixture)
+{
+	ARG_UNUSED(fixture);
+	zassert_equal(sid_swi_channel_stop(SID_SWI_CHANNEL_RADIO), SID_ERROR_NONE);
+	zassert_equal(sid_swi_channel_stop(SID_SWI_CHANNEL_NORMAL), SID_ERROR_NONE);
+	zassert_equal(sid_pal_swi_deinit(), SID_ERROR_NONE);
+}
+
+ZTEST(swi_channel_tests, test_swi_channel_invalid)
+{
+	zassert_equal(sid_swi_channel_start(SID_SWI_CHANNEL_COUNT, radio_callback),
+		      SID_ERROR_INVALID_ARGS);
+	zassert_equal(sid_swi_channel_start(SID_SWI_CHANNEL_NORMAL, NULL), SID_ERROR_NULL_POINTER);
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_COUNT), SID_ERROR_INVALID_ARGS);
+	zassert_equal(sid_swi_channel_stop(SID_SWI_CHANNEL_COUNT), SID_ERROR_INVALID_ARGS);
+	zassert_is_null(sid_swi_channel_name(SID_SWI_CHANNEL_COUNT));
+
+	zassert_equal(sid_swi_channel_stop(SID_SWI_CHANNEL_NORMAL), SID_ERROR_NONE);
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_NORMAL), SID_ERROR_INVALID_STATE);
+}
+
+ZTEST(swi_channel_tests, test_swi_channel_trigger_not_initialized)
+{
+	zassert_equal(sid_pal_swi_deinit(), SID_ERROR_NONE);
+	zassert_equal(sid_swi_channel_start(SID_SWI_CHANNEL_NORMAL, normal_callback),
+		      SID_ERROR_NONE);
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_NORMAL), SID_ERROR_INVALID_STATE);
+	zassert_equal(runs_cnt, 0);
+
+	zassert_equal(sid_pal_swi_init(), SID_ERROR_NONE);
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_NORMAL), SID_ERROR_NONE);
+	zassert_equal(runs_cnt, 1);
+}
+
+ZTEST(swi_channel_tests, test_swi_channel_priority)
+{
+	/* Both channels pending before the SWI thread runs */
+	k_sched_lock();
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_NORMAL), SID_ERROR_NONE);
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_RADIO), SID_ERROR_NONE);
+	k_sched_unlock();
+
+	zassert_equal(runs_cnt, 2);
+	zassert_equal(runs[0], SID_SWI_CHANNEL_RADIO);
+	zassert_equal(runs[1], SID_SWI_CHANNEL_NORMAL);
+}
+
+ZTEST(swi_channel_tests, test_swi_channel_pending_bit)
+{
+	k_sched_lock();
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_NORMAL), SID_ERROR_NONE);
+	}
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_RADIO), SID_ERROR_NONE);
+	k_sched_unlock();
+
+	/* Triggers of a pending channel are served by one call */
+	zassert_equal(runs_cnt, 2);
+}
+
+ZTEST(swi_channel_tests, test_swi_channel_radio_between_normal)
+{
+	/* Radio triggered from a normal callback runs before the next normal one */
+	normal_retrigger = 1;
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_NORMAL), SID_ERROR_NONE);
+
+	zassert_equal(runs_cnt, 3);
+	zassert_equal(runs[0], SID_SWI_CHANNEL_NORMAL);
+	zassert_equal(runs[1], SID_SWI_CHANNEL_RADIO);
+	zassert_equal(runs[2], SID_SWI_CHANNEL_NORMAL);
+}
+
+ZTEST(swi_channel_tests, test_swi_channel_latency)
+{
+	struct sid_swi_latency latency;
+
+	k_sched_lock();
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_NORMAL), SID_ERROR_NONE);
+	k_busy_wait(300);
+	zassert_equal(sid_swi_channel_trigger(SID_SWI_CHANNEL_NORMAL), SID_ERROR_NONE);
+	k_sched_unlock();
+
+	zassert_equal(sid_swi_latency_get(SID_SWI_CHANNEL_NORMAL, &latency), SID_ERROR_NONE);
+	zassert_equal(latency.count, 1);
+	/* Measured from the first trigger, 256 us to 512 us */
+	zassert_true(latency.max_us >= 300 && latency.max_us < 512, "max %u us", latency.max_us);
+	zassert_equal(latency.buckets[9], 1);
+
+	zassert_equal(sid_swi_latency_get(SID_SWI_CHANNEL_RADIO, &latency), SID_ERROR_NONE);
+	zassert_equal(latency.count, 0);
+}
+
+ZTEST_SUITE(swi_channel_tests, NULL, NULL, channels_start, channels_stop, NULL);
@@ -58,6 +58,11 @@ bool sid_time_gt(const struct sid_timespec *time_1, const struct sid_timespec *t
 	return false;
 }
 
+bool sid_time_eq(const struct sid_timespec *time_1, const struct sid_timespec *time_2)
+{
+	return time_1->tv_sec == time_2->tv_sec && time_1->tv_nsec == time_2->tv_nsec;
+}
+
 bool sid_time_is_infinity(const struct sid_timespec *time)
 {
 	if (time->tv_sec == SID_TIME_INFINITY.tv_sec &&
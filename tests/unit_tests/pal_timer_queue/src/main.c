@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sid_pal_timer_ifc.h>
+#include <sid_critical_section.h>
+#include <zephyr/sys/util.h>
+
+#define TIMERS_MAX (500)
+#define FIRED_MAX (8192)
+#define NS_PER_SECOND (1000000000ULL)
+#define US_PER_SECOND (1000000ULL)
+#define US_PER_MINUTE (60 * US_PER_SECOND)
+#define US_PER_HOUR (60 * US_PER_MINUTE)
+#define LOWPOWER_TOLERANCE_US (US_PER_SECOND)
+
+#define RANDOM_TIMERS (64)
+#define RANDOM_STEPS (20000)
+#define BENCHMARK_ROUNDS (20)
+
+#if CONFIG_SIDEWALK_TIMER_QUEUE_HEAP
+#define BACKEND_NAME "heap"
+#elif CONFIG_SIDEWALK_TIMER_QUEUE_WHEEL
+#define BACKEND_NAME "wheel"
+#else
+#define BACKEND_NAME "list"
+#endif
+
+struct fired_timer {
+	size_t id;
+	uint64_t alarm;
+};
+
+struct ref_timer {
+	size_t id;
+	uint64_t alarm;
+	uint64_t period;
+	uint64_t tolerance;
+};
+
+static sid_pal_timer_t timers[TIMERS_MAX];
+
+static struct fired_timer fired[FIRED_MAX];
+static size_t fired_count;
+static struct fired_timer ref_fired[FIRED_MAX];
+static size_t ref_fired_count;
+
+static struct ref_timer ref[TIMERS_MAX];
+static size_t ref_count;
+
+static uint32_t random_state;
+
+static sid_pal_timer_t *cancel_from;
+static sid_pal_timer_t *cancel_target;
+
+static uint64_t section_start_ns;
+static uint64_t section_max_ns;
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * NS_PER_SECOND + ts.tv_nsec;
+}
+
+/*
+ * The timer critical section measures the longest time interrupts would be locked.
+ * The statistics of sid_critical_region.c count cycles, which do not advance during
+ * computation on native_posix, so the host clock is used instead.
+ */
+sid_critical_section_key_t sid_critical_section_enter(struct sid_critical_section *section)
+{
+	TEST_ASSERT_EQUAL_STRING("timer", section->name);
+	sid_critical_section_key_t key = k_spin_lock(&section->lock);
+
+	section_start_ns = now_ns();
+	return key;
+}
+
+void sid_critical_section_exit(struct sid_critical_section *section,
+			       sid_critical_section_key_t key)
+{
+	section_max_ns = MAX(section_max_ns, now_ns() - section_start_ns);
+	k_spin_unlock(&section->lock, key);
+}
+
+static uint32_t random_next(void)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+static struct sid_timespec us_to_time(uint64_t us)
+{
+	return (struct sid_timespec){ .tv_sec = us / US_PER_SECOND,
+				      .tv_nsec = (us % US_PER_SECOND) * 1000 };
+}
+
+static uint64_t time_to_us(const struct sid_timespec *time)
+{
+	return (uint64_t)time->tv_sec * US_PER_SECOND + time->tv_nsec / 1000;
+}
+
+static void timer_cb(void *arg, sid_pal_timer_t *originator)
+{
+	TEST_ASSERT_EQUAL_PTR(&timers[(uintptr_t)arg], originator);
+	if (originator == cancel_from) {
+		TEST_ASSERT_TRUE(sid_pal_timer_is_armed(cancel_target));
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_timer_cancel(cancel_target));
+		TEST_ASSERT_FALSE(sid_pal_timer_is_armed(cancel_target));
+	}
+	if (fired_count < FIRED_MAX) {
+		fired[fired_count].id = (uintptr_t)arg;
+		fired[fired_count].alarm = time_to_us(&originator->alarm);
+	}
+	fired_count++;
+}
+
+void setUp(void)
+{
+	random_state = 0x5eed1234;
+	fired_count = 0;
+	ref_fired_count = 0;
+	ref_count = 0;
+	section_max_ns = 0;
+	cancel_from = NULL;
+	cancel_target = NULL;
+
+	for (size_t i = 0; i < TIMERS_MAX; i++) {
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+				  sid_pal_timer_init(&timers[i], timer_cb, (void *)(uintptr_t)i));
+	}
+}
+
+void tearDown(void)
+{
+	for (size_t i = 0; i < TIMERS_MAX; i++) {
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_timer_deinit(&timers[i]));
+	}
+}
+
+/******************************************************************
+* Reference model, the sorted list the queue was implemented with
+* ****************************************************************/
+static uint64_t ref_insert(struct ref_timer timer)
+{
+	size_t position = ref_count;
+
+	for (size_t i = 0; i < ref_count; i++) {
+		if (ref[i].alarm > timer.alarm) {
+			if (ref[i].alarm - timer.alarm <= timer.tolerance) {
+				timer.alarm = ref[i].alarm;
+			}
+			position = i;
+			break;
+		}
+	}
+
+	memmove(&ref[position + 1], &ref[position], (ref_count - position) * sizeof(ref[0]));
+	ref[position] = timer;
+	ref_count++;
+
+	return timer.alarm;
+}
+
+static struct ref_timer *ref_find(size_t id)
+{
+	for (size_t i = 0; i < ref_count; i++) {
+		if (ref[i].id == id) {
+			return &ref[i];
+		}
+	}
+	return NULL;
+}
+
+static void ref_remove(size_t id)
+{
+	struct ref_timer *timer = ref_find(id);
+
+	if (timer) {
+		memmove(timer, timer + 1, (&ref[ref_count] - (timer + 1)) * sizeof(ref[0]));
+		ref_count--;
+	}
+}
+
+static void ref_fire(const struct ref_timer *timer)
+{
+	if (ref_fired_count < FIRED_MAX) {
+		ref_fired[ref_fired_count].id = timer->id;
+		ref_fired[ref_fired_count].alarm = timer->alarm;
+	}
+	ref_fired_count++;
+}
+
+#if CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY
+static void ref_expire(uint64_t now)
+{
+	static struct ref_timer expired[TIMERS_MAX];
+	size_t expired_count = 0;
+
+	/* All due timers are detached first, a periodic one expires once per batch */
+	while (ref_count && ref[0].alarm <= now) {
+		expired[expired_count] = ref[0];
+		ref_remove(expired[expired_count++].id);
+	}
+
+	for (size_t i = 0; i < expired_count; i++) {
+		struct ref_timer timer = expired[i];
+
+		if (timer.period) {
+			timer.alarm += timer.period;
+			timer.alarm = ref_insert(timer);
+		}
+		ref_fire(&timer);
+	}
+}
+#else
+static void ref_expire(uint64_t now)
+{
+	while (ref_count && ref[0].alarm <= now) {
+		struct ref_timer timer = ref[0];
+
+		ref_remove(timer.id);
+		if (timer.period) {
+			timer.alarm += timer.period;
+			timer.alarm = ref_insert(timer);
+		}
+		ref_fire(&timer);
+	}
+}
+#endif /* CONFIG_SIDEWALK_TIMER_BATCH_EXPIRY */
+
+/******************************************************************
+* sid_timer_queue
+* ****************************************************************/
+static void arm(size_t id, bool lowpower, uint64_t when, uint64_t period)
+{
+	struct sid_timespec when_time = us_to_time(when);
+	struct sid_timespec period_time = us_to_time(period);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE,
+			  sid_pal_timer_arm(&timers[id],
+					    lowpower ? SID_PAL_TIMER_PRIO_CLASS_LOWPOWER :
+						       SID_PAL_TIMER_PRIO_CLASS_PRECISE,
+					    &when_time, period ? &period_time : NULL));
+	ref_insert((struct ref_timer){ .id = id,
+				       .alarm = when,
+				       .period = period,
+				       .tolerance = lowpower ? LOWPOWER_TOLERANCE_US : 0 });
+
+	TEST_ASSERT_EQUAL_UINT64(ref_find(id)->alarm, time_to_us(&timers[id].alarm));
+}
+
+static void expire(uint64_t now)
+{
+	struct sid_timespec now_time = us_to_time(now);
+
+	fired_count = 0;
+	ref_fired_count = 0;
+	sid_pal_timer_event_callback(NULL, &now_time);
+	ref_expire(now);
+
+	TEST_ASSERT_EQUAL(ref_fired_count, fired_count);
+	for (size_t i = 0; i < MIN(fired_count, FIRED_MAX); i++) {
+		TEST_ASSERT_EQUAL(ref_fired[i].id, fired[i].id);
+		TEST_ASSERT_EQUAL_UINT64(ref_fired[i].alarm, fired[i].alarm);
+	}
+}
+
+void test_timer_queue_coalesce_lowpower(void)
+{
+	arm(0, false, 10 * US_PER_SECOND, 0);
+	/* Within tolerance of the later timer */
+	arm(1, true, 9 * US_PER_SECOND + 500000, 0);
+	TEST_ASSERT_EQUAL_UINT64(10 * US_PER_SECOND, time_to_us(&timers[1].alarm));
+	/* Precise timers are never moved */
+	arm(2, false, 9 * US_PER_SECOND + 500000, 0);
+	TEST_ASSERT_EQUAL_UINT64(9 * US_PER_SECOND + 500000, time_to_us(&timers[2].alarm));
+	/* Out of tolerance */
+	arm(3, true, 8 * US_PER_SECOND, 0);
+	TEST_ASSERT_EQUAL_UINT64(8 * US_PER_SECOND, time_to_us(&timers[3].alarm));
+	/* Aligned to the first later timer and expires before it */
+	arm(4, true, 8 * US_PER_SECOND + 600000, 0);
+	TEST_ASSERT_EQUAL_UINT64(9 * US_PER_SECOND + 500000, time_to_us(&timers[4].alarm));
+
+	expire(10 * US_PER_SECOND);
+	TEST_ASSERT_EQUAL(5, fired_count);
+	TEST_ASSERT_EQUAL(3, fired[0].id);
+	TEST_ASSERT_EQUAL(4, fired[1].id);
+	TEST_ASSERT_EQUAL(2, fired[2].id);
+	TEST_ASSERT_EQUAL(1, fired[3].id);
+	TEST_ASSERT_EQUAL(0, fired[4].id);
+}
+
+void test_timer_queue_cancel(void)
+{
+	for (size_t i = 0; i < 10; i++) {
+		arm(i, false, (i + 1) * US_PER_SECOND, 0);
+	}
+	for (size_t i = 0; i < 10; i += 3) {
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_timer_cancel(&timers[i]));
+		TEST_ASSERT_FALSE(sid_pal_timer_is_armed(&timers[i]));
+		ref_remove(i);
+	}
+
+	expire(20 * US_PER_SECOND);
+	TEST_ASSERT_EQUAL(6, fired_count);
+}
+
+void test_timer_queue_cancel_from_callback(void)
+{
+	arm(0, false, US_PER_SECOND, 0);
+	arm(1, false, US_PER_SECOND, 0);
+	arm(2, false, US_PER_SECOND, 0);
+	cancel_from = &timers[0];
+	cancel_target = &timers[1];
+	ref_remove(1);
+
+	expire(2 * US_PER_SECOND);
+	TEST_ASSERT_EQUAL(2, fired_count);
+	TEST_ASSERT_EQUAL(0, fired[0].id);
+	TEST_ASSERT_EQUAL(2, fired[1].id);
+}
+
+void test_timer_queue_periodic_cancel_itself(void)
+{
+	arm(0, false, US_PER_SECOND, US_PER_SECOND);
+	arm(1, false, US_PER_SECOND, US_PER_SECOND);
+
+	expire(US_PER_SECOND);
+	TEST_ASSERT_EQUAL(2, fired_count);
+	TEST_ASSERT_TRUE(sid_pal_timer_is_armed(&timers[0]));
+
+	struct sid_timespec now = us_to_time(2 * US_PER_SECOND);
+
+	cancel_from = &timers[0];
+	cancel_target = &timers[0];
+	fired_count = 0;
+	sid_pal_timer_event_callback(NULL, &now);
+	TEST_ASSERT_EQUAL(2, fired_count);
+	TEST_ASSERT_FALSE(sid_pal_timer_is_armed(&timers[0]));
+	TEST_ASSERT_TRUE(sid_pal_timer_is_armed(&timers[1]));
+}
+
+void test_timer_queue_random(void)
+{
+	uint64_t now = US_PER_SECOND;
+
+	for (size_t step = 0; step < RANDOM_STEPS; step++) {
+		size_t id = random_next() % RANDOM_TIMERS;
+		uint32_t action = random_next() % 8;
+
+		if (action < 4) {
+			if (!sid_pal_timer_is_armed(&timers[id])) {
+				/* Mostly near alarms, some in the past and some hours ahead */
+				uint64_t when = now - 50000 + random_next() % (3 * US_PER_SECOND);
+				uint64_t period = 0;
+
+				if (random_next() % 8 == 0) {
+					when += (random_next() % 10) * US_PER_HOUR;
+				}
+				if (random_next() % 8 == 0) {
+					period = US_PER_SECOND;
+					period += random_next() % (2 * US_PER_SECOND);
+				}
+				arm(id, random_next() % 2, when, period);
+			}
+		} else if (action < 6) {
+			TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_timer_cancel(&timers[id]));
+			ref_remove(id);
+		} else if (action < 7) {
+			now += random_next() % (400 * 1000);
+			expire(now);
+		} else if (random_next() % 16 == 0) {
+			now += random_next() % (5 * US_PER_MINUTE);
+			expire(now);
+		}
+
+		TEST_ASSERT_EQUAL(ref_find(id) != NULL, sid_pal_timer_is_armed(&timers[id]));
+	}
+
+	for (size_t id = 0; id < RANDOM_TIMERS; id++) {
+		TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_pal_timer_cancel(&timers[id]));
+	}
+}
+
+/*************************************************************************
+* BENCHMARK
+* ***********************************************************************/
+static void benchmark(size_t count)
+{
+	uint64_t insert_ns = 0;
+	uint64_t insert_locked_ns = 0;
+	uint64_t fetch_ns = 0;
+	uint64_t fetch_locked_ns = 0;
+
+	for (size_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+		uint64_t now = (round + 1) * 2 * US_PER_HOUR;
+		struct sid_timespec expire_time = us_to_time(now + 2 * US_PER_HOUR);
+		uint64_t start;
+
+		section_max_ns = 0;
+		start = now_ns();
+		for (size_t i = 0; i < count; i++) {
+			/* Protocol timers range from milliseconds to hours, spread log-uniformly */
+			uint64_t delay_ms = random_next() % (2ULL << (random_next() % 22));
+			struct sid_timespec when = us_to_time(now + delay_ms * 1000);
+
+			sid_pal_timer_arm(&timers[i],
+					  (i % 2) ? SID_PAL_TIMER_PRIO_CLASS_LOWPOWER :
+						    SID_PAL_TIMER_PRIO_CLASS_PRECISE,
+					  &when, NULL);
+		}
+		insert_ns += now_ns() - start;
+		insert_locked_ns = MAX(insert_locked_ns, section_max_ns);
+
+		fired_count = 0;
+		section_max_ns = 0;
+		start = now_ns();
+		sid_pal_timer_event_callback(NULL, &expire_time);
+		fetch_ns += now_ns() - start;
+		fetch_locked_ns = MAX(fetch_locked_ns, section_max_ns);
+
+		TEST_ASSERT_EQUAL(count, fired_count);
+	}
+
+	uint64_t operations = (uint64_t)count * BENCHMARK_ROUNDS;
+
+	printf("%s %3zu timers: insert %llu ops/s max locked %llu ns, "
+	       "fetch %llu ops/s max locked %llu ns\n",
+	       BACKEND_NAME, count,
+	       (unsigned long long)(operations * NS_PER_SECOND / MAX(insert_ns, 1)),
+	       (unsigned long long)insert_locked_ns,
+	       (unsigned long long)(operations * NS_PER_SECOND / MAX(fetch_ns, 1)),
+	       (unsigned long long)fetch_locked_ns);
+}
+
+void test_timer_queue_benchmark(void)
+{
+	/*
+	 * Host timing of the native_posix build, the numbers are meant for comparing
+	 * the backends with each other, not as absolute values for the target.
+	 * Half of the timers are low power, so some of them are aligned to other timers.
+	 */
+	static const size_t counts[] = { 10, 50, 100, 250, 500 };
+
+	for (size_t i = 0; i < ARRAY_SIZE(counts); i++) {
+		benchmark(counts[i]);
+	}
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
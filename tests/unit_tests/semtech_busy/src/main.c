@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <unity.h>
+#include <zephyr/kernel.h>
+#include <semtech_busy.h>
+#include <sid_gpio_utils.h>
+#include <sid_pal_critical_region_ifc.h>
+#include <cmock_sid_pal_gpio_ifc.h>
+#include <cmock_sid_pal_delay_ifc.h>
+
+#define BUSY_GPIO 3
+#define BUSY_TIMEOUT_US 20000
+#define BUSY_RELEASE_DELAY_MS 5
+
+static uint8_t busy_level;
+static uint32_t busy_reads;
+static uint32_t busy_release_after_reads;
+static bool busy_irq_enabled;
+static uint32_t busy_irq_enables;
+static sid_pal_gpio_irq_handler_t busy_irq_handler;
+static void *busy_irq_arg;
+static sid_error_t set_irq_result;
+static bool gpio_irq_context;
+
+bool sid_gpio_utils_irq_context(void)
+{
+	return gpio_irq_context;
+}
+
+static sid_error_t gpio_read_stub(uint32_t gpio, uint8_t *value, int cmock_num_calls)
+{
+	TEST_ASSERT_EQUAL(BUSY_GPIO, gpio);
+	busy_reads++;
+	if (busy_release_after_reads && busy_reads >= busy_release_after_reads) {
+		busy_level = 0;
+	}
+	*value = busy_level;
+	return SID_ERROR_NONE;
+}
+
+static sid_error_t gpio_set_irq_stub(uint32_t gpio, sid_pal_gpio_irq_trigger_t trigger,
+				     sid_pal_gpio_irq_handler_t handler, void *arg,
+				     int cmock_num_calls)
+{
+	TEST_ASSERT_EQUAL(BUSY_GPIO, gpio);
+	if (trigger != SID_PAL_GPIO_IRQ_TRIGGER_NONE) {
+		TEST_ASSERT_EQUAL(SID_PAL_GPIO_IRQ_TRIGGER_FALLING, trigger);
+	}
+	busy_irq_handler = handler;
+	busy_irq_arg = arg;
+	return set_irq_result;
+}
+
+static sid_error_t gpio_irq_enable_stub(uint32_t gpio, int cmock_num_calls)
+{
+	busy_irq_enabled = true;
+	busy_irq_enables++;
+	return SID_ERROR_NONE;
+}
+
+static sid_error_t gpio_irq_disable_stub(uint32_t gpio, int cmock_num_calls)
+{
+	busy_irq_enabled = false;
+	return SID_ERROR_NONE;
+}
+
+static void delay_us_stub(uint32_t delay, int cmock_num_calls)
+{
+	k_busy_wait(delay);
+}
+
+/* Radio finishes the command: BUSY goes low and the falling edge is reported */
+static void busy_release_work_handler(struct k_work *work)
+{
+	busy_level = 0;
+	if (busy_irq_enabled && busy_irq_handler) {
+		busy_irq_handler(BUSY_GPIO, busy_irq_arg);
+	}
+}
+
+static K_WORK_DELAYABLE_DEFINE(busy_release_work, busy_release_work_handler);
+
+void setUp(void)
+{
+	busy_level = 1;
+	busy_reads = 0;
+	busy_release_after_reads = 0;
+	busy_irq_enabled = false;
+	busy_irq_enables = 0;
+	busy_irq_handler = NULL;
+	busy_irq_arg = NULL;
+	set_irq_result = SID_ERROR_NONE;
+	gpio_irq_context = false;
+
+	__cmock_sid_pal_gpio_read_StubWithCallback(gpio_read_stub);
+	__cmock_sid_pal_gpio_set_irq_StubWithCallback(gpio_set_irq_stub);
+	__cmock_sid_pal_gpio_irq_enable_StubWithCallback(gpio_irq_enable_stub);
+	__cmock_sid_pal_gpio_irq_disable_StubWithCallback(gpio_irq_disable_stub);
+	__cmock_sid_pal_delay_us_StubWithCallback(delay_us_stub);
+
+	semtech_busy_stats_reset();
+}
+
+void tearDown(void)
+{
+	semtech_busy_deinit(BUSY_GPIO);
+	(void)k_work_cancel_delayable(&busy_release_work);
+}
+
+void test_semtech_busy_released(void)
+{
+	struct semtech_busy_stats stats;
+
+	semtech_busy_init(BUSY_GPIO);
+	TEST_ASSERT_NOT_NULL(busy_irq_handler);
+	TEST_ASSERT_FALSE(busy_irq_enabled);
+
+	busy_level = 0;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, semtech_busy_wait(BUSY_GPIO, BUSY_TIMEOUT_US));
+
+	semtech_busy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.waits);
+	TEST_ASSERT_EQUAL(0, stats.irq_waits);
+	TEST_ASSERT_EQUAL(0, stats.timeouts);
+	TEST_ASSERT_EQUAL(0, busy_irq_enables);
+}
+
+void test_semtech_busy_short_wait_polled(void)
+{
+	struct semtech_busy_stats stats;
+
+	semtech_busy_init(BUSY_GPIO);
+	busy_release_after_reads = 3;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, semtech_busy_wait(BUSY_GPIO, BUSY_TIMEOUT_US));
+
+	semtech_busy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.irq_waits);
+	TEST_ASSERT_EQUAL(0, busy_irq_enables);
+	TEST_ASSERT_LESS_OR_EQUAL(CONFIG_SIDEWALK_SUBGHZ_BUSY_POLL_US, stats.spin_us);
+}
+
+void test_semtech_busy_long_wait_sleeps(void)
+{
+	struct semtech_busy_stats stats;
+
+	semtech_busy_init(BUSY_GPIO);
+	k_work_schedule(&busy_release_work, K_MSEC(BUSY_RELEASE_DELAY_MS));
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, semtech_busy_wait(BUSY_GPIO, BUSY_TIMEOUT_US));
+
+	semtech_busy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.waits);
+	TEST_ASSERT_EQUAL(1, stats.irq_waits);
+	TEST_ASSERT_EQUAL(1, busy_irq_enables);
+	TEST_ASSERT_FALSE(busy_irq_enabled);
+	TEST_ASSERT_GREATER_OR_EQUAL((BUSY_RELEASE_DELAY_MS - 1) * USEC_PER_MSEC, stats.blocked_us);
+	TEST_ASSERT_LESS_THAN(USEC_PER_MSEC, stats.spin_us);
+	TEST_ASSERT_GREATER_OR_EQUAL(stats.blocked_us, stats.max_wait_us);
+}
+
+void test_semtech_busy_timeout(void)
+{
+	struct semtech_busy_stats stats;
+
+	semtech_busy_init(BUSY_GPIO);
+	TEST_ASSERT_EQUAL(SID_ERROR_TIMEOUT, semtech_busy_wait(BUSY_GPIO, BUSY_TIMEOUT_US));
+
+	semtech_busy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.timeouts);
+	TEST_ASSERT_EQUAL(1, stats.irq_waits);
+	TEST_ASSERT_FALSE(busy_irq_enabled);
+	TEST_ASSERT_GREATER_OR_EQUAL(BUSY_TIMEOUT_US - USEC_PER_MSEC, stats.max_wait_us);
+}
+
+void test_semtech_busy_irq_not_available(void)
+{
+	struct semtech_busy_stats stats;
+
+	set_irq_result = SID_ERROR_NOSUPPORT;
+	semtech_busy_init(BUSY_GPIO);
+
+	busy_release_after_reads = 100;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, semtech_busy_wait(BUSY_GPIO, BUSY_TIMEOUT_US));
+
+	semtech_busy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.irq_waits);
+	TEST_ASSERT_EQUAL(0, busy_irq_enables);
+	TEST_ASSERT_GREATER_THAN(CONFIG_SIDEWALK_SUBGHZ_BUSY_POLL_US, stats.spin_us);
+	TEST_ASSERT_EQUAL(0, stats.blocked_us);
+}
+
+void test_semtech_busy_gpio_handler_context_polls(void)
+{
+	struct semtech_busy_stats stats;
+
+	semtech_busy_init(BUSY_GPIO);
+	gpio_irq_context = true;
+
+	busy_release_after_reads = 100;
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, semtech_busy_wait(BUSY_GPIO, BUSY_TIMEOUT_US));
+
+	semtech_busy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.irq_waits);
+	TEST_ASSERT_EQUAL(0, busy_irq_enables);
+}
+
+void test_semtech_busy_critical_region_polls(void)
+{
+	struct semtech_busy_stats stats;
+
+	semtech_busy_init(BUSY_GPIO);
+	busy_release_after_reads = 100;
+
+	sid_pal_enter_critical_region();
+	sid_error_t err = semtech_busy_wait(BUSY_GPIO, BUSY_TIMEOUT_US);
+	sid_pal_exit_critical_region();
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, err);
+	semtech_busy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.irq_waits);
+	TEST_ASSERT_EQUAL(0, busy_irq_enables);
+	TEST_ASSERT_EQUAL(0, stats.blocked_us);
+}
+
+void test_semtech_busy_irq_locked_polls(void)
+{
+	struct semtech_busy_stats stats;
+
+	semtech_busy_init(BUSY_GPIO);
+	busy_release_after_reads = 100;
+
+	unsigned int key = irq_lock();
+	sid_error_t err = semtech_busy_wait(BUSY_GPIO, BUSY_TIMEOUT_US);
+
+	irq_unlock(key);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, err);
+	semtech_busy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.irq_waits);
+	TEST_ASSERT_EQUAL(0, busy_irq_enables);
+}
+
+void test_semtech_busy_stats_reset(void)
+{
+	struct semtech_busy_stats stats;
+
+	semtech_busy_init(BUSY_GPIO);
+	TEST_ASSERT_EQUAL(SID_ERROR_TIMEOUT, semtech_busy_wait(BUSY_GPIO, 100));
+	semtech_busy_stats_reset();
+
+	semtech_busy_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.waits);
+	TEST_ASSERT_EQUAL(0, stats.timeouts);
+	TEST_ASSERT_EQUAL(0, stats.spin_us);
+	TEST_ASSERT_EQUAL(0, stats.blocked_us);
+	TEST_ASSERT_EQUAL(0, stats.max_wait_us);
+}
+
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
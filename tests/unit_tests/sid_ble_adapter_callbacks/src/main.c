@@ -8,8 +8,13 @@
 #include <sid_ble_adapter_callbacks.h>
 
 #include <zephyr/bluetooth/conn.h>
+#include <zephyr/fff.h>
 #include <stdbool.h>
 
+DEFINE_FFF_GLOBALS;
+FAKE_VOID_FUNC(sid_ble_conn_activity);
+FAKE_VOID_FUNC(sid_ble_send_reset);
+
 #define TEST_DATA_CHUNK (16)
 
 typedef struct {
@@ -29,6 +34,8 @@ void setUp(void)
 	ble_indication_callback_call_cnt = 0;
 	ble_notify_callback_call_cnt = 0;
 	ble_write_data_callback_call_cnt = 0;
+	RESET_FAKE(sid_ble_conn_activity);
+	RESET_FAKE(sid_ble_send_reset);
 
 	memset(&ble_connection_callback_test, 0x00, sizeof(ble_connection_callback_test));
 }
@@ -98,6 +105,7 @@ void test_sid_ble_adapter_data_write_wo_callback(void)
 
 	sid_ble_adapter_data_write(0, data, sizeof(data));
 	TEST_ASSERT_EQUAL(0, ble_write_data_callback_call_cnt);
+	TEST_ASSERT_EQUAL(1, sid_ble_conn_activity_fake.call_count);
 }
 
 void test_sid_ble_adapter_data_cb_set(void)
@@ -137,6 +145,47 @@ void test_sid_ble_adapter_notification_changed_pass(void)
 	TEST_ASSERT_EQUAL(1, ble_notify_callback_call_cnt);
 }
 
+void test_sid_ble_adapter_notification_enabled(void)
+{
+	uint8_t ble_addr[BT_ADDR_SIZE] = { 0 };
+
+	sid_ble_adapter_notification_changed(AMA_SERVICE, false);
+	TEST_ASSERT_FALSE(sid_ble_adapter_notification_enabled(VENDOR_SERVICE));
+	sid_ble_adapter_notification_changed(VENDOR_SERVICE, true);
+	TEST_ASSERT_TRUE(sid_ble_adapter_notification_enabled(VENDOR_SERVICE));
+	TEST_ASSERT_FALSE(sid_ble_adapter_notification_enabled(AMA_SERVICE));
+	sid_ble_adapter_notification_changed(VENDOR_SERVICE, false);
+	TEST_ASSERT_FALSE(sid_ble_adapter_notification_enabled(VENDOR_SERVICE));
+
+	sid_ble_adapter_notification_changed(AMA_SERVICE, true);
+	sid_ble_adapter_conn_disconnected(ble_addr);
+	TEST_ASSERT_FALSE(sid_ble_adapter_notification_enabled(AMA_SERVICE));
+	TEST_ASSERT_FALSE(sid_ble_adapter_notification_enabled(LOGGING_SERVICE + 1));
+}
+
+static int link_params_callback_call_cnt;
+static const sid_ble_link_params_t *link_params_callback_params;
+
+static void link_params_callback(const sid_ble_link_params_t *params)
+{
+	link_params_callback_call_cnt++;
+	link_params_callback_params = params;
+}
+
+void test_sid_ble_adapter_link_params_changed(void)
+{
+	sid_ble_link_params_t params = { .interval = 6, .tx_phy = 2, .rx_phy = 2 };
+
+	TEST_ASSERT_EQUAL(SID_ERROR_INVALID_ARGS, sid_ble_adapter_link_params_cb_set(NULL));
+	sid_ble_adapter_link_params_changed(&params);
+	TEST_ASSERT_EQUAL(0, link_params_callback_call_cnt);
+
+	TEST_ASSERT_EQUAL(SID_ERROR_NONE, sid_ble_adapter_link_params_cb_set(link_params_callback));
+	sid_ble_adapter_link_params_changed(&params);
+	TEST_ASSERT_EQUAL(1, link_params_callback_call_cnt);
+	TEST_ASSERT_EQUAL_PTR(&params, link_params_callback_params);
+}
+
 void test_sid_ble_adapter_connection_changed_wo_callback(void)
 {
 	uint8_t ble_addr[BT_ADDR_SIZE] = { 0 };
@@ -164,9 +213,12 @@ void test_sid_ble_connection_changed_pass(void)
 	TEST_ASSERT_EQUAL(1, ble_connection_callback_test.call_cnt);
 	TEST_ASSERT_TRUE(ble_connection_callback_test.state);
 
+	TEST_ASSERT_EQUAL(0, sid_ble_send_reset_fake.call_count);
+
 	sid_ble_adapter_conn_disconnected(ble_addr);
 	TEST_ASSERT_EQUAL(2, ble_connection_callback_test.call_cnt);
 	TEST_ASSERT_FALSE(ble_connection_callback_test.state);
+	TEST_ASSERT_EQUAL(1, sid_ble_send_reset_fake.call_count);
 }
 
 void test_sid_ble_adapter_mtu_changed_wo_callback(void)
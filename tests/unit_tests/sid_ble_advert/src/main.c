@@ -12,6 +12,7 @@
 
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/conn.h>
+#include <zephyr/kernel.h>
 #include <errno.h>
 
 DEFINE_FFF_GLOBALS;
@@ -24,6 +25,8 @@ FAKE_VALUE_FUNC(int, bt_le_ext_adv_set_data, struct bt_le_ext_adv *, const struc
 FAKE_VALUE_FUNC(int, bt_le_ext_adv_delete, struct bt_le_ext_adv *);
 FAKE_VALUE_FUNC(int, bt_le_ext_adv_create, const struct bt_le_adv_param *,
 		const struct bt_le_ext_adv_cb *, struct bt_le_ext_adv **);
+FAKE_VALUE_FUNC(int, bt_le_ext_adv_update_param, struct bt_le_ext_adv *,
+		const struct bt_le_adv_param *);
 FAKE_VALUE_FUNC(const sid_ble_conn_params_t *, sid_ble_conn_params_get);
 
 #define FFF_FAKES_LIST(FAKE)                                                                       \
@@ -32,11 +35,19 @@ FAKE_VALUE_FUNC(const sid_ble_conn_params_t *, sid_ble_conn_params_get);
 	FAKE(bt_le_ext_adv_set_data)                                                               \
 	FAKE(bt_le_ext_adv_delete)                                                                 \
 	FAKE(bt_le_ext_adv_create)                                                                 \
+	FAKE(bt_le_ext_adv_update_param)                                                           \
 	FAKE(sid_ble_conn_params_get)
 
 #define ESUCCESS (0)
 #define TEST_BUFFER_LEN (100)
 #define BT_COMP_ID_LEN 2
+#define TEST_INTERVAL_VAL(ms) (uint16_t)((ms) / 0.625f)
+#define TEST_TRANSITION_MS (CONFIG_SIDEWALK_BLE_ADV_INT_TRANSITION * MSEC_PER_SEC + 100)
+/* Advertising data left after flags, service UUID, short name and the company ID */
+#define TEST_MANUF_DATA_LEN_MAX (BT_GAP_ADV_MAX_ADV_DATA_LEN - 2 - 3 - 4 - 4 - BT_COMP_ID_LEN)
+
+bool advert_data_manuf_data_get(const struct bt_data *ad, size_t ad_len, uint8_t *result,
+				uint8_t *result_len);
 
 void setUp(void)
 {
@@ -44,6 +55,34 @@ void setUp(void)
 	FFF_RESET_HISTORY();
 }
 
+/* Has to be the first test, the advertising buffer is empty only before the first update */
+void test_sid_ble_advert_first_update_zero_data(void)
+{
+	uint8_t test_data[TEST_MANUF_DATA_LEN_MAX] = { 0 };
+	uint8_t test_result[TEST_BUFFER_LEN] = { 0 };
+	uint8_t test_result_size;
+	bool found;
+
+	bt_le_ext_adv_stop_fake.return_val = ESUCCESS;
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+
+	bt_le_ext_adv_set_data_fake.return_val = ESUCCESS;
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data, sizeof(test_data)));
+
+	bt_le_ext_adv_start_fake.return_val = ESUCCESS;
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+
+	found = advert_data_manuf_data_get(bt_le_ext_adv_set_data_fake.arg1_val,
+					   bt_le_ext_adv_set_data_fake.arg2_val, test_result,
+					   &test_result_size);
+	TEST_ASSERT_MESSAGE(found, "Manufacturer data not found in advertising data.");
+	TEST_ASSERT_EQUAL_UINT8(sizeof(test_data), test_result_size);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(test_data, test_result, sizeof(test_data));
+
+	bt_le_ext_adv_stop_fake.return_val = ESUCCESS;
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+}
+
 void test_sid_ble_advert_start(void)
 {
 	size_t adv_start_call_count = 0;
@@ -77,6 +116,7 @@ void test_sid_ble_advert_stop(void)
 void test_sid_ble_advert_update(void)
 {
 	uint8_t test_data[] = "Lorem ipsum.";
+	uint8_t test_data_other[] = "Dolor sit amet.";
 	size_t adv_update_call_count = 0;
 
 	bt_le_ext_adv_start_fake.return_val = ESUCCESS;
@@ -87,8 +127,12 @@ void test_sid_ble_advert_update(void)
 	adv_update_call_count++;
 	TEST_ASSERT_EQUAL(adv_update_call_count, bt_le_ext_adv_set_data_fake.call_count);
 
+	/* Same data is not written again */
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data, sizeof(test_data)));
+	TEST_ASSERT_EQUAL(adv_update_call_count, bt_le_ext_adv_set_data_fake.call_count);
+
 	bt_le_ext_adv_set_data_fake.return_val = -ENOENT;
-	TEST_ASSERT_EQUAL(-ENOENT, sid_ble_advert_update(test_data, sizeof(test_data)));
+	TEST_ASSERT_EQUAL(-ENOENT, sid_ble_advert_update(test_data_other, sizeof(test_data_other)));
 	adv_update_call_count++;
 	TEST_ASSERT_EQUAL(adv_update_call_count, bt_le_ext_adv_set_data_fake.call_count);
 
@@ -196,6 +240,109 @@ void test_sid_ble_advert_update_value(void)
 	check_sid_ble_advert_update(test_data_very_long, sizeof(test_data_very_long));
 }
 
+static uint8_t test_adv_set;
+
+static int bt_le_ext_adv_create_fake1(const struct bt_le_adv_param *param,
+				      const struct bt_le_ext_adv_cb *cb, struct bt_le_ext_adv **adv)
+{
+	*adv = (struct bt_le_ext_adv *)&test_adv_set;
+	return 0;
+}
+
+static void advert_test_reset(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+	FFF_RESET_HISTORY();
+	bt_le_ext_adv_create_fake.custom_fake = bt_le_ext_adv_create_fake1;
+}
+
+void test_sid_ble_advert_transition_in_place(void)
+{
+	uint8_t test_data[] = "Lorem ipsum.";
+	uint8_t test_data_other[] = "Dolor sit amet.";
+
+	advert_test_reset();
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_deinit());
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data, sizeof(test_data)));
+
+	/* First start creates the set */
+	advert_test_reset();
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_create_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_set_data_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_start_fake.call_count);
+	TEST_ASSERT_EQUAL(3, fff.call_history_idx);
+
+	/* Fast to slow: stop, update parameters, start */
+	advert_test_reset();
+	k_sleep(K_MSEC(TEST_TRANSITION_MS));
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_stop_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_update_param_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_start_fake.call_count);
+	TEST_ASSERT_EQUAL(3, fff.call_history_idx);
+	TEST_ASSERT_EQUAL_PTR(&test_adv_set, bt_le_ext_adv_update_param_fake.arg0_val);
+	TEST_ASSERT_EQUAL(TEST_INTERVAL_VAL(CONFIG_SIDEWALK_BLE_ADV_INT_SLOW),
+			  bt_le_ext_adv_update_param_fake.arg1_val->interval_min);
+
+	/* Slow to fast */
+	advert_test_reset();
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_stop_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_update_param_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_start_fake.call_count);
+	TEST_ASSERT_EQUAL(3, fff.call_history_idx);
+	TEST_ASSERT_EQUAL(TEST_INTERVAL_VAL(CONFIG_SIDEWALK_BLE_ADV_INT_FAST),
+			  bt_le_ext_adv_update_param_fake.arg1_val->interval_min);
+
+	/* Fast to fast, parameters already set */
+	advert_test_reset();
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_stop_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_start_fake.call_count);
+	TEST_ASSERT_EQUAL(2, fff.call_history_idx);
+
+	/* Advertising data is written only when changed */
+	advert_test_reset();
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data, sizeof(test_data)));
+	TEST_ASSERT_EQUAL(0, fff.call_history_idx);
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data_other, sizeof(test_data_other)));
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_set_data_fake.call_count);
+	TEST_ASSERT_EQUAL(1, fff.call_history_idx);
+
+	advert_test_reset();
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_deinit());
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_delete_fake.call_count);
+}
+
+void test_sid_ble_advert_restart_after_connection(void)
+{
+	uint8_t test_data[] = "Lorem ipsum.";
+	uint8_t test_data_other[] = "Dolor sit amet.";
+
+	advert_test_reset();
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data, sizeof(test_data)));
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+
+	/* Advertising stopped by the connection, data is kept until the next start */
+	sid_ble_advert_notify_connection();
+	advert_test_reset();
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_update(test_data_other, sizeof(test_data_other)));
+	TEST_ASSERT_EQUAL(0, fff.call_history_idx);
+
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_start());
+	TEST_ASSERT_EQUAL(0, bt_le_ext_adv_stop_fake.call_count);
+	TEST_ASSERT_EQUAL(0, bt_le_ext_adv_update_param_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_set_data_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_le_ext_adv_start_fake.call_count);
+	TEST_ASSERT_EQUAL(2, fff.call_history_idx);
+
+	advert_test_reset();
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_stop());
+	TEST_ASSERT_EQUAL(ESUCCESS, sid_ble_advert_deinit());
+}
+
 extern int unity_main(void);
 
 int main(void)
@@ -13,6 +13,8 @@
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/gatt.h>
 
+#include <zephyr/kernel.h>
+
 #include <stdbool.h>
 #include <errno.h>
 #include <bt_app_callbacks.h>
@@ -27,6 +29,11 @@ FAKE_VALUE_FUNC(const bt_addr_le_t *, bt_conn_get_dst, const struct bt_conn *);
 FAKE_VALUE_FUNC(int, bt_conn_disconnect, struct bt_conn *, uint8_t);
 FAKE_VALUE_FUNC(int, bt_conn_get_info, const struct bt_conn *, struct bt_conn_info *);
 FAKE_VOID_FUNC(sid_ble_advert_notify_connection);
+FAKE_VALUE_FUNC(int, bt_conn_le_param_update, struct bt_conn *, const struct bt_le_conn_param *);
+FAKE_VALUE_FUNC(int, bt_conn_le_phy_update, struct bt_conn *,
+		const struct bt_conn_le_phy_param *);
+FAKE_VALUE_FUNC(int, bt_conn_le_data_len_update, struct bt_conn *,
+		const struct bt_conn_le_data_len_param *);
 
 #define FFF_FAKES_LIST(FAKE)                                                                       \
 	FAKE(bt_conn_cb_register)                                                                  \
@@ -36,7 +43,10 @@ FAKE_VOID_FUNC(sid_ble_advert_notify_connection);
 	FAKE(bt_conn_get_dst)                                                                      \
 	FAKE(bt_conn_disconnect)                                                                   \
 	FAKE(bt_conn_get_info)                                                                     \
-	FAKE(sid_ble_advert_notify_connection)
+	FAKE(sid_ble_advert_notify_connection)                                                     \
+	FAKE(bt_conn_le_param_update)                                                              \
+	FAKE(bt_conn_le_phy_update)                                                                \
+	FAKE(bt_conn_le_data_len_update)
 
 #define CONNECTED (true)
 #define DISCONNECTED (false)
@@ -56,12 +66,52 @@ static connection_callback_test_t conn_cb_test;
 static struct bt_conn_cb *sid_bt_conn_cb;
 static struct bt_gatt_cb *sid_bt_gatt_cb;
 
+static size_t link_params_cb_calls;
+static sid_ble_link_params_t link_params_last;
+
+/* Parameters are passed as compound literals, so they are copied when the fake is called */
+static struct bt_le_conn_param conn_param_last;
+static struct bt_conn_le_phy_param phy_param_last;
+static struct bt_conn_le_data_len_param data_len_param_last;
+
+static void link_params_callback(const sid_ble_link_params_t *params, int cmock_num_calls)
+{
+	link_params_cb_calls++;
+	link_params_last = *params;
+}
+
+static int bt_conn_le_param_update_fake1(struct bt_conn *conn, const struct bt_le_conn_param *param)
+{
+	conn_param_last = *param;
+	return 0;
+}
+
+static int bt_conn_le_phy_update_fake1(struct bt_conn *conn,
+				       const struct bt_conn_le_phy_param *param)
+{
+	phy_param_last = *param;
+	return 0;
+}
+
+static int bt_conn_le_data_len_update_fake1(struct bt_conn *conn,
+					    const struct bt_conn_le_data_len_param *param)
+{
+	data_len_param_last = *param;
+	return 0;
+}
+
 void setUp(void)
 {
 	FFF_FAKES_LIST(RESET_FAKE);
 	FFF_RESET_HISTORY();
 	memset(&conn_cb_test, 0x00, sizeof(conn_cb_test));
+	link_params_cb_calls = 0;
+	memset(&link_params_last, 0x00, sizeof(link_params_last));
 	cmock_sid_ble_adapter_callbacks_Init();
+	__cmock_sid_ble_adapter_link_params_changed_StubWithCallback(link_params_callback);
+	bt_conn_le_param_update_fake.custom_fake = bt_conn_le_param_update_fake1;
+	bt_conn_le_phy_update_fake.custom_fake = bt_conn_le_phy_update_fake1;
+	bt_conn_le_data_len_update_fake.custom_fake = bt_conn_le_data_len_update_fake1;
 }
 
 void tearDown(void)
@@ -319,6 +369,138 @@ void test_sid_ble_conn_disconnect(void)
 	TEST_ASSERT_NOT_EQUAL(ESUCCESS, sid_ble_conn_disconnect());
 }
 
+static int bt_conn_get_info_fake2(const struct bt_conn *a, struct bt_conn_info *b)
+{
+	b->id = BT_ID_SIDEWALK;
+	b->le.interval = 24;
+	b->le.latency = 0;
+	b->le.timeout = 42;
+	return 0;
+}
+
+static int fff_call_index(void *fn)
+{
+	for (int i = 0; i < fff.call_history_idx; i++) {
+		if (fff.call_history[i] == fn) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void test_sid_ble_conn_throughput_negotiation(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+	const bt_addr_le_t test_addr = { 0 };
+	const sid_ble_conn_params_t *params = NULL;
+
+	bt_conn_get_dst_fake.return_val = &test_addr;
+	bt_conn_ref_fake.return_val = &test_conn;
+	bt_conn_get_info_fake.custom_fake = bt_conn_get_info_fake2;
+
+	sid_ble_conn_init();
+	__cmock_sid_ble_adapter_conn_connected_ExpectAnyArgs();
+	sid_bt_conn_cb->connected(&test_conn, BT_HCI_ERR_SUCCESS);
+
+	/* Link parameters of the new connection are reported first */
+	TEST_ASSERT_EQUAL(1, link_params_cb_calls);
+	TEST_ASSERT_EQUAL(24, link_params_last.interval);
+	TEST_ASSERT_EQUAL(42, link_params_last.timeout);
+	TEST_ASSERT_EQUAL(BT_GAP_LE_PHY_1M, link_params_last.tx_phy);
+	TEST_ASSERT_EQUAL(BT_GAP_DATA_LEN_DEFAULT, link_params_last.tx_max_len);
+
+	/* 2M PHY, then the maximum data length, then the short connection interval */
+	TEST_ASSERT_EQUAL(1, bt_conn_le_phy_update_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_conn_le_data_len_update_fake.call_count);
+	TEST_ASSERT_EQUAL(1, bt_conn_le_param_update_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(&test_conn, bt_conn_le_phy_update_fake.arg0_val);
+	TEST_ASSERT_EQUAL_PTR(&test_conn, bt_conn_le_data_len_update_fake.arg0_val);
+	TEST_ASSERT_EQUAL_PTR(&test_conn, bt_conn_le_param_update_fake.arg0_val);
+	TEST_ASSERT_LESS_THAN(fff_call_index((void *)bt_conn_le_data_len_update),
+			      fff_call_index((void *)bt_conn_le_phy_update));
+	TEST_ASSERT_LESS_THAN(fff_call_index((void *)bt_conn_le_param_update),
+			      fff_call_index((void *)bt_conn_le_data_len_update));
+
+	TEST_ASSERT_EQUAL(BT_GAP_LE_PHY_2M, phy_param_last.pref_tx_phy);
+	TEST_ASSERT_EQUAL(BT_GAP_LE_PHY_2M, phy_param_last.pref_rx_phy);
+	TEST_ASSERT_EQUAL(BT_GAP_DATA_LEN_MAX, data_len_param_last.tx_max_len);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_CONN_INT_FAST_MIN, conn_param_last.interval_min);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_CONN_INT_FAST_MAX, conn_param_last.interval_max);
+	TEST_ASSERT_EQUAL(0, conn_param_last.latency);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_CONN_TIMEOUT, conn_param_last.timeout);
+
+	/* The peer answers, every change reaches the adapter callbacks */
+	struct bt_conn_le_phy_info phy_info = { .tx_phy = BT_GAP_LE_PHY_2M,
+						.rx_phy = BT_GAP_LE_PHY_2M };
+	sid_bt_conn_cb->le_phy_updated(&test_conn, &phy_info);
+	TEST_ASSERT_EQUAL(2, link_params_cb_calls);
+	TEST_ASSERT_EQUAL(BT_GAP_LE_PHY_2M, link_params_last.tx_phy);
+	TEST_ASSERT_EQUAL(BT_GAP_LE_PHY_2M, link_params_last.rx_phy);
+
+	struct bt_conn_le_data_len_info data_len_info = { .tx_max_len = 251, .rx_max_len = 251 };
+	sid_bt_conn_cb->le_data_len_updated(&test_conn, &data_len_info);
+	TEST_ASSERT_EQUAL(3, link_params_cb_calls);
+	TEST_ASSERT_EQUAL(251, link_params_last.tx_max_len);
+	TEST_ASSERT_EQUAL(251, link_params_last.rx_max_len);
+
+	sid_bt_conn_cb->le_param_updated(&test_conn, CONFIG_SIDEWALK_BLE_CONN_INT_FAST_MAX, 0,
+					 CONFIG_SIDEWALK_BLE_CONN_TIMEOUT);
+	TEST_ASSERT_EQUAL(4, link_params_cb_calls);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_CONN_INT_FAST_MAX, link_params_last.interval);
+
+	params = sid_ble_conn_params_get();
+	TEST_ASSERT_EQUAL_MEMORY(&link_params_last, &params->link, sizeof(params->link));
+
+	/* Updates of other connections are not reported */
+	struct bt_conn other_conn = { .dummy = 0xAB };
+	sid_bt_conn_cb->le_param_updated(&other_conn, 6, 0, 100);
+	TEST_ASSERT_EQUAL(4, link_params_cb_calls);
+
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	sid_bt_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+}
+
+void test_sid_ble_conn_idle_profile(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+	const bt_addr_le_t test_addr = { 0 };
+
+	bt_conn_get_dst_fake.return_val = &test_addr;
+	bt_conn_ref_fake.return_val = &test_conn;
+	bt_conn_get_info_fake.custom_fake = bt_conn_get_info_fake2;
+
+	sid_ble_conn_init();
+	__cmock_sid_ble_adapter_conn_connected_ExpectAnyArgs();
+	sid_bt_conn_cb->connected(&test_conn, BT_HCI_ERR_SUCCESS);
+	TEST_ASSERT_EQUAL(1, bt_conn_le_param_update_fake.call_count);
+
+	/* Data keeps the throughput profile */
+	k_sleep(K_MSEC(CONFIG_SIDEWALK_BLE_CONN_IDLE_TIMEOUT / 2));
+	sid_ble_conn_activity();
+	k_sleep(K_MSEC(CONFIG_SIDEWALK_BLE_CONN_IDLE_TIMEOUT / 2 + 10));
+	TEST_ASSERT_EQUAL(1, bt_conn_le_param_update_fake.call_count);
+
+	/* No data, low power profile */
+	k_sleep(K_MSEC(CONFIG_SIDEWALK_BLE_CONN_IDLE_TIMEOUT));
+	TEST_ASSERT_EQUAL(2, bt_conn_le_param_update_fake.call_count);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_CONN_INT_SLOW_MIN, conn_param_last.interval_min);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_CONN_INT_SLOW_MAX, conn_param_last.interval_max);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_CONN_LATENCY_SLOW, conn_param_last.latency);
+
+	/* Next packet, throughput profile again */
+	sid_ble_conn_activity();
+	k_sleep(K_MSEC(1));
+	TEST_ASSERT_EQUAL(3, bt_conn_le_param_update_fake.call_count);
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_CONN_INT_FAST_MAX, conn_param_last.interval_max);
+
+	/* Nothing is requested after disconnect */
+	__cmock_sid_ble_adapter_conn_disconnected_ExpectAnyArgs();
+	sid_bt_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	sid_ble_conn_activity();
+	k_sleep(K_MSEC(CONFIG_SIDEWALK_BLE_CONN_IDLE_TIMEOUT + 10));
+	TEST_ASSERT_EQUAL(3, bt_conn_le_param_update_fake.call_count);
+}
+
 extern int unity_main(void);
 
 int main(void)
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <zephyr/fff.h>
+
+#include <sid_ble_link_quality.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/hci_vs.h>
+
+#include <errno.h>
+#include <string.h>
+#include <bt_app_callbacks.h>
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, bt_conn_cb_register, struct bt_conn_cb *);
+FAKE_VALUE_FUNC(struct bt_conn *, bt_conn_ref, struct bt_conn *);
+FAKE_VOID_FUNC(bt_conn_unref, struct bt_conn *);
+FAKE_VALUE_FUNC(int, bt_conn_get_info, const struct bt_conn *, struct bt_conn_info *);
+FAKE_VALUE_FUNC(int, bt_hci_get_conn_handle, const struct bt_conn *, uint16_t *);
+FAKE_VALUE_FUNC(struct net_buf *, bt_hci_cmd_create, uint16_t, uint8_t);
+FAKE_VALUE_FUNC(int, bt_hci_cmd_send_sync, uint16_t, struct net_buf *, struct net_buf **);
+FAKE_VALUE_FUNC(void *, net_buf_simple_add, struct net_buf_simple *, size_t);
+FAKE_VOID_FUNC(net_buf_unref, struct net_buf *);
+
+#define FFF_FAKES_LIST(FAKE)                                                                       \
+	FAKE(bt_conn_cb_register)                                                                  \
+	FAKE(bt_conn_ref)                                                                          \
+	FAKE(bt_conn_unref)                                                                        \
+	FAKE(bt_conn_get_info)                                                                     \
+	FAKE(bt_hci_get_conn_handle)                                                               \
+	FAKE(bt_hci_cmd_create)                                                                    \
+	FAKE(bt_hci_cmd_send_sync)                                                                 \
+	FAKE(net_buf_simple_add)                                                                   \
+	FAKE(net_buf_unref)
+
+#define TEST_SAMPLE_MS (CONFIG_SIDEWALK_BLE_LINK_QUALITY_INTERVAL_MS + 10)
+
+struct bt_conn {
+	uint8_t dummy;
+};
+
+static struct bt_conn_cb *lq_conn_cb;
+
+static struct net_buf test_cmd;
+static struct net_buf test_rsp;
+static uint8_t test_cmd_data[8];
+static uint8_t test_rsp_data[8];
+
+static int8_t test_rssi;
+static int8_t test_tx_power;
+static uint8_t test_conn_id;
+
+static struct bt_conn *bt_conn_ref_fake1(struct bt_conn *conn)
+{
+	return conn;
+}
+
+static int bt_conn_get_info_fake1(const struct bt_conn *conn, struct bt_conn_info *info)
+{
+	info->id = test_conn_id;
+	return 0;
+}
+
+static void *net_buf_simple_add_fake1(struct net_buf_simple *buf, size_t len)
+{
+	return test_cmd_data;
+}
+
+static int bt_hci_cmd_send_sync_fake1(uint16_t opcode, struct net_buf *buf, struct net_buf **rsp)
+{
+	memset(test_rsp_data, 0x00, sizeof(test_rsp_data));
+	test_rsp.data = test_rsp_data;
+
+	switch (opcode) {
+	case BT_HCI_OP_READ_RSSI:
+		((struct bt_hci_rp_read_rssi *)test_rsp_data)->rssi = test_rssi;
+		break;
+	case BT_HCI_OP_VS_READ_TX_POWER_LEVEL:
+		((struct bt_hci_rp_vs_read_tx_power_level *)test_rsp_data)->tx_power_level =
+			test_tx_power;
+		break;
+	case BT_HCI_OP_VS_WRITE_TX_POWER_LEVEL:
+		((struct bt_hci_rp_vs_write_tx_power_level *)test_rsp_data)->selected_tx_power =
+			((struct bt_hci_cp_vs_write_tx_power_level *)test_cmd_data)->tx_power_level;
+		break;
+	default:
+		return -EIO;
+	}
+
+	*rsp = &test_rsp;
+	return 0;
+}
+
+static size_t hci_opcode_count(uint16_t opcode)
+{
+	size_t count = 0;
+
+	for (size_t i = 0; i < bt_hci_cmd_send_sync_fake.call_count &&
+			   i < FFF_ARG_HISTORY_LEN;
+	     i++) {
+		if (bt_hci_cmd_send_sync_fake.arg0_history[i] == opcode) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void setUp(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+	FFF_RESET_HISTORY();
+
+	test_rssi = -60;
+	test_tx_power = 4;
+	test_conn_id = BT_ID_SIDEWALK;
+
+	bt_conn_ref_fake.custom_fake = bt_conn_ref_fake1;
+	bt_conn_get_info_fake.custom_fake = bt_conn_get_info_fake1;
+	bt_hci_cmd_create_fake.return_val = &test_cmd;
+	net_buf_simple_add_fake.custom_fake = net_buf_simple_add_fake1;
+	bt_hci_cmd_send_sync_fake.custom_fake = bt_hci_cmd_send_sync_fake1;
+
+	sid_ble_lq_init();
+}
+
+void tearDown(void)
+{
+	sid_ble_lq_deinit();
+}
+
+void test_sid_ble_lq_init(void)
+{
+	TEST_ASSERT_EQUAL(1, bt_conn_cb_register_fake.call_count);
+	lq_conn_cb = bt_conn_cb_register_fake.arg0_val;
+	TEST_ASSERT_NOT_NULL(lq_conn_cb);
+	TEST_ASSERT_NOT_NULL(lq_conn_cb->connected);
+	TEST_ASSERT_NOT_NULL(lq_conn_cb->disconnected);
+
+	/* Callbacks are registered once */
+	sid_ble_lq_deinit();
+	sid_ble_lq_init();
+	TEST_ASSERT_EQUAL(1, bt_conn_cb_register_fake.call_count);
+}
+
+void test_sid_ble_lq_no_connection(void)
+{
+	int8_t rssi;
+	int8_t tx_power;
+	struct sid_ble_lq_sample samples[2];
+
+	TEST_ASSERT_EQUAL(-ENODATA, sid_ble_lq_rssi_get(&rssi));
+	TEST_ASSERT_EQUAL(-ENODATA, sid_ble_lq_tx_power_get(&tx_power));
+	TEST_ASSERT_EQUAL(0, sid_ble_lq_history_get(samples, ARRAY_SIZE(samples)));
+	TEST_ASSERT_EQUAL(-EINVAL, sid_ble_lq_rssi_get(NULL));
+}
+
+void test_sid_ble_lq_sampling(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+	struct sid_ble_lq_sample samples[CONFIG_SIDEWALK_BLE_LINK_QUALITY_HISTORY + 1];
+	int8_t rssi;
+	int8_t tx_power;
+
+	lq_conn_cb->connected(&test_conn, BT_HCI_ERR_SUCCESS);
+	k_sleep(K_MSEC(10));
+
+	/* First sample right after connect */
+	TEST_ASSERT_EQUAL(0, sid_ble_lq_rssi_get(&rssi));
+	TEST_ASSERT_EQUAL(-60, rssi);
+	TEST_ASSERT_EQUAL(0, sid_ble_lq_tx_power_get(&tx_power));
+	TEST_ASSERT_EQUAL(4, tx_power);
+
+	/* Getters do not reach the controller */
+	size_t hci_calls = bt_hci_cmd_send_sync_fake.call_count;
+	TEST_ASSERT_EQUAL(0, sid_ble_lq_rssi_get(&rssi));
+	TEST_ASSERT_EQUAL(hci_calls, bt_hci_cmd_send_sync_fake.call_count);
+
+	/* Average follows the new RSSI with 1/2^CONFIG_SIDEWALK_BLE_LINK_QUALITY_EWMA_SHIFT weight */
+	test_rssi = -40;
+	k_sleep(K_MSEC(CONFIG_SIDEWALK_BLE_LINK_QUALITY_INTERVAL_MS));
+	TEST_ASSERT_EQUAL(0, sid_ble_lq_rssi_get(&rssi));
+	TEST_ASSERT_EQUAL(-50, rssi);
+
+	TEST_ASSERT_EQUAL(2, sid_ble_lq_history_get(samples, ARRAY_SIZE(samples)));
+	TEST_ASSERT_EQUAL(-40, samples[0].rssi);
+	TEST_ASSERT_EQUAL(-60, samples[1].rssi);
+	TEST_ASSERT_EQUAL(4, samples[0].tx_power);
+	TEST_ASSERT_GREATER_THAN(samples[1].uptime_ms, samples[0].uptime_ms);
+
+	/* TX power is read once per connection */
+	TEST_ASSERT_EQUAL(1, hci_opcode_count(BT_HCI_OP_VS_READ_TX_POWER_LEVEL));
+	TEST_ASSERT_EQUAL(2, hci_opcode_count(BT_HCI_OP_READ_RSSI));
+
+	/* History keeps the latest samples */
+	k_sleep(K_MSEC(CONFIG_SIDEWALK_BLE_LINK_QUALITY_INTERVAL_MS *
+		       CONFIG_SIDEWALK_BLE_LINK_QUALITY_HISTORY));
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_BLE_LINK_QUALITY_HISTORY,
+			  sid_ble_lq_history_get(samples, ARRAY_SIZE(samples)));
+
+	lq_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	TEST_ASSERT_EQUAL(-ENODATA, sid_ble_lq_rssi_get(&rssi));
+	TEST_ASSERT_EQUAL(-ENODATA, sid_ble_lq_tx_power_get(&tx_power));
+	TEST_ASSERT_EQUAL(1, bt_conn_unref_fake.call_count);
+
+	/* No sampling without connection */
+	hci_calls = bt_hci_cmd_send_sync_fake.call_count;
+	k_sleep(K_MSEC(TEST_SAMPLE_MS));
+	TEST_ASSERT_EQUAL(hci_calls, bt_hci_cmd_send_sync_fake.call_count);
+}
+
+void test_sid_ble_lq_stale(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+	int8_t rssi;
+	int8_t tx_power;
+
+	lq_conn_cb->connected(&test_conn, BT_HCI_ERR_SUCCESS);
+	k_sleep(K_MSEC(10));
+	TEST_ASSERT_EQUAL(0, sid_ble_lq_rssi_get(&rssi));
+
+	/* Controller does not respond, the cache gets too old */
+	bt_hci_cmd_send_sync_fake.custom_fake = NULL;
+	bt_hci_cmd_send_sync_fake.return_val = -EIO;
+	k_sleep(K_MSEC(CONFIG_SIDEWALK_BLE_LINK_QUALITY_MAX_AGE_MS + 10));
+	TEST_ASSERT_EQUAL(-ETIME, sid_ble_lq_rssi_get(&rssi));
+	TEST_ASSERT_EQUAL(-ETIME, sid_ble_lq_tx_power_get(&tx_power));
+
+	/* Blocking read is still available */
+	bt_hci_cmd_send_sync_fake.custom_fake = bt_hci_cmd_send_sync_fake1;
+	TEST_ASSERT_EQUAL(0, sid_ble_lq_rssi_read(&test_conn, &rssi));
+	TEST_ASSERT_EQUAL(-60, rssi);
+
+	lq_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+}
+
+void test_sid_ble_lq_tx_power_write(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+	int8_t tx_power;
+
+	lq_conn_cb->connected(&test_conn, BT_HCI_ERR_SUCCESS);
+	k_sleep(K_MSEC(10));
+
+	TEST_ASSERT_EQUAL(0, sid_ble_lq_tx_power_write(&test_conn, -8));
+	TEST_ASSERT_EQUAL(0, sid_ble_lq_tx_power_get(&tx_power));
+	TEST_ASSERT_EQUAL(-8, tx_power);
+
+	/* The selected level is used, no need to read it back */
+	k_sleep(K_MSEC(TEST_SAMPLE_MS));
+	TEST_ASSERT_EQUAL(1, hci_opcode_count(BT_HCI_OP_VS_READ_TX_POWER_LEVEL));
+
+	lq_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+}
+
+void test_sid_ble_lq_other_identity(void)
+{
+	struct bt_conn test_conn = { .dummy = 0xDC };
+	int8_t rssi;
+
+	test_conn_id = BT_ID_DEFAULT;
+	lq_conn_cb->connected(&test_conn, BT_HCI_ERR_SUCCESS);
+	k_sleep(K_MSEC(TEST_SAMPLE_MS));
+
+	TEST_ASSERT_EQUAL(0, bt_hci_cmd_send_sync_fake.call_count);
+	TEST_ASSERT_EQUAL(-ENODATA, sid_ble_lq_rssi_get(&rssi));
+
+	lq_conn_cb->disconnected(&test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	TEST_ASSERT_EQUAL(0, bt_conn_unref_fake.call_count);
+}
+
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
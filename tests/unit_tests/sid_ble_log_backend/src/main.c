@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <zephyr/fff.h>
+
+#include <sid_ble_log_backend.h>
+#include <sid_ble_service.h>
+#include <sid_ble_connection.h>
+#include <cmock_sid_ble_adapter_callbacks.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/logging/log.h>
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(test_ble_log, LOG_LEVEL_INF);
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, bt_gatt_notify_cb, struct bt_conn *, struct bt_gatt_notify_params *);
+FAKE_VALUE_FUNC(const struct bt_gatt_attr *, sid_ble_srv_notify_attr_get,
+		const struct bt_gatt_service_static *, const struct bt_uuid *);
+FAKE_VALUE_FUNC(const struct bt_gatt_service_static *, sid_ble_get_log_service);
+FAKE_VALUE_FUNC(const sid_ble_conn_params_t *, sid_ble_conn_params_get);
+
+#define FFF_FAKES_LIST(FAKE)                                                                       \
+	FAKE(bt_gatt_notify_cb)                                                                    \
+	FAKE(sid_ble_srv_notify_attr_get)                                                          \
+	FAKE(sid_ble_get_log_service)                                                              \
+	FAKE(sid_ble_conn_params_get)
+
+#define TEST_MTU 247
+#define TEST_PAYLOAD_MAX (TEST_MTU - 3)
+#define TEST_RECORD_LEN 40
+
+struct bt_conn {
+	uint8_t dummy;
+};
+
+static struct bt_conn test_conn;
+static struct bt_gatt_attr test_attr;
+static sid_ble_conn_params_t test_conn_params;
+
+/* Peer side: payloads of all notifications received */
+static uint8_t received[8192];
+static size_t received_len;
+static bool notify_hold;
+static struct bt_gatt_notify_params held_params;
+static int notify_errors;
+
+static int notify_fake(struct bt_conn *conn, struct bt_gatt_notify_params *params)
+{
+	TEST_ASSERT_EQUAL_PTR(&test_conn, conn);
+	TEST_ASSERT_EQUAL_PTR(&test_attr, params->attr);
+	TEST_ASSERT_TRUE(params->len <= test_conn_params.mtu - 3);
+
+	if (notify_errors) {
+		notify_errors--;
+		return -ENOMEM;
+	}
+
+	TEST_ASSERT_TRUE(received_len + params->len <= sizeof(received));
+	memcpy(&received[received_len], params->data, params->len);
+	received_len += params->len;
+
+	if (notify_hold) {
+		held_params = *params;
+	} else {
+		params->func(conn, params->user_data);
+	}
+
+	return 0;
+}
+
+static size_t record_make(uint8_t *buf, int idx)
+{
+	/* TEST_RECORD_LEN bytes */
+	snprintf((char *)buf, TEST_RECORD_LEN + 1, "rec %03d 0123456789abcdefghijklmnopqrstu\n", idx);
+	return TEST_RECORD_LEN;
+}
+
+static void records_write(int first, int count)
+{
+	uint8_t buf[TEST_RECORD_LEN + 1];
+
+	for (int i = first; i < first + count; i++) {
+		sid_ble_log_backend_write(buf, record_make(buf, i));
+	}
+}
+
+static void records_assert_received(int first, int count)
+{
+	uint8_t buf[TEST_RECORD_LEN + 1];
+
+	TEST_ASSERT_EQUAL(count * TEST_RECORD_LEN, received_len);
+	for (int i = 0; i < count; i++) {
+		record_make(buf, first + i);
+		TEST_ASSERT_EQUAL_MEMORY(buf, &received[i * TEST_RECORD_LEN], TEST_RECORD_LEN);
+	}
+}
+
+/* Wait until the backend stops sending */
+static void drain(void)
+{
+	struct sid_ble_log_backend_stats stats;
+	uint32_t notifications;
+
+	do {
+		sid_ble_log_backend_stats_get(&stats);
+		notifications = stats.notifications;
+		k_sleep(K_MSEC(5 * CONFIG_SIDEWALK_LOG_BACKEND_BLE_INTERVAL_MS));
+		sid_ble_log_backend_stats_get(&stats);
+	} while (stats.notifications != notifications);
+}
+
+void setUp(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+	FFF_RESET_HISTORY();
+
+	test_conn_params = (sid_ble_conn_params_t){ .conn = &test_conn, .mtu = TEST_MTU };
+	sid_ble_conn_params_get_fake.return_val = &test_conn_params;
+	sid_ble_srv_notify_attr_get_fake.return_val = &test_attr;
+	bt_gatt_notify_cb_fake.custom_fake = notify_fake;
+	__cmock_sid_ble_adapter_notification_enabled_IgnoreAndReturn(true);
+
+	notify_hold = false;
+	notify_errors = 0;
+	drain();
+	received_len = 0;
+	sid_ble_log_backend_stats_reset();
+}
+
+/******************************************************************
+* sid_ble_log_backend
+* ****************************************************************/
+
+void test_batching_efficiency(void)
+{
+	struct sid_ble_log_backend_stats stats;
+	const int count = 60;
+
+	records_write(0, count);
+	drain();
+
+	records_assert_received(0, count);
+	sid_ble_log_backend_stats_get(&stats);
+	TEST_ASSERT_EQUAL(count, stats.records);
+	TEST_ASSERT_EQUAL(0, stats.dropped);
+	TEST_ASSERT_EQUAL(count * TEST_RECORD_LEN, stats.bytes);
+	/* Every notification but the last one is full */
+	TEST_ASSERT_EQUAL(DIV_ROUND_UP(count * TEST_RECORD_LEN, TEST_PAYLOAD_MAX),
+			  stats.notifications);
+
+	printk("%u records of %u B in %u notifications: %u B per notification, max %u B\n",
+	       stats.records, TEST_RECORD_LEN, stats.notifications,
+	       (uint32_t)(stats.bytes / stats.notifications), TEST_PAYLOAD_MAX);
+}
+
+void test_payload_limited_by_mtu(void)
+{
+	struct sid_ble_log_backend_stats stats;
+
+	test_conn_params.mtu = BT_ATT_DEFAULT_LE_MTU;
+	records_write(0, 3);
+	drain();
+
+	/* Records are split over notifications of the default MTU */
+	records_assert_received(0, 3);
+	sid_ble_log_backend_stats_get(&stats);
+	TEST_ASSERT_EQUAL(DIV_ROUND_UP(3 * TEST_RECORD_LEN, BT_ATT_DEFAULT_LE_MTU - 3),
+			  stats.notifications);
+}
+
+void test_full_ring_drops_oldest(void)
+{
+	struct sid_ble_log_backend_stats stats;
+	const int fit = CONFIG_SIDEWALK_LOG_BACKEND_BLE_BUFFER_SIZE / (TEST_RECORD_LEN + 2);
+	const int count = fit + 23;
+
+	__cmock_sid_ble_adapter_notification_enabled_IgnoreAndReturn(false);
+	records_write(0, count);
+	drain();
+
+	TEST_ASSERT_EQUAL(0, bt_gatt_notify_cb_fake.call_count);
+	sid_ble_log_backend_stats_get(&stats);
+	TEST_ASSERT_EQUAL(count, stats.records);
+	TEST_ASSERT_EQUAL(count - fit, stats.dropped);
+	TEST_ASSERT_EQUAL((count - fit) * TEST_RECORD_LEN, stats.dropped_bytes);
+
+	/* The newest records are sent once the peer subscribes */
+	__cmock_sid_ble_adapter_notification_enabled_IgnoreAndReturn(true);
+	sid_ble_log_backend_kick();
+	drain();
+	records_assert_received(count - fit, fit);
+}
+
+void test_split_record_oldest_dropped(void)
+{
+	struct sid_ble_log_backend_stats stats;
+	const int fit = CONFIG_SIDEWALK_LOG_BACKEND_BLE_BUFFER_SIZE / (TEST_RECORD_LEN + 2);
+
+	/* Default MTU, the first record is split between notifications */
+	test_conn_params.mtu = BT_ATT_DEFAULT_LE_MTU;
+	notify_hold = true;
+	records_write(0, 1);
+	drain();
+	TEST_ASSERT_EQUAL(1, bt_gatt_notify_cb_fake.call_count);
+
+	/* The ring is full, the oldest whole record is dropped for the newest one */
+	records_write(1, fit + 1);
+	sid_ble_log_backend_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.dropped);
+	TEST_ASSERT_EQUAL(TEST_RECORD_LEN, stats.dropped_bytes);
+
+	notify_hold = false;
+	held_params.func(&test_conn, held_params.user_data);
+	drain();
+
+	/* The split record is completed, then the records after the dropped one follow */
+	TEST_ASSERT_EQUAL((fit + 1) * TEST_RECORD_LEN, received_len);
+	uint8_t buf[TEST_RECORD_LEN + 1];
+
+	record_make(buf, 0);
+	TEST_ASSERT_EQUAL_MEMORY(buf, received, TEST_RECORD_LEN);
+	for (int i = 0; i < fit; i++) {
+		record_make(buf, 2 + i);
+		TEST_ASSERT_EQUAL_MEMORY(buf, &received[(i + 1) * TEST_RECORD_LEN],
+					 TEST_RECORD_LEN);
+	}
+}
+
+void test_one_notification_in_flight(void)
+{
+	notify_hold = true;
+	records_write(0, 20);
+	drain();
+	TEST_ASSERT_EQUAL(1, bt_gatt_notify_cb_fake.call_count);
+
+	notify_hold = false;
+	held_params.func(&test_conn, held_params.user_data);
+	drain();
+	records_assert_received(0, 20);
+}
+
+void test_reset_drops_notification_in_flight(void)
+{
+	notify_hold = true;
+	records_write(0, 2);
+	drain();
+	TEST_ASSERT_EQUAL(1, bt_gatt_notify_cb_fake.call_count);
+
+	/* The link drops, the held notification never completes. */
+	sid_ble_log_backend_reset();
+	notify_hold = false;
+	records_write(2, 2);
+	sid_ble_log_backend_kick();
+	drain();
+	TEST_ASSERT_EQUAL(2, bt_gatt_notify_cb_fake.call_count);
+	records_assert_received(0, 4);
+}
+
+void test_reset_drops_pending_notification(void)
+{
+	struct sid_ble_log_backend_stats stats;
+
+	notify_errors = INT_MAX;
+	records_write(0, 2);
+	drain();
+	sid_ble_log_backend_reset();
+	sid_ble_log_backend_stats_get(&stats);
+	TEST_ASSERT_EQUAL(2 * TEST_RECORD_LEN, stats.dropped_bytes);
+
+	notify_errors = 0;
+	records_write(2, 2);
+	sid_ble_log_backend_kick();
+	drain();
+	records_assert_received(2, 2);
+}
+
+void test_busy_host_retried(void)
+{
+	struct sid_ble_log_backend_stats stats;
+
+	notify_errors = 2;
+	records_write(0, 2);
+	drain();
+
+	records_assert_received(0, 2);
+	sid_ble_log_backend_stats_get(&stats);
+	TEST_ASSERT_EQUAL(2, stats.send_errors);
+	TEST_ASSERT_EQUAL(1, stats.notifications);
+	TEST_ASSERT_EQUAL(0, stats.dropped_bytes);
+}
+
+void test_not_connected(void)
+{
+	sid_ble_conn_params_get_fake.return_val = NULL;
+	records_write(0, 2);
+	drain();
+	TEST_ASSERT_EQUAL(0, bt_gatt_notify_cb_fake.call_count);
+
+	test_conn_params.mtu = 0;
+	sid_ble_conn_params_get_fake.return_val = &test_conn_params;
+	sid_ble_log_backend_kick();
+	drain();
+	TEST_ASSERT_EQUAL(0, bt_gatt_notify_cb_fake.call_count);
+
+	test_conn_params.mtu = TEST_MTU;
+	sid_ble_log_backend_kick();
+	drain();
+	records_assert_received(0, 2);
+}
+
+void test_long_record_truncated(void)
+{
+	struct sid_ble_log_backend_stats stats;
+	uint8_t buf[CONFIG_SIDEWALK_LOG_BACKEND_BLE_RECORD_MAX + 10];
+
+	memset(buf, 'x', sizeof(buf));
+	sid_ble_log_backend_write(buf, sizeof(buf));
+	drain();
+
+	TEST_ASSERT_EQUAL(CONFIG_SIDEWALK_LOG_BACKEND_BLE_RECORD_MAX, received_len);
+	sid_ble_log_backend_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.truncated);
+}
+
+void test_log_message(void)
+{
+	LOG_INF("hello %d", 42);
+	drain();
+
+	received[received_len] = '\0';
+	TEST_ASSERT_NOT_NULL(strstr((char *)received, "<inf> test_ble_log: hello 42\n"));
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
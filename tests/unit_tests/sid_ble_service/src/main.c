@@ -17,9 +17,6 @@
 
 DEFINE_FFF_GLOBALS;
 
-FAKE_VALUE_FUNC(uint16_t, bt_gatt_get_mtu, struct bt_conn *);
-FAKE_VALUE_FUNC(bool, bt_gatt_is_subscribed, struct bt_conn *, const struct bt_gatt_attr *,
-		uint16_t);
 FAKE_VALUE_FUNC(int, bt_gatt_notify_cb, struct bt_conn *, struct bt_gatt_notify_params *);
 FAKE_VALUE_FUNC(struct bt_gatt_attr *, bt_gatt_find_by_uuid, const struct bt_gatt_attr *, uint16_t,
 		const struct bt_uuid *);
@@ -37,8 +34,6 @@ FAKE_VALUE_FUNC(ssize_t, bt_gatt_attr_write_ccc, struct bt_conn *, const struct
 		const void *, uint16_t, uint16_t, uint8_t);
 
 #define FFF_FAKES_LIST(FAKE)                                                                       \
-	FAKE(bt_gatt_get_mtu)                                                                      \
-	FAKE(bt_gatt_is_subscribed)                                                                \
 	FAKE(bt_gatt_notify_cb)                                                                    \
 	FAKE(bt_gatt_find_by_uuid)                                                                 \
 	FAKE(bt_gatt_attr_read_service)                                                            \
@@ -65,10 +60,39 @@ void test_sid_ble_send_data_null_ptr(void)
 	TEST_ASSERT_EQUAL(-ENOENT, sid_ble_send_data(NULL, data, sizeof(data)));
 }
 
+static void srv_params_set(sid_ble_srv_params_t *params, struct bt_conn *conn,
+			   const struct bt_gatt_attr *attr, uint16_t mtu, bool subscribed)
+{
+	*params = (sid_ble_srv_params_t){
+		.conn = conn,
+		.attr = attr,
+		.mtu = mtu,
+		.subscribed = subscribed,
+	};
+}
+
+void test_sid_ble_srv_notify_attr_get(void)
+{
+	struct bt_gatt_attr attrs[3];
+	struct bt_gatt_service_static srv = { .attrs = attrs, .attr_count = ARRAY_SIZE(attrs) };
+
+	bt_gatt_find_by_uuid_fake.return_val = &attrs[1];
+	TEST_ASSERT_EQUAL_PTR(&attrs[1],
+			      sid_ble_srv_notify_attr_get(&srv, AMA_SID_BT_CHARACTERISTIC_NOTIFY));
+	TEST_ASSERT_EQUAL(1, bt_gatt_find_by_uuid_fake.call_count);
+	TEST_ASSERT_EQUAL_PTR(attrs, bt_gatt_find_by_uuid_fake.arg0_val);
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(attrs), bt_gatt_find_by_uuid_fake.arg1_val);
+
+	bt_gatt_find_by_uuid_fake.return_val = NULL;
+	TEST_ASSERT_NULL(sid_ble_srv_notify_attr_get(&srv, AMA_SID_BT_CHARACTERISTIC_NOTIFY));
+	TEST_ASSERT_NULL(sid_ble_srv_notify_attr_get(NULL, AMA_SID_BT_CHARACTERISTIC_NOTIFY));
+	TEST_ASSERT_NULL(sid_ble_srv_notify_attr_get(&srv, NULL));
+	TEST_ASSERT_EQUAL(2, bt_gatt_find_by_uuid_fake.call_count);
+}
+
 void test_sid_ble_send_data_pass(void)
 {
 	struct bt_gatt_notify_params *notify_params;
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
@@ -76,117 +100,168 @@ void test_sid_ble_send_data_pass(void)
 
 	__cmock_sid_ble_adapter_notification_sent_Expect();
 
-	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
-
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
-	bt_gatt_get_mtu_fake.return_val = sizeof(data);
-	bt_gatt_is_subscribed_fake.return_val = true;
+	srv_params_set(&params, &conn, &attr, sizeof(data), true);
 	bt_gatt_notify_cb_fake.return_val = 0;
 	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
 
+	/* The send path does not look up the attribute table */
+	TEST_ASSERT_EQUAL(0, bt_gatt_find_by_uuid_fake.call_count);
 	TEST_ASSERT_NOT_NULL(bt_gatt_notify_cb_fake.arg1_val);
 	if (NULL != bt_gatt_notify_cb_fake.arg1_val) {
 		notify_params = (struct bt_gatt_notify_params *)bt_gatt_notify_cb_fake.arg1_val;
-		notify_params->func(&conn, NULL);
+		TEST_ASSERT_EQUAL_PTR(&attr, notify_params->attr);
+		notify_params->func(&conn, notify_params->user_data);
 	}
 }
 
-void test_sid_ble_send_data_attr_fail(void)
+void test_sid_ble_send_data_queue_depth(void)
 {
-	struct bt_gatt_service_static srv;
+	struct bt_gatt_notify_params *in_flight[CONFIG_SIDEWALK_BLE_TX_QUEUE_DEPTH];
+	struct sid_ble_send_stats stats;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
+	struct bt_gatt_attr attr;
 	uint8_t data[TEST_DATA_CHUNK];
 
-	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
+	srv_params_set(&params, &conn, &attr, sizeof(data), true);
+	bt_gatt_notify_cb_fake.return_val = 0;
+	sid_ble_send_stats_reset();
+
+	for (size_t i = 0; i < ARRAY_SIZE(in_flight); i++) {
+		TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+		in_flight[i] = bt_gatt_notify_cb_fake.arg1_val;
+		for (size_t j = 0; j < i; j++) {
+			TEST_ASSERT_NOT_EQUAL(in_flight[j], in_flight[i]);
+		}
+	}
+	TEST_ASSERT_EQUAL(-ENOMEM, sid_ble_send_data(&params, data, sizeof(data)));
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(in_flight), bt_gatt_notify_cb_fake.call_count);
+
+	/* A completed slot is reused */
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	in_flight[0]->func(&conn, in_flight[0]->user_data);
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	in_flight[0] = bt_gatt_notify_cb_fake.arg1_val;
 
-	bt_gatt_find_by_uuid_fake.return_val = NULL;
-	bt_gatt_get_mtu_fake.return_val = sizeof(data);
-	bt_gatt_is_subscribed_fake.return_val = true;
+	for (size_t i = 0; i < ARRAY_SIZE(in_flight); i++) {
+		__cmock_sid_ble_adapter_notification_sent_Expect();
+		in_flight[i]->func(&conn, in_flight[i]->user_data);
+	}
+
+	sid_ble_send_stats_get(&stats);
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(in_flight) + 1, stats.queued);
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(in_flight) + 1, stats.sent);
+	TEST_ASSERT_EQUAL((ARRAY_SIZE(in_flight) + 1) * sizeof(data), stats.bytes);
+	TEST_ASSERT_EQUAL(1, stats.queue_full);
+	TEST_ASSERT_EQUAL(0, stats.in_flight);
+	TEST_ASSERT_EQUAL(ARRAY_SIZE(in_flight), stats.max_in_flight);
+	TEST_ASSERT_TRUE(stats.conn_events >= 1);
+}
+
+void test_sid_ble_send_data_reset_on_disconnect(void)
+{
+	struct bt_gatt_notify_params *lost;
+	struct sid_ble_send_stats stats;
+	struct bt_conn conn;
+	sid_ble_srv_params_t params;
+	struct bt_gatt_attr attr;
+	uint8_t data[TEST_DATA_CHUNK];
+
+	srv_params_set(&params, &conn, &attr, sizeof(data), true);
+	bt_gatt_notify_cb_fake.return_val = 0;
+	sid_ble_send_stats_reset();
+
+	for (size_t i = 0; i < CONFIG_SIDEWALK_BLE_TX_QUEUE_DEPTH; i++) {
+		TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	}
+	lost = bt_gatt_notify_cb_fake.arg1_val;
+	TEST_ASSERT_EQUAL(-ENOMEM, sid_ble_send_data(&params, data, sizeof(data)));
+
+	/* The link drops before the queued notifications are sent. */
+	sid_ble_send_reset();
+	sid_ble_send_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.in_flight);
+
+	TEST_ASSERT_EQUAL(0, sid_ble_send_data(&params, data, sizeof(data)));
+	sid_ble_send_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.in_flight);
+
+	/* A late completion of a lost notification is not counted. */
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	lost->func(&conn, lost->user_data);
+	sid_ble_send_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.sent);
+
+	__cmock_sid_ble_adapter_notification_sent_Expect();
+	bt_gatt_notify_cb_fake.arg1_val->func(&conn, bt_gatt_notify_cb_fake.arg1_val->user_data);
+	sid_ble_send_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.sent);
+	TEST_ASSERT_EQUAL(0, stats.in_flight);
+}
+
+void test_sid_ble_send_data_attr_fail(void)
+{
+	struct bt_conn conn;
+	sid_ble_srv_params_t params;
+	uint8_t data[TEST_DATA_CHUNK];
+
+	srv_params_set(&params, &conn, NULL, sizeof(data), true);
 	bt_gatt_notify_cb_fake.return_val = 0;
 	TEST_ASSERT_EQUAL(-ENOENT, sid_ble_send_data(&params, data, sizeof(data)));
+	TEST_ASSERT_EQUAL(0, bt_gatt_notify_cb_fake.call_count);
 }
 
 void test_sid_ble_send_data_wo_subscription(void)
 {
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
 	uint8_t data[TEST_DATA_CHUNK];
 
-	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
-
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
-	bt_gatt_get_mtu_fake.return_val = sizeof(data);
-	bt_gatt_is_subscribed_fake.return_val = false;
+	srv_params_set(&params, &conn, &attr, sizeof(data), false);
 	bt_gatt_notify_cb_fake.return_val = 0;
 	TEST_ASSERT_EQUAL(-EINVAL, sid_ble_send_data(&params, data, sizeof(data)));
 }
 
 void test_sid_ble_send_data_incorrect_data_len(void)
 {
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
 	uint8_t data[TEST_DATA_CHUNK];
 
-	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
-
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
-	bt_gatt_get_mtu_fake.return_val = sizeof(data) - 5;
-	bt_gatt_is_subscribed_fake.return_val = false;
+	srv_params_set(&params, &conn, &attr, sizeof(data) - 5, true);
 	bt_gatt_notify_cb_fake.return_val = 0;
 	TEST_ASSERT_EQUAL(-EINVAL, sid_ble_send_data(&params, data, sizeof(data)));
 
-	bt_gatt_get_mtu_fake.return_val = sizeof(data) - 1;
+	params.mtu = sizeof(data) - 1;
 	TEST_ASSERT_EQUAL(-EINVAL, sid_ble_send_data(&params, data, sizeof(data)));
 }
 
 void test_sid_ble_send_data_fail(void)
 {
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
 	int test_error_code = -ENOENT;
 	uint8_t data[TEST_DATA_CHUNK];
 
-	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
-
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
-	bt_gatt_get_mtu_fake.return_val = sizeof(data);
-	bt_gatt_is_subscribed_fake.return_val = true;
+	srv_params_set(&params, &conn, &attr, sizeof(data), true);
 	bt_gatt_notify_cb_fake.return_val = test_error_code;
-	TEST_ASSERT_EQUAL(test_error_code, sid_ble_send_data(&params, data, sizeof(data)));
+	for (size_t i = 0; i <= CONFIG_SIDEWALK_BLE_TX_QUEUE_DEPTH; i++) {
+		/* Slot of a failed notification is released */
+		TEST_ASSERT_EQUAL(test_error_code, sid_ble_send_data(&params, data, sizeof(data)));
+	}
 }
 
 void test_sid_ble_send_data_incorrect_arguments(void)
 {
-	struct bt_gatt_service_static srv;
 	struct bt_conn conn;
 	sid_ble_srv_params_t params;
 	struct bt_gatt_attr attr;
 	uint8_t data[TEST_DATA_CHUNK];
 
-	params.conn = &conn;
-	params.service = &srv;
-	params.uuid = AMA_SID_BT_CHARACTERISTIC_NOTIFY;
-
-	bt_gatt_find_by_uuid_fake.return_val = &attr;
-	bt_gatt_get_mtu_fake.return_val = sizeof(data);
-	bt_gatt_is_subscribed_fake.return_val = false;
+	srv_params_set(&params, &conn, &attr, sizeof(data), true);
 	bt_gatt_notify_cb_fake.return_val = 0;
 	TEST_ASSERT_EQUAL(-EINVAL, sid_ble_send_data(&params, NULL, 0));
 	TEST_ASSERT_EQUAL(-EINVAL, sid_ble_send_data(&params, data, 0));
@@ -16,6 +16,7 @@ FAKE_VOID_FUNC(sidewalk_start, sidewalk_ctx_t *);
 FAKE_VALUE_FUNC(void *, sid_hal_malloc, size_t);
 FAKE_VOID_FUNC(sid_hal_free, void *);
 FAKE_VALUE_FUNC(int, sidewalk_event_send, event_handler_t, void *, ctx_free);
+FAKE_VOID_FUNC(sidewalk_event_stats_get, sidewalk_event_stats_t *);
 
 FAKE_VOID_FUNC(sidewalk_event_process, sidewalk_ctx_t *, void *);
 FAKE_VOID_FUNC(sidewalk_event_autostart, sidewalk_ctx_t *, void *);
@@ -46,6 +47,7 @@ FAKE_VOID_FUNC(sbdt_event_deinit, sidewalk_ctx_t *, void *);
 	FAKE(sid_hal_malloc)                                                                       \
 	FAKE(sid_hal_free)                                                                         \
 	FAKE(sidewalk_event_send)                                                                  \
+	FAKE(sidewalk_event_stats_get)                                                             \
 	FAKE(sidewalk_event_process)                                                               \
 	FAKE(sidewalk_event_autostart)                                                             \
 	FAKE(sidewalk_event_factory_reset)                                                         \
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <errno.h>
+#include <sidewalk.h>
+#include <zephyr/kernel.h>
+
+#define QUEUE_SIZE (CONFIG_SIDEWALK_THREAD_QUEUE_SIZE)
+
+#define PRODUCERS (3)
+#define EVENTS_PER_PRODUCER (500)
+#define PRODUCER_STACK_SIZE (1024)
+/* Below the Sidewalk thread, so events are consumed while producers post */
+#define PRODUCER_PRIORITY (CONFIG_SIDEWALK_THREAD_PRIORITY + 2)
+#define HANDLED_TIMEOUT K_SECONDS(5)
+
+#define EVENT_PROCESS_MARK (UINT32_MAX)
+#define EVENT_ID(producer, seq) (((uint32_t)(producer) << 16) | (seq))
+
+static sidewalk_ctx_t sid_ctx;
+
+static uint32_t received[PRODUCERS * EVENTS_PER_PRODUCER];
+static size_t received_count;
+static K_SEM_DEFINE(event_handled, 0, K_SEM_MAX_LIMIT);
+static size_t freed_count;
+static K_SEM_DEFINE(consumer_release, 0, 1);
+/* Handlers run in the Sidewalk thread, checked by the tests afterwards */
+static bool handler_ctx_wrong;
+
+static struct k_thread producer_threads[PRODUCERS];
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, PRODUCERS, PRODUCER_STACK_SIZE);
+static atomic_t producer_retries;
+
+static void received_add(sidewalk_ctx_t *sid, uint32_t id)
+{
+	handler_ctx_wrong |= sid != &sid_ctx;
+	if (received_count < ARRAY_SIZE(received)) {
+		received[received_count++] = id;
+	}
+	k_sem_give(&event_handled);
+}
+
+static void record_event(sidewalk_ctx_t *sid, void *ctx)
+{
+	received_add(sid, (uint32_t)(uintptr_t)ctx);
+}
+
+static void block_event(sidewalk_ctx_t *sid, void *ctx)
+{
+	k_sem_take(&consumer_release, HANDLED_TIMEOUT);
+	record_event(sid, ctx);
+}
+
+static void record_free(void *ctx)
+{
+	ARG_UNUSED(ctx);
+	freed_count++;
+}
+
+/*
+ * Event handlers of the sample, only sidewalk_event_process is special for the queue.
+ */
+void sidewalk_event_process(sidewalk_ctx_t *sid, void *ctx)
+{
+	ARG_UNUSED(ctx);
+	received_add(sid, EVENT_PROCESS_MARK);
+}
+
+void sidewalk_event_autostart(sidewalk_ctx_t *sid, void *ctx)
+{
+}
+
+void sidewalk_event_factory_reset(sidewalk_ctx_t *sid, void *ctx)
+{
+}
+
+void sidewalk_event_new_status(sidewalk_ctx_t *sid, void *ctx)
+{
+}
+
+void sidewalk_event_send_msg(sidewalk_ctx_t *sid, void *ctx)
+{
+}
+
+void sidewalk_event_connect(sidewalk_ctx_t *sid, void *ctx)
+{
+}
+
+void sidewalk_event_link_switch(sidewalk_ctx_t *sid, void *ctx)
+{
+}
+
+void sidewalk_event_exit(sidewalk_ctx_t *sid, void *ctx)
+{
+}
+
+void sidewalk_event_reboot(sidewalk_ctx_t *sid, void *ctx)
+{
+}
+
+void sidewalk_event_platform_init(sidewalk_ctx_t *sid, void *ctx)
+{
+}
+
+static void wait_handled(size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		TEST_ASSERT_EQUAL(0, k_sem_take(&event_handled, HANDLED_TIMEOUT));
+	}
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t producer = (uint32_t)(uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = 0; seq < EVENTS_PER_PRODUCER; seq++) {
+		while (sidewalk_event_send(record_event, (void *)(uintptr_t)EVENT_ID(producer, seq),
+					   NULL)) {
+			atomic_inc(&producer_retries);
+			k_yield();
+		}
+	}
+}
+
+/*
+ * The tests run in order and share the event queue, the Sidewalk thread is started
+ * by test_sid_event_order, so the earlier tests see the queue without a consumer.
+ */
+void test_sid_event_process_coalesced(void)
+{
+	sidewalk_event_stats_t stats;
+
+	for (int i = 0; i < 3; i++) {
+		TEST_ASSERT_EQUAL(0, sidewalk_event_send(sidewalk_event_process, NULL, NULL));
+	}
+	sidewalk_event_stats_get(&stats);
+	TEST_ASSERT_EQUAL(2, stats.coalesced);
+	TEST_ASSERT_EQUAL(1, stats.high_watermark);
+
+	/* With a context the post is an ordinary event. */
+	TEST_ASSERT_EQUAL(0, sidewalk_event_send(sidewalk_event_process, &sid_ctx, NULL));
+	sidewalk_event_stats_get(&stats);
+	TEST_ASSERT_EQUAL(2, stats.coalesced);
+	TEST_ASSERT_EQUAL(2, stats.high_watermark);
+	TEST_ASSERT_EQUAL(0, stats.dropped);
+}
+
+void test_sid_event_full_queue_drops_new_event(void)
+{
+	sidewalk_event_stats_t stats;
+
+	for (uint32_t i = 0; i < QUEUE_SIZE - 2; i++) {
+		TEST_ASSERT_EQUAL(0, sidewalk_event_send(record_event, (void *)(uintptr_t)i, NULL));
+	}
+	TEST_ASSERT_EQUAL(-ENOMSG, sidewalk_event_send(record_event, (void *)UINT16_MAX, NULL));
+
+	/* A pending sidewalk_event_process still absorbs new posts. */
+	TEST_ASSERT_EQUAL(0, sidewalk_event_send(sidewalk_event_process, NULL, NULL));
+
+	sidewalk_event_stats_get(&stats);
+	TEST_ASSERT_EQUAL(QUEUE_SIZE, stats.high_watermark);
+	TEST_ASSERT_EQUAL(1, stats.dropped);
+	TEST_ASSERT_EQUAL(3, stats.coalesced);
+}
+
+void test_sid_event_order(void)
+{
+	sidewalk_event_stats_t stats;
+
+	sidewalk_start(&sid_ctx);
+	wait_handled(QUEUE_SIZE);
+
+	TEST_ASSERT_EQUAL(QUEUE_SIZE, received_count);
+	TEST_ASSERT_FALSE(handler_ctx_wrong);
+	TEST_ASSERT_EQUAL_HEX32(EVENT_PROCESS_MARK, received[0]);
+	TEST_ASSERT_EQUAL_HEX32(EVENT_PROCESS_MARK, received[1]);
+	for (uint32_t i = 0; i < QUEUE_SIZE - 2; i++) {
+		TEST_ASSERT_EQUAL(i, received[i + 2]);
+	}
+
+	/* The handled sidewalk_event_process is not pending any more. */
+	TEST_ASSERT_EQUAL(0, sidewalk_event_send(sidewalk_event_process, NULL, NULL));
+	wait_handled(1);
+	TEST_ASSERT_EQUAL_HEX32(EVENT_PROCESS_MARK, received[QUEUE_SIZE]);
+	sidewalk_event_stats_get(&stats);
+	TEST_ASSERT_EQUAL(3, stats.coalesced);
+	TEST_ASSERT_EQUAL(1, stats.dropped);
+}
+
+void test_sid_event_ctx_freed_after_handler(void)
+{
+	received_count = 0;
+	freed_count = 0;
+
+	TEST_ASSERT_EQUAL(0, sidewalk_event_send(record_event, (void *)7, record_free));
+	wait_handled(1);
+	/* The context is freed right after the handler, let the Sidewalk thread finish. */
+	k_sleep(K_MSEC(1));
+
+	TEST_ASSERT_EQUAL(7, received[0]);
+	TEST_ASSERT_EQUAL(1, freed_count);
+}
+
+void test_sid_event_process_waits_for_free_slot(void)
+{
+	sidewalk_event_stats_t before, after;
+
+	received_count = 0;
+	sidewalk_event_stats_get(&before);
+
+	/* The Sidewalk thread is held in a handler while the queue fills up. */
+	TEST_ASSERT_EQUAL(0, sidewalk_event_send(block_event, NULL, NULL));
+	k_sleep(K_MSEC(1));
+	for (uint32_t i = 1; i <= QUEUE_SIZE; i++) {
+		TEST_ASSERT_EQUAL(0, sidewalk_event_send(record_event, (void *)(uintptr_t)i, NULL));
+	}
+	TEST_ASSERT_EQUAL(-ENOMSG, sidewalk_event_send(record_event, (void *)UINT16_MAX, NULL));
+
+	/* Not dropped, and the post coalesced into it is not lost either. */
+	TEST_ASSERT_EQUAL(0, sidewalk_event_send(sidewalk_event_process, NULL, NULL));
+	TEST_ASSERT_EQUAL(0, sidewalk_event_send(sidewalk_event_process, NULL, NULL));
+
+	k_sem_give(&consumer_release);
+	wait_handled(QUEUE_SIZE + 2);
+	k_sleep(K_MSEC(1));
+
+	TEST_ASSERT_EQUAL(QUEUE_SIZE + 2, received_count);
+	TEST_ASSERT_EQUAL(0, received[0]);
+	for (uint32_t i = 1; i <= QUEUE_SIZE; i++) {
+		TEST_ASSERT_EQUAL(i, received[i]);
+	}
+	TEST_ASSERT_EQUAL_HEX32(EVENT_PROCESS_MARK, received[QUEUE_SIZE + 1]);
+
+	sidewalk_event_stats_get(&after);
+	TEST_ASSERT_EQUAL(before.dropped + 1, after.dropped);
+	TEST_ASSERT_EQUAL(before.coalesced + 1, after.coalesced);
+}
+
+void test_sid_event_multiple_producers(void)
+{
+	uint32_t next_seq[PRODUCERS] = {};
+	sidewalk_event_stats_t before, after;
+
+	received_count = 0;
+	atomic_clear(&producer_retries);
+	sidewalk_event_stats_get(&before);
+
+	for (uint32_t i = 0; i < PRODUCERS; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				K_THREAD_STACK_SIZEOF(producer_stacks[i]), producer_entry,
+				(void *)(uintptr_t)i, NULL, NULL, PRODUCER_PRIORITY, 0, K_NO_WAIT);
+	}
+	for (uint32_t i = 0; i < PRODUCERS; i++) {
+		TEST_ASSERT_EQUAL(0, k_thread_join(&producer_threads[i], HANDLED_TIMEOUT));
+	}
+	wait_handled(PRODUCERS * EVENTS_PER_PRODUCER);
+
+	/* Every producer's events arrive once and in the order they were posted. */
+	TEST_ASSERT_EQUAL(PRODUCERS * EVENTS_PER_PRODUCER, received_count);
+	for (size_t i = 0; i < received_count; i++) {
+		uint32_t producer = received[i] >> 16;
+
+		TEST_ASSERT_LESS_THAN(PRODUCERS, producer);
+		TEST_ASSERT_EQUAL(next_seq[producer], received[i] & UINT16_MAX);
+		next_seq[producer]++;
+	}
+
+	sidewalk_event_stats_get(&after);
+	TEST_ASSERT_EQUAL(before.dropped + atomic_get(&producer_retries), after.dropped);
+	TEST_ASSERT_EQUAL(before.coalesced, after.coalesced);
+	TEST_ASSERT_LESS_OR_EQUAL(QUEUE_SIZE, after.high_watermark);
+}
+
+/* It is required to be added to each test. That is because unity is using
+ * different main signature (returns int) and zephyr expects main which does
+ * not return value.
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	return unity_main();
+}
@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ * 
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <errno.h>
+#include <tlv/tlv.h>
+#include <tlv/tlv_storage_impl.h>
+
+#define INDEX_STORAGE_SIZE 512
+#define INDEX_MAGIC_SIZE 8
+#define TYPES_IN_INDEX (CONFIG_SIDEWALK_TLV_INDEX_SIZE / 2)
+#define TYPES_OVER_INDEX (CONFIG_SIDEWALK_TLV_INDEX_SIZE + 8)
+
+static uint8_t index_storage[INDEX_STORAGE_SIZE];
+static uint32_t read_calls;
+static tlv_index test_index;
+
+static int counting_ram_read(void *ctx, uint32_t offset, uint8_t *data, uint32_t data_size)
+{
+	read_calls++;
+	return tlv_storage_ram_read(ctx, offset, data, data_size);
+}
+
+static tlv_ctx index_tlv_ctx(tlv_index *index)
+{
+	return (tlv_ctx){ .start_offset = 0,
+			  .end_offset = sizeof(index_storage),
+			  .tlv_storage_start_marker_size = INDEX_MAGIC_SIZE,
+			  .index = index,
+			  .storage_impl = { .ctx = index_storage,
+					    .read = counting_ram_read,
+					    .erase = tlv_storage_ram_erase,
+					    .write = tlv_storage_ram_write } };
+}
+
+static tlv_type test_type(uint16_t n)
+{
+	return 0x100 + n;
+}
+
+static void fill_storage(uint16_t types)
+{
+	tlv_ctx tlv = index_tlv_ctx(NULL);
+	for (uint16_t i = 0; i < types; i++) {
+		uint8_t payload[8];
+		memset(payload, i, sizeof(payload));
+		zassert_equal(0, tlv_write(&tlv, test_type(i), payload, (i % sizeof(payload)) + 1));
+	}
+}
+
+/* Same access pattern as sid_pal_mfg_store: get length, then read value for every tag */
+static uint32_t read_all_types(tlv_ctx *tlv, uint16_t types)
+{
+	read_calls = 0;
+	for (uint16_t i = 0; i < types; i++) {
+		tlv_header header = {};
+		uint8_t payload[8] = { 0 };
+		uint8_t expected[8];
+
+		zassert_equal(0, tlv_lookup(tlv, test_type(i), &header));
+		zassert_equal((i % sizeof(payload)) + 1, header.payload_size.data_size);
+		zassert_equal(0, tlv_read(tlv, test_type(i), payload,
+					  header.payload_size.data_size));
+		memset(expected, i, sizeof(expected));
+		zassert_mem_equal(payload, expected, header.payload_size.data_size);
+	}
+	return read_calls;
+}
+
+static void index_setup(void *f)
+{
+	memset(index_storage, PADDING_BYTE, sizeof(index_storage));
+	memset(&test_index, 0x0, sizeof(test_index));
+	read_calls = 0;
+}
+
+ZTEST_SUITE(tlv_index, NULL, NULL, index_setup, NULL, NULL);
+
+ZTEST(tlv_index, test_tlv_index_build_invalid_ctx)
+{
+	tlv_ctx tlv = index_tlv_ctx(NULL);
+	zassert_equal(-EINVAL, tlv_index_build(NULL));
+	zassert_equal(-EINVAL, tlv_index_build(&tlv));
+}
+
+ZTEST(tlv_index, test_tlv_index_read_calls)
+{
+	fill_storage(TYPES_IN_INDEX);
+
+	tlv_ctx scan_tlv = index_tlv_ctx(NULL);
+	uint32_t scan_reads = read_all_types(&scan_tlv, TYPES_IN_INDEX);
+
+	tlv_ctx index_tlv = index_tlv_ctx(&test_index);
+	read_calls = 0;
+	zassert_equal(0, tlv_index_build(&index_tlv));
+	uint32_t build_reads = read_calls;
+	zassert_true(test_index.valid);
+	zassert_true(test_index.complete);
+	uint32_t index_reads = read_all_types(&index_tlv, TYPES_IN_INDEX);
+
+	TC_PRINT("%d types: scan %u reads, index %u reads (build %u)\n", TYPES_IN_INDEX,
+		 scan_reads, build_reads + index_reads, build_reads);
+	/* only payload reads are left */
+	zassert_equal(TYPES_IN_INDEX, index_reads);
+	zassert_true(build_reads + index_reads < scan_reads);
+}
+
+ZTEST(tlv_index, test_tlv_index_missing_type_no_reads)
+{
+	fill_storage(TYPES_IN_INDEX);
+	tlv_ctx tlv = index_tlv_ctx(&test_index);
+	zassert_equal(0, tlv_index_build(&tlv));
+
+	read_calls = 0;
+	zassert_equal(-ENODATA, tlv_lookup(&tlv, test_type(TYPES_IN_INDEX), NULL));
+	uint8_t data[4];
+	zassert_equal(-ENODATA, tlv_read(&tlv, test_type(TYPES_IN_INDEX), data, sizeof(data)));
+	zassert_equal(0, read_calls);
+}
+
+ZTEST(tlv_index, test_tlv_index_read_too_big)
+{
+	fill_storage(TYPES_IN_INDEX);
+	tlv_ctx tlv = index_tlv_ctx(&test_index);
+	zassert_equal(0, tlv_index_build(&tlv));
+
+	uint8_t data[16];
+	zassert_equal(-ENOMEM, tlv_read(&tlv, test_type(0), data, sizeof(data)));
+}
+
+ZTEST(tlv_index, test_tlv_index_overflow_falls_back_to_scan)
+{
+	fill_storage(TYPES_OVER_INDEX);
+	tlv_ctx tlv = index_tlv_ctx(&test_index);
+	zassert_equal(0, tlv_index_build(&tlv));
+	zassert_true(test_index.valid);
+	zassert_false(test_index.complete);
+	zassert_equal(CONFIG_SIDEWALK_TLV_INDEX_SIZE, test_index.count);
+
+	read_all_types(&tlv, TYPES_OVER_INDEX);
+	zassert_equal(-ENODATA, tlv_lookup(&tlv, test_type(TYPES_OVER_INDEX), NULL));
+}
+
+ZTEST(tlv_index, test_tlv_index_write_invalidates)
+{
+	fill_storage(TYPES_IN_INDEX);
+	tlv_ctx tlv = index_tlv_ctx(&test_index);
+	zassert_equal(0, tlv_index_build(&tlv));
+
+	uint8_t payload[4] = { 0xa, 0xb, 0xc, 0xd };
+	zassert_equal(0, tlv_write(&tlv, 0x42, payload, sizeof(payload)));
+	zassert_false(test_index.valid);
+
+	uint8_t data[4] = { 0 };
+	zassert_equal(0, tlv_read(&tlv, 0x42, data, sizeof(data)));
+	zassert_mem_equal(data, payload, sizeof(payload));
+
+	zassert_equal(0, tlv_index_build(&tlv));
+	read_calls = 0;
+	zassert_equal(0, tlv_lookup(&tlv, 0x42, NULL));
+	zassert_equal(0, read_calls);
+}
+
+ZTEST(tlv_index, test_tlv_index_invalidate_after_erase)
+{
+	fill_storage(TYPES_IN_INDEX);
+	tlv_ctx tlv = index_tlv_ctx(&test_index);
+	zassert_equal(0, tlv_index_build(&tlv));
+
+	zassert_equal(0, tlv.storage_impl.erase(tlv.storage_impl.ctx, 0, sizeof(index_storage)));
+	tlv_index_invalidate(&tlv);
+	zassert_false(test_index.valid);
+	zassert_equal(-ENODATA, tlv_lookup(&tlv, test_type(0), NULL));
+}
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 #include <sid_pal_critical_region_ifc.h>
+#include <sid_critical_section.h>
 #include <sid_error.h>
 #include <zephyr/ztest.h>
 #include <zephyr/irq.h>
@@ -66,4 +67,22 @@ ZTEST(sid_pal_suite, test_critical_region_with_timer)
 	zassert_equal(resource, CHANGED, "IRQ should change resource after critical section");
 }
 
+ZTEST(sid_pal_suite, test_critical_section_with_irq)
+{
+	static SID_CRITICAL_SECTION_DEFINE(section, "test");
+	sid_critical_section_key_t key;
+
+	IRQ_CONNECT(TEST_IRQ, TEST_IRQ_PRIO, irq_cb, NULL, TEST_IRQ_FLAGS);
+	soc_irq_enable(TEST_IRQ);
+
+	key = sid_critical_section_enter(&section);
+	resource = UNCHANGED;
+	soc_irq_trigger(TEST_IRQ);
+	zassert_equal(resource, UNCHANGED, "Resource should not change in critical section");
+	sid_critical_section_exit(&section, key);
+
+	soc_irq_trigger(TEST_IRQ);
+	zassert_equal(resource, CHANGED, "IRQ should change resource after critical section");
+}
+
 ZTEST_SUITE(sid_pal_suite, NULL, NULL, NULL, NULL, NULL);
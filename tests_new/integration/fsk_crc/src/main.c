@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <string.h>
+#include <semtech_fsk_crc.h>
+
+#define FSK_MAX_PAYLOAD_LENGTH 255
+#define BENCHMARK_ITERATIONS 100
+
+struct crc_kernel {
+	const char *name;
+	uint16_t (*crc16)(const uint8_t *buffer, uint16_t length);
+	uint32_t (*crc32)(const uint8_t *buffer, uint16_t length);
+};
+
+static const struct crc_kernel kernels[] = {
+	{ "bitwise", semtech_fsk_crc16_bitwise, semtech_fsk_crc32_bitwise },
+	{ "nibble", semtech_fsk_crc16_nibble, semtech_fsk_crc32_nibble },
+	{ "byte", semtech_fsk_crc16_byte, semtech_fsk_crc32_byte },
+	{ "slice-by-4", semtech_fsk_crc16_slice_by_4, semtech_fsk_crc32_slice_by_4 },
+	{ "selected", compute_crc16, compute_crc32 },
+};
+
+static uint8_t payload[FSK_MAX_PAYLOAD_LENGTH];
+
+/* Implementation from the Semtech HALO driver, kept as the reference */
+static uint16_t reference_crc16(const uint8_t *buffer, uint16_t length)
+{
+	if (!buffer || !length) {
+		return 0;
+	}
+
+	uint16_t crc16 = 0x0000;
+
+	for (uint16_t index_buffer = 0; index_buffer < length; index_buffer++) {
+		crc16 ^= ((uint16_t)buffer[index_buffer] << 8);
+
+		for (uint8_t i = 0; i < 8; i++) {
+			crc16 = (crc16 & 0x8000) ? (crc16 << 1) ^ 0x1021 : (crc16 << 1);
+		}
+	}
+
+	return crc16;
+}
+
+static uint32_t reference_crc32(const uint8_t *buffer, uint16_t length)
+{
+	if (!buffer || !length) {
+		return 0;
+	}
+
+	uint8_t temp_buffer[sizeof(uint32_t)] = { 0 };
+	uint32_t crc32 = 0xFFFFFFFF;
+	const uint8_t *buffer_local;
+	uint16_t length_local;
+
+	if (length < sizeof(uint32_t)) {
+		memcpy(temp_buffer, buffer, length);
+		length_local = sizeof(uint32_t);
+		buffer_local = temp_buffer;
+	} else {
+		length_local = length;
+		buffer_local = buffer;
+	}
+
+	for (uint16_t index_buffer = 0; index_buffer < length_local; index_buffer++) {
+		crc32 ^= (index_buffer < length) ? ((uint32_t)buffer_local[index_buffer] << 24) :
+						   0x00000000;
+
+		for (uint8_t i = 0; i < 8; i++) {
+			crc32 = (crc32 & 0x80000000) ? (crc32 << 1) ^ 0x04C11DB7 : (crc32 << 1);
+		}
+	}
+
+	return ~crc32;
+}
+
+static void *fsk_crc_setup(void)
+{
+	uint32_t seed = 0x12345678;
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		seed = seed * 1103515245 + 12345;
+		payload[i] = seed >> 16;
+	}
+	return NULL;
+}
+
+ZTEST(fsk_crc, test_reference_check_values)
+{
+	const uint8_t check[] = "123456789";
+
+	/* CRC-16/XMODEM and CRC-32/BZIP2 check values */
+	zassert_equal(0x31C3, reference_crc16(check, sizeof(check) - 1));
+	zassert_equal(0xFC891918, reference_crc32(check, sizeof(check) - 1));
+}
+
+ZTEST(fsk_crc, test_invalid_input)
+{
+	for (size_t k = 0; k < ARRAY_SIZE(kernels); k++) {
+		zassert_equal(0, kernels[k].crc16(NULL, 10), "%s", kernels[k].name);
+		zassert_equal(0, kernels[k].crc16(payload, 0), "%s", kernels[k].name);
+		zassert_equal(0, kernels[k].crc32(NULL, 10), "%s", kernels[k].name);
+		zassert_equal(0, kernels[k].crc32(payload, 0), "%s", kernels[k].name);
+	}
+}
+
+ZTEST(fsk_crc, test_equal_to_reference_all_lengths)
+{
+	for (uint16_t length = 1; length <= sizeof(payload); length++) {
+		uint16_t crc16 = reference_crc16(payload, length);
+		uint32_t crc32 = reference_crc32(payload, length);
+
+		for (size_t k = 0; k < ARRAY_SIZE(kernels); k++) {
+			zassert_equal(crc16, kernels[k].crc16(payload, length), "%s length %d",
+				      kernels[k].name, length);
+			zassert_equal(crc32, kernels[k].crc32(payload, length), "%s length %d",
+				      kernels[k].name, length);
+		}
+	}
+}
+
+ZTEST(fsk_crc, test_equal_to_reference_unaligned)
+{
+	for (uint16_t offset = 1; offset < sizeof(uint32_t); offset++) {
+		uint16_t length = sizeof(payload) - offset;
+		for (size_t k = 0; k < ARRAY_SIZE(kernels); k++) {
+			zassert_equal(reference_crc16(payload + offset, length),
+				      kernels[k].crc16(payload + offset, length), "%s",
+				      kernels[k].name);
+			zassert_equal(reference_crc32(payload + offset, length),
+				      kernels[k].crc32(payload + offset, length), "%s",
+				      kernels[k].name);
+		}
+	}
+}
+
+ZTEST(fsk_crc, test_equal_to_reference_constant_payloads)
+{
+	const uint8_t patterns[] = { 0x00, 0xFF, 0x55, 0xAA };
+	uint8_t buffer[FSK_MAX_PAYLOAD_LENGTH];
+
+	for (size_t p = 0; p < ARRAY_SIZE(patterns); p++) {
+		memset(buffer, patterns[p], sizeof(buffer));
+		for (uint16_t length = 1; length <= 8; length++) {
+			for (size_t k = 0; k < ARRAY_SIZE(kernels); k++) {
+				zassert_equal(reference_crc16(buffer, length),
+					      kernels[k].crc16(buffer, length));
+				zassert_equal(reference_crc32(buffer, length),
+					      kernels[k].crc32(buffer, length));
+			}
+		}
+	}
+}
+
+ZTEST(fsk_crc, test_update_in_parts)
+{
+	const uint16_t part_sizes[] = { 1, 3, 4, 16, 100 };
+
+	for (uint16_t length = 1; length <= sizeof(payload); length++) {
+		for (size_t s = 0; s < ARRAY_SIZE(part_sizes); s++) {
+			uint16_t crc16 = SEMTECH_FSK_CRC16_INIT;
+			uint32_t crc32 = SEMTECH_FSK_CRC32_INIT;
+
+			for (uint16_t offset = 0; offset < length; offset += part_sizes[s]) {
+				uint16_t part = MIN(part_sizes[s], length - offset);
+				crc16 = semtech_fsk_crc16_update(crc16, payload + offset, part);
+				crc32 = semtech_fsk_crc32_update(crc32, payload + offset, part);
+			}
+			zassert_equal(reference_crc16(payload, length), crc16, "length %d", length);
+			zassert_equal(reference_crc32(payload, length),
+				      semtech_fsk_crc32_final(crc32, length), "length %d", length);
+		}
+	}
+	zassert_equal(0, semtech_fsk_crc32_final(SEMTECH_FSK_CRC32_INIT, 0));
+}
+
+static uint64_t benchmark_cycles(const struct crc_kernel *kernel, bool crc32, uint16_t length)
+{
+	volatile uint32_t sink = 0;
+	timing_t start = timing_counter_get();
+	for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		sink += crc32 ? kernel->crc32(payload, length) : kernel->crc16(payload, length);
+	}
+	timing_t end = timing_counter_get();
+	(void)sink;
+	return timing_cycles_get(&start, &end) / BENCHMARK_ITERATIONS;
+}
+
+ZTEST(fsk_crc, test_benchmark)
+{
+	const uint16_t lengths[] = { 16, 64, FSK_MAX_PAYLOAD_LENGTH };
+
+	timing_init();
+	timing_start();
+	for (size_t k = 0; k < ARRAY_SIZE(kernels); k++) {
+		for (size_t l = 0; l < ARRAY_SIZE(lengths); l++) {
+			uint64_t cycles16 = benchmark_cycles(&kernels[k], false, lengths[l]);
+			uint64_t cycles32 = benchmark_cycles(&kernels[k], true, lengths[l]);
+			TC_PRINT("%-10s %3d bytes: crc16 %6llu cycles (%6llu ns), crc32 %6llu cycles "
+				 "(%6llu ns)\n",
+				 kernels[k].name, lengths[l], cycles16,
+				 timing_cycles_to_ns(cycles16), cycles32,
+				 timing_cycles_to_ns(cycles32));
+		}
+	}
+	timing_stop();
+}
+
+ZTEST_SUITE(fsk_crc, NULL, fsk_crc_setup, NULL, NULL, NULL);
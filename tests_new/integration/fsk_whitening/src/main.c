@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <string.h>
+#include <semtech_fsk_crc.h>
+#include <semtech_fsk_whitening.h>
+
+#define FSK_MAX_PAYLOAD_LENGTH 255
+#define FSK_WHITENING_SEED 0x01FF
+#define BENCHMARK_ITERATIONS 100
+
+static uint8_t payload[FSK_MAX_PAYLOAD_LENGTH];
+
+/* Implementation from the Semtech HALO driver, kept as the reference */
+static void reference_whitening(uint16_t seed, const uint8_t *buffer_in, uint8_t *buffer_out,
+				uint16_t length)
+{
+	uint16_t lfsr = seed;
+	uint16_t xor_out = 0;
+	uint8_t ret = 0;
+	uint8_t result = 0;
+
+	for (uint16_t index = 0; index < length; index++) {
+		xor_out = 0;
+		ret = 0;
+		result = 0;
+
+		xor_out = ((lfsr >> 5) & 0x0F) ^ (lfsr & 0x0F);
+		lfsr = (lfsr >> 4) | (xor_out << 5);
+		ret |= (lfsr >> 5) & 0x0F;
+
+		xor_out = ((lfsr >> 5) & 0x0F) ^ (lfsr & 0x0F);
+		lfsr = (lfsr >> 4) | (xor_out << 5);
+		ret |= ((lfsr >> 1) & 0xf0);
+
+		result |= (ret & 0x80) >> 7;
+		result |= (ret & 0x40) >> 5;
+		result |= (ret & 0x20) >> 3;
+		result |= (ret & 0x10) >> 1;
+		result |= (ret & 0x08) << 1;
+		result |= (ret & 0x04) << 3;
+		result |= (ret & 0x02) << 5;
+		result |= (ret & 0x01) << 7;
+
+		buffer_out[index] = buffer_in[index] ^ result;
+	}
+}
+
+static void *fsk_whitening_setup(void)
+{
+	uint32_t seed = 0x12345678;
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		seed = seed * 1103515245 + 12345;
+		payload[i] = seed >> 16;
+	}
+	/* First use caches the sequence for the seed used by the radio drivers */
+	uint8_t buffer[1];
+	perform_data_whitening(FSK_WHITENING_SEED, payload, buffer, sizeof(buffer));
+	return NULL;
+}
+
+ZTEST(fsk_whitening, test_equal_to_reference_all_lengths)
+{
+	uint8_t expected[FSK_MAX_PAYLOAD_LENGTH];
+	uint8_t result[FSK_MAX_PAYLOAD_LENGTH];
+
+	for (uint16_t length = 0; length <= sizeof(payload); length++) {
+		reference_whitening(FSK_WHITENING_SEED, payload, expected, length);
+		perform_data_whitening(FSK_WHITENING_SEED, payload, result, length);
+		zassert_mem_equal(expected, result, length, "length %d", length);
+		semtech_fsk_whitening_lfsr(FSK_WHITENING_SEED, payload, result, length);
+		zassert_mem_equal(expected, result, length, "lfsr length %d", length);
+	}
+}
+
+ZTEST(fsk_whitening, test_equal_to_reference_other_seeds)
+{
+	const uint16_t seeds[] = { 0x0001, 0x00AA, 0x0155, 0x01FE };
+	uint8_t expected[FSK_MAX_PAYLOAD_LENGTH];
+	uint8_t result[FSK_MAX_PAYLOAD_LENGTH];
+
+	for (size_t s = 0; s < ARRAY_SIZE(seeds); s++) {
+		reference_whitening(seeds[s], payload, expected, sizeof(payload));
+		perform_data_whitening(seeds[s], payload, result, sizeof(payload));
+		zassert_mem_equal(expected, result, sizeof(payload), "seed 0x%x", seeds[s]);
+	}
+}
+
+ZTEST(fsk_whitening, test_longer_than_cached_sequence)
+{
+	static uint8_t input[3 * FSK_MAX_PAYLOAD_LENGTH];
+	static uint8_t expected[sizeof(input)];
+	static uint8_t result[sizeof(input)];
+
+	for (size_t i = 0; i < sizeof(input); i++) {
+		input[i] = payload[i % sizeof(payload)];
+	}
+	reference_whitening(FSK_WHITENING_SEED, input, expected, sizeof(input));
+	perform_data_whitening(FSK_WHITENING_SEED, input, result, sizeof(input));
+	zassert_mem_equal(expected, result, sizeof(input));
+}
+
+ZTEST(fsk_whitening, test_in_place_round_trip)
+{
+	uint8_t buffer[FSK_MAX_PAYLOAD_LENGTH];
+
+	memcpy(buffer, payload, sizeof(buffer));
+	perform_data_whitening(FSK_WHITENING_SEED, buffer, buffer, sizeof(buffer));
+	zassert_true(memcmp(buffer, payload, sizeof(buffer)) != 0);
+	perform_data_whitening(FSK_WHITENING_SEED, buffer, buffer, sizeof(buffer));
+	zassert_mem_equal(payload, buffer, sizeof(buffer));
+}
+
+ZTEST(fsk_whitening, test_dewhiten_crc_equal_to_separate_passes)
+{
+	uint8_t whitened[FSK_MAX_PAYLOAD_LENGTH];
+	uint8_t buffer[FSK_MAX_PAYLOAD_LENGTH];
+
+	reference_whitening(FSK_WHITENING_SEED, payload, whitened, sizeof(whitened));
+	for (uint16_t length = 1; length <= sizeof(payload); length++) {
+		for (uint16_t crc_length = 0; crc_length <= sizeof(uint32_t) && crc_length <= length;
+		     crc_length += 2) {
+			uint16_t data_length = length - crc_length;
+
+			memcpy(buffer, whitened, length);
+			uint16_t crc16 = semtech_fsk_dewhiten_crc16(FSK_WHITENING_SEED, buffer,
+								    length, data_length);
+			zassert_mem_equal(payload, buffer, length, "length %d", length);
+			zassert_equal(compute_crc16(payload, data_length), crc16, "length %d",
+				      length);
+
+			memcpy(buffer, whitened, length);
+			uint32_t crc32 = semtech_fsk_dewhiten_crc32(FSK_WHITENING_SEED, buffer,
+								    length, data_length);
+			zassert_mem_equal(payload, buffer, length, "length %d", length);
+			zassert_equal(compute_crc32(payload, data_length), crc32, "length %d",
+				      length);
+		}
+	}
+}
+
+ZTEST(fsk_whitening, test_dewhiten_crc_invalid_input)
+{
+	zassert_equal(0, semtech_fsk_dewhiten_crc16(FSK_WHITENING_SEED, NULL, 10, 8));
+	zassert_equal(0, semtech_fsk_dewhiten_crc32(FSK_WHITENING_SEED, NULL, 10, 6));
+}
+
+static uint64_t benchmark_cycles(uint8_t mode, uint16_t length)
+{
+	uint8_t buffer[FSK_MAX_PAYLOAD_LENGTH];
+	volatile uint32_t sink = 0;
+
+	memcpy(buffer, payload, length);
+	timing_t start = timing_counter_get();
+	for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		switch (mode) {
+		case 0:
+			semtech_fsk_whitening_lfsr(FSK_WHITENING_SEED, buffer, buffer, length);
+			sink += compute_crc32(buffer, length - sizeof(uint32_t));
+			break;
+		case 1:
+			perform_data_whitening(FSK_WHITENING_SEED, buffer, buffer, length);
+			sink += compute_crc32(buffer, length - sizeof(uint32_t));
+			break;
+		default:
+			sink += semtech_fsk_dewhiten_crc32(FSK_WHITENING_SEED, buffer, length,
+							   length - sizeof(uint32_t));
+			break;
+		}
+	}
+	timing_t end = timing_counter_get();
+	(void)sink;
+	return timing_cycles_get(&start, &end) / BENCHMARK_ITERATIONS;
+}
+
+ZTEST(fsk_whitening, test_benchmark)
+{
+	const char *const modes[] = { "lfsr + crc32", "cached + crc32", "fused" };
+	const uint16_t lengths[] = { 16, 64, FSK_MAX_PAYLOAD_LENGTH };
+
+	timing_init();
+	timing_start();
+	for (uint8_t m = 0; m < ARRAY_SIZE(modes); m++) {
+		for (size_t l = 0; l < ARRAY_SIZE(lengths); l++) {
+			uint64_t cycles = benchmark_cycles(m, lengths[l]);
+			TC_PRINT("%-14s %3d bytes: %6llu cycles (%6llu ns)\n", modes[m], lengths[l],
+				 cycles, timing_cycles_to_ns(cycles));
+		}
+	}
+	timing_stop();
+}
+
+ZTEST_SUITE(fsk_whitening, NULL, fsk_whitening_setup, NULL, NULL, NULL);
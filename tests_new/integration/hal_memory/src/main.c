@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <string.h>
+#include <sid_hal_memory_ifc.h>
+#include <sid_hal_memory_stats.h>
+
+/* Approximate sizes allocated for every message by the sid_end_device sample */
+#define SOAK_MSG_SIZE 28
+#define SOAK_EVENT_CTX_SIZE 12
+#define SOAK_TRANSFER_SIZE 16
+#define SOAK_PAYLOAD_MAX 255
+#define SOAK_IN_FLIGHT 8
+#define SOAK_ITERATIONS 20000
+
+#define HEAP_SIZE (CONFIG_SIDEWALK_HEAP_SIZE + CONFIG_SID_HAL_PROTOCOL_MEMORY_SZ)
+
+struct soak_msg {
+	void *msg;
+	void *payload;
+	void *ctx;
+};
+
+static uint32_t soak_random_state;
+
+static uint32_t soak_random(void)
+{
+	/* Numerical Recipes LCG, the same sequence for both configurations */
+	soak_random_state = soak_random_state * 1664525u + 1013904223u;
+	return soak_random_state >> 8;
+}
+
+static void *alloc_checked(size_t size)
+{
+	void *ptr = sid_hal_malloc(size);
+
+	zassert_not_null(ptr, "allocation of %zu bytes failed", size);
+	memset(ptr, 0xA5, size);
+	return ptr;
+}
+
+/* Binary search for the largest block which can be allocated now */
+static size_t largest_free_get(size_t limit)
+{
+	size_t low = 0;
+	size_t high = limit;
+
+	while (low < high) {
+		size_t size = low + (high - low + 1) / 2;
+		void *ptr = sid_hal_malloc(size);
+
+		if (ptr) {
+			sid_hal_free(ptr);
+			low = size;
+		} else {
+			high = size - 1;
+		}
+	}
+
+	return low;
+}
+
+static void memory_setup_each(void *fixture)
+{
+	ARG_UNUSED(fixture);
+	soak_random_state = 1;
+}
+
+ZTEST(hal_memory, test_alloc_free_heap)
+{
+	void *ptr = alloc_checked(1000);
+
+	sid_hal_free(ptr);
+	zassert_is_null(sid_hal_malloc(0));
+	zassert_is_null(sid_hal_malloc(HEAP_SIZE));
+}
+
+ZTEST(hal_memory, test_size_classes)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_SIDEWALK_HEAP_SLAB_POOLS);
+
+	static const size_t sizes[] = { 1, 16, 17, 32, 33, 64, 65, 256 };
+	static const size_t classes[] = { 0, 0, 1, 1, 2, 2, 3, 3 };
+	struct sid_hal_memory_stats before, after;
+	void *ptr[ARRAY_SIZE(sizes)];
+
+	sid_hal_memory_stats_get(&before);
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		ptr[i] = alloc_checked(sizes[i]);
+	}
+	sid_hal_memory_stats_get(&after);
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		size_t class = classes[i];
+
+		zassert_true(sizes[i] <= after.pools[class].block_size);
+		zassert_equal(0, (uintptr_t)ptr[i] % 8, "block %p not aligned", ptr[i]);
+	}
+	for (size_t class = 0; class < SID_HAL_MEMORY_POOL_COUNT; class++) {
+		zassert_equal(before.pools[class].hits + 2, after.pools[class].hits);
+		zassert_equal(before.pools[class].used + 2, after.pools[class].used);
+		zassert_equal(before.pools[class].misses, after.pools[class].misses);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		sid_hal_free(ptr[i]);
+	}
+	sid_hal_memory_stats_get(&after);
+	for (size_t class = 0; class < SID_HAL_MEMORY_POOL_COUNT; class++) {
+		zassert_equal(before.pools[class].used, after.pools[class].used);
+	}
+}
+
+ZTEST(hal_memory, test_pool_exhausted_falls_back_to_heap)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_SIDEWALK_HEAP_SLAB_POOLS);
+
+	void *ptr[CONFIG_SIDEWALK_HEAP_SLAB_16_COUNT + 1];
+	struct sid_hal_memory_stats before, after;
+
+	sid_hal_memory_stats_get(&before);
+	for (size_t i = 0; i < ARRAY_SIZE(ptr); i++) {
+		ptr[i] = alloc_checked(16);
+	}
+	sid_hal_memory_stats_get(&after);
+
+	zassert_equal(after.pools[0].num_blocks, after.pools[0].used);
+	zassert_equal(after.pools[0].num_blocks, after.pools[0].max_used);
+	zassert_equal(before.pools[0].misses + 1, after.pools[0].misses);
+	zassert_equal(before.pools[1].hits, after.pools[1].hits, "heap serves the fallback");
+
+	for (size_t i = 0; i < ARRAY_SIZE(ptr); i++) {
+		sid_hal_free(ptr[i]);
+	}
+	sid_hal_memory_stats_get(&after);
+	zassert_equal(0, after.pools[0].used);
+	zassert_equal(after.heap_free, before.heap_free, "heap block not returned");
+}
+
+ZTEST(hal_memory, test_heap_stats)
+{
+	struct sid_hal_memory_stats stats;
+
+	sid_hal_memory_stats_get(&stats);
+	zassert_equal(HEAP_SIZE, stats.heap_size);
+	zassert_true(stats.heap_free > 0);
+	zassert_true(stats.heap_free <= stats.heap_size);
+
+	void *ptr = alloc_checked(1000);
+	struct sid_hal_memory_stats allocated;
+
+	sid_hal_memory_stats_get(&allocated);
+	zassert_true(allocated.heap_free + 1000 <= stats.heap_free);
+	zassert_true(allocated.heap_max_allocated >= 1000);
+
+	sid_hal_free(ptr);
+	sid_hal_memory_stats_get(&allocated);
+	zassert_equal(stats.heap_free, allocated.heap_free, "heap block not returned");
+}
+
+/*
+ * Message send soak: every message allocates the message descriptor, the payload and
+ * the event context, a few of them also a transfer descriptor. Messages are freed in
+ * random order, with up to SOAK_IN_FLIGHT messages pending at any time.
+ */
+ZTEST(hal_memory, test_message_send_soak_benchmark)
+{
+	struct soak_msg in_flight[SOAK_IN_FLIGHT] = {};
+	uint64_t alloc_cycles = 0;
+	uint64_t free_cycles = 0;
+	uint32_t allocs = 0;
+	uint32_t frees = 0;
+
+	timing_init();
+	timing_start();
+
+	for (uint32_t i = 0; i < SOAK_ITERATIONS; i++) {
+		struct soak_msg *slot = &in_flight[soak_random() % SOAK_IN_FLIGHT];
+		timing_t start, end;
+
+		if (slot->msg) {
+			start = timing_counter_get();
+			sid_hal_free(slot->payload);
+			sid_hal_free(slot->ctx);
+			sid_hal_free(slot->msg);
+			end = timing_counter_get();
+			free_cycles += timing_cycles_get(&start, &end);
+			frees += 3;
+		}
+
+		size_t payload_size = 1 + soak_random() % SOAK_PAYLOAD_MAX;
+
+		start = timing_counter_get();
+		slot->msg = sid_hal_malloc(SOAK_MSG_SIZE);
+		slot->payload = sid_hal_malloc(payload_size);
+		slot->ctx = sid_hal_malloc((soak_random() % 4) ? SOAK_EVENT_CTX_SIZE :
+								   SOAK_TRANSFER_SIZE);
+		end = timing_counter_get();
+		alloc_cycles += timing_cycles_get(&start, &end);
+		allocs += 3;
+
+		zassert_not_null(slot->msg);
+		zassert_not_null(slot->payload, "payload of %zu bytes at iteration %u",
+				 payload_size, i);
+		zassert_not_null(slot->ctx);
+	}
+
+	struct sid_hal_memory_stats stats;
+
+	sid_hal_memory_stats_get(&stats);
+
+	/* Fragmentation is the share of free heap bytes not usable for the largest block */
+	size_t largest_free = largest_free_get(stats.heap_free);
+	uint32_t fragmentation = 0;
+
+	if (stats.heap_free > largest_free) {
+		fragmentation = 100 - (uint32_t)((uint64_t)largest_free * 100 / stats.heap_free);
+	}
+
+	for (size_t i = 0; i < SOAK_IN_FLIGHT; i++) {
+		if (in_flight[i].msg) {
+			sid_hal_free(in_flight[i].payload);
+			sid_hal_free(in_flight[i].ctx);
+			sid_hal_free(in_flight[i].msg);
+		}
+	}
+	timing_stop();
+
+	TC_PRINT("%s: alloc %llu cycles (%llu ns), free %llu cycles (%llu ns)\n",
+		 IS_ENABLED(CONFIG_SIDEWALK_HEAP_SLAB_POOLS) ? "slab pools" : "heap only",
+		 alloc_cycles / allocs, timing_cycles_to_ns(alloc_cycles / allocs),
+		 free_cycles / frees, timing_cycles_to_ns(free_cycles / frees));
+	for (size_t i = 0; i < SID_HAL_MEMORY_POOL_COUNT; i++) {
+		TC_PRINT("pool %3zu: max %u/%u hits %u misses %u\n", stats.pools[i].block_size,
+			 stats.pools[i].max_used, stats.pools[i].num_blocks, stats.pools[i].hits,
+			 stats.pools[i].misses);
+	}
+	TC_PRINT("heap: max allocated %zu/%zu, with %u messages in flight free %zu largest free "
+		 "%zu fragmentation %u%%\n",
+		 stats.heap_max_allocated, stats.heap_size, SOAK_IN_FLIGHT, stats.heap_free,
+		 largest_free, fragmentation);
+}
+
+ZTEST_SUITE(hal_memory, NULL, NULL, memory_setup_each, NULL, NULL);
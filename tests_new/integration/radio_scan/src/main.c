@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#include <semtech_radio_scan.h>
+#include <sid_pal_radio_ifc.h>
+
+#define TEST_CHANNELS 3
+#define TEST_SAMPLES 10
+
+static const uint32_t test_freqs[TEST_CHANNELS] = { 902200000, 902400000, 902600000 };
+
+/* Fake radio, RSSI samples are taken from the table of the tuned channel */
+static struct {
+	int16_t rssi[TEST_CHANNELS][SEMTECH_RADIO_SCAN_MAX_SAMPLES];
+	int channel;
+	uint32_t tunes;
+	uint32_t reads;
+	int32_t tune_err;
+	int64_t read_ms[SEMTECH_RADIO_SCAN_MAX_SAMPLES];
+} radio;
+
+static int32_t fake_tune(uint32_t freq)
+{
+	radio.channel = -1;
+	for (int i = 0; i < TEST_CHANNELS; i++) {
+		if (test_freqs[i] == freq) {
+			radio.channel = i;
+		}
+	}
+	zassert_true(radio.channel >= 0);
+	radio.tunes++;
+	radio.reads = 0;
+	return radio.tune_err;
+}
+
+static int16_t fake_rssi(void)
+{
+	zassert_true(radio.reads < SEMTECH_RADIO_SCAN_MAX_SAMPLES);
+	radio.read_ms[radio.reads] = k_uptime_get();
+	return radio.rssi[radio.channel][radio.reads++];
+}
+
+static const struct semtech_radio_scan_ops fake_ops = {
+	.tune = fake_tune,
+	.rssi = fake_rssi,
+};
+
+static struct semtech_radio_scan_plan plan;
+static struct semtech_radio_scan_result results[TEST_CHANNELS];
+
+static void radio_scan_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+	memset(&radio, 0, sizeof(radio));
+	memset(results, 0, sizeof(results));
+	plan = (struct semtech_radio_scan_plan){
+		.samples = TEST_SAMPLES,
+		.period_us = 100,
+		.settle_us = 0,
+		.percentile = 90,
+		.busy_threshold = INT16_MAX,
+	};
+}
+
+ZTEST(radio_scan, test_statistics)
+{
+	/* Samples -100..-91 in shuffled order on the first channel, flat and rising on the others */
+	static const int16_t ch0[TEST_SAMPLES] = { -95, -100, -91, -97, -93,
+						   -99, -92, -96, -98, -94 };
+
+	memcpy(radio.rssi[0], ch0, sizeof(ch0));
+	for (int i = 0; i < TEST_SAMPLES; i++) {
+		radio.rssi[1][i] = -120;
+		radio.rssi[2][i] = -120 + i;
+	}
+
+	zassert_equal(RADIO_ERROR_NONE,
+		      semtech_radio_scan_run(&fake_ops, test_freqs, TEST_CHANNELS, &plan, results));
+	zassert_equal(TEST_CHANNELS, radio.tunes);
+
+	zassert_equal(test_freqs[0], results[0].freq);
+	zassert_equal(TEST_SAMPLES, results[0].samples);
+	zassert_equal(-95, results[0].mean);
+	zassert_equal(-91, results[0].max);
+	zassert_equal(-92, results[0].percentile);
+	zassert_true(results[0].is_free);
+
+	zassert_equal(-120, results[1].mean);
+	zassert_equal(-120, results[1].max);
+	zassert_equal(-120, results[1].percentile);
+
+	zassert_equal(-111, results[2].max);
+	zassert_equal(-112, results[2].percentile);
+}
+
+ZTEST(radio_scan, test_busy_channel_stops_sampling)
+{
+	for (int i = 0; i < TEST_SAMPLES; i++) {
+		radio.rssi[0][i] = -110;
+		radio.rssi[1][i] = (i == 3) ? -70 : -110;
+		radio.rssi[2][i] = -110;
+	}
+	plan.busy_threshold = -80;
+
+	zassert_equal(RADIO_ERROR_NONE,
+		      semtech_radio_scan_run(&fake_ops, test_freqs, TEST_CHANNELS, &plan, results));
+
+	zassert_true(results[0].is_free);
+	zassert_false(results[1].is_free);
+	zassert_equal(4, results[1].samples);
+	zassert_equal(-70, results[1].max);
+	zassert_true(results[2].is_free);
+	zassert_equal(TEST_SAMPLES, results[2].samples);
+}
+
+ZTEST(radio_scan, test_samples_paced_by_timer)
+{
+	plan.samples = 5;
+	plan.period_us = 10000;
+	plan.settle_us = 20000;
+
+	int64_t start = k_uptime_get();
+
+	zassert_equal(RADIO_ERROR_NONE,
+		      semtech_radio_scan_run(&fake_ops, test_freqs, 1, &plan, results));
+
+	zassert_true(radio.read_ms[0] - start >= 20);
+	for (int i = 1; i < plan.samples; i++) {
+		zassert_true(radio.read_ms[i] - radio.read_ms[i - 1] >= 9);
+	}
+}
+
+ZTEST(radio_scan, test_errors)
+{
+	radio.tune_err = RADIO_ERROR_HARDWARE_ERROR;
+	zassert_equal(RADIO_ERROR_HARDWARE_ERROR,
+		      semtech_radio_scan_run(&fake_ops, test_freqs, TEST_CHANNELS, &plan, results));
+	zassert_equal(1, radio.tunes);
+
+	radio.tune_err = RADIO_ERROR_NONE;
+	radio.rssi[0][2] = INT16_MAX;
+	zassert_equal(RADIO_ERROR_HARDWARE_ERROR,
+		      semtech_radio_scan_run(&fake_ops, test_freqs, TEST_CHANNELS, &plan, results));
+	zassert_equal(2, results[0].samples);
+}
+
+ZTEST(radio_scan, test_invalid_args)
+{
+	zassert_equal(RADIO_ERROR_INVALID_PARAMS,
+		      semtech_radio_scan_run(&fake_ops, NULL, TEST_CHANNELS, &plan, results));
+	zassert_equal(RADIO_ERROR_INVALID_PARAMS,
+		      semtech_radio_scan_run(&fake_ops, test_freqs, 0, &plan, results));
+	zassert_equal(RADIO_ERROR_INVALID_PARAMS,
+		      semtech_radio_scan_run(&fake_ops, test_freqs, TEST_CHANNELS, NULL, results));
+	zassert_equal(RADIO_ERROR_INVALID_PARAMS,
+		      semtech_radio_scan_run(NULL, test_freqs, TEST_CHANNELS, &plan, results));
+
+	plan.samples = SEMTECH_RADIO_SCAN_MAX_SAMPLES + 1;
+	zassert_equal(RADIO_ERROR_INVALID_PARAMS,
+		      semtech_radio_scan_run(&fake_ops, test_freqs, TEST_CHANNELS, &plan, results));
+
+	plan.samples = TEST_SAMPLES;
+	plan.percentile = 101;
+	zassert_equal(RADIO_ERROR_INVALID_PARAMS,
+		      semtech_radio_scan_run(&fake_ops, test_freqs, TEST_CHANNELS, &plan, results));
+	zassert_equal(0, radio.tunes);
+}
+
+ZTEST_SUITE(radio_scan, NULL, NULL, radio_scan_before, NULL, NULL);
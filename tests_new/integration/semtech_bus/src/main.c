@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+#include <semtech_bus.h>
+
+#define RADIO_MAX_PAYLOAD 255
+#define WRITE_BUFFER_CMD_SIZE 2
+#define READ_BUFFER_CMD_SIZE 3
+#define STAGING_SIZE (RADIO_MAX_PAYLOAD + READ_BUFFER_CMD_SIZE)
+
+/*
+ * Fake radio on the bus. Bytes sent by the host are logged, the device answers with
+ * the bytes in miso, one per clocked byte.
+ */
+static struct {
+	uint8_t mosi[2 * STAGING_SIZE];
+	uint8_t miso[2 * STAGING_SIZE];
+	size_t pos;
+	uint32_t xfers;
+} radio;
+
+static uint8_t staging[STAGING_SIZE];
+static uint8_t payload[RADIO_MAX_PAYLOAD];
+
+static uint8_t radio_clock_byte(uint8_t mosi)
+{
+	zassert_true(radio.pos < sizeof(radio.mosi));
+	radio.mosi[radio.pos] = mosi;
+	return radio.miso[radio.pos++];
+}
+
+static sid_error_t fake_xfer(const struct sid_pal_serial_bus_iface *iface,
+			     const struct sid_pal_serial_bus_client *client, uint8_t *tx,
+			     uint8_t *rx, size_t xfer_size)
+{
+	for (size_t i = 0; i < xfer_size; i++) {
+		uint8_t miso = radio_clock_byte(tx ? tx[i] : 0);
+
+		if (rx) {
+			rx[i] = miso;
+		}
+	}
+	radio.xfers++;
+	return SID_ERROR_NONE;
+}
+
+static sid_error_t fake_xfer_sg(const struct sid_pal_serial_bus_iface *iface,
+				const struct sid_pal_serial_bus_client *client,
+				const struct sid_pal_serial_bus_buf *bufs, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		for (size_t j = 0; j < bufs[i].len; j++) {
+			uint8_t miso = radio_clock_byte(bufs[i].tx ? bufs[i].tx[j] : 0);
+
+			if (bufs[i].rx) {
+				bufs[i].rx[j] = miso;
+			}
+		}
+	}
+	radio.xfers++;
+	return SID_ERROR_NONE;
+}
+
+/* Fake DMA: the transfer is done a moment later in the system workqueue */
+#define FAKE_DMA_TIME_MS 1
+
+static struct {
+	const struct sid_pal_serial_bus_buf *bufs;
+	size_t count;
+	sid_pal_serial_bus_xfer_done_t done;
+	void *context;
+	struct k_work_delayable work;
+} dma;
+
+static void fake_dma_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	sid_error_t err = fake_xfer_sg(NULL, NULL, dma.bufs, dma.count);
+
+	dma.done(err, dma.context);
+}
+
+static sid_error_t fake_xfer_async(const struct sid_pal_serial_bus_iface *iface,
+				   const struct sid_pal_serial_bus_client *client,
+				   const struct sid_pal_serial_bus_buf *bufs, size_t count,
+				   sid_pal_serial_bus_xfer_done_t done, void *context)
+{
+	if (k_work_delayable_is_pending(&dma.work)) {
+		return SID_ERROR_BUSY;
+	}
+
+	dma.bufs = bufs;
+	dma.count = count;
+	dma.done = done;
+	dma.context = context;
+	k_work_schedule(&dma.work, K_MSEC(FAKE_DMA_TIME_MS));
+
+	return SID_ERROR_NONE;
+}
+
+static const struct sid_pal_serial_bus_iface bus_legacy = {
+	.xfer = fake_xfer,
+};
+
+static const struct sid_pal_serial_bus_iface bus_sg = {
+	.xfer = fake_xfer,
+	.xfer_sg = fake_xfer_sg,
+};
+
+static const struct sid_pal_serial_bus_iface bus_async = {
+	.xfer = fake_xfer,
+	.xfer_sg = fake_xfer_sg,
+	.xfer_async = fake_xfer_async,
+};
+
+static const struct sid_pal_serial_bus_client client;
+
+static K_SEM_DEFINE(xfer_done_sem, 0, 1);
+static sid_error_t xfer_done_result;
+
+static void xfer_done(sid_error_t result, void *context)
+{
+	zassert_equal_ptr(&xfer_done_sem, context);
+	xfer_done_result = result;
+	k_sem_give(context);
+}
+
+static void semtech_bus_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&radio, 0, sizeof(radio));
+	for (size_t i = 0; i < sizeof(radio.miso); i++) {
+		radio.miso[i] = (uint8_t)(0xA5 ^ i);
+	}
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (uint8_t)i;
+	}
+	k_work_init_delayable(&dma.work, fake_dma_work_handler);
+	k_sem_reset(&xfer_done_sem);
+	xfer_done_result = SID_ERROR_GENERIC;
+	semtech_bus_stats_reset();
+}
+
+/* Same as the write buffer command of the radio drivers: opcode, offset and the payload */
+static uint32_t payload_write(const struct sid_pal_serial_bus_iface *bus)
+{
+	const uint8_t cmd[WRITE_BUFFER_CMD_SIZE] = { 0x0E, 0x00 };
+	const struct sid_pal_serial_bus_buf bufs[] = {
+		{ .tx = cmd, .len = sizeof(cmd) },
+		{ .tx = payload, .len = sizeof(payload) },
+	};
+	struct semtech_bus_stats stats;
+
+	zassert_equal(SID_ERROR_NONE, semtech_bus_xfer(bus, &client, staging, sizeof(staging),
+						       bufs, ARRAY_SIZE(bufs)));
+	zassert_equal(1, radio.xfers);
+	zassert_equal(sizeof(cmd) + sizeof(payload), radio.pos);
+	zassert_mem_equal(cmd, radio.mosi, sizeof(cmd));
+	zassert_mem_equal(payload, &radio.mosi[sizeof(cmd)], sizeof(payload));
+
+	semtech_bus_stats_get(&stats);
+	return stats.bytes_copied;
+}
+
+/* Same as the read buffer command of the radio drivers: opcode, offset, status and the data */
+static uint32_t payload_read(const struct sid_pal_serial_bus_iface *bus)
+{
+	const uint8_t cmd[READ_BUFFER_CMD_SIZE] = { 0x1E, 0x00, 0x00 };
+	uint8_t data[RADIO_MAX_PAYLOAD];
+	const struct sid_pal_serial_bus_buf bufs[] = {
+		{ .tx = cmd, .len = sizeof(cmd) },
+		{ .rx = data, .len = sizeof(data) },
+	};
+	struct semtech_bus_stats stats;
+
+	zassert_equal(SID_ERROR_NONE, semtech_bus_xfer(bus, &client, staging, sizeof(staging),
+						       bufs, ARRAY_SIZE(bufs)));
+	zassert_equal(1, radio.xfers);
+	zassert_mem_equal(cmd, radio.mosi, sizeof(cmd));
+	zassert_mem_equal(&radio.miso[sizeof(cmd)], data, sizeof(data));
+	for (size_t i = sizeof(cmd); i < radio.pos; i++) {
+		zassert_equal(0, radio.mosi[i], "NOP expected while reading");
+	}
+
+	semtech_bus_stats_get(&stats);
+	return stats.bytes_copied;
+}
+
+ZTEST(semtech_bus, test_write_sg_no_copy)
+{
+	uint32_t copied = payload_write(&bus_sg);
+	struct semtech_bus_stats stats;
+
+	semtech_bus_stats_get(&stats);
+	zassert_equal(1, stats.sg_xfers);
+	zassert_equal(0, stats.staged_xfers);
+	zassert_equal(0, copied);
+	TC_PRINT("scatter-gather: %u bytes copied per %u bytes TX\n", copied, RADIO_MAX_PAYLOAD);
+}
+
+ZTEST(semtech_bus, test_write_staged)
+{
+	uint32_t copied = payload_write(&bus_legacy);
+	struct semtech_bus_stats stats;
+
+	semtech_bus_stats_get(&stats);
+	zassert_equal(0, stats.sg_xfers);
+	zassert_equal(1, stats.staged_xfers);
+	zassert_equal(WRITE_BUFFER_CMD_SIZE + RADIO_MAX_PAYLOAD, copied);
+	TC_PRINT("staging buffer: %u bytes copied per %u bytes TX\n", copied, RADIO_MAX_PAYLOAD);
+}
+
+ZTEST(semtech_bus, test_read_sg_no_copy)
+{
+	uint32_t copied = payload_read(&bus_sg);
+
+	zassert_equal(0, copied);
+	TC_PRINT("scatter-gather: %u bytes copied per %u bytes RX\n", copied, RADIO_MAX_PAYLOAD);
+}
+
+ZTEST(semtech_bus, test_read_staged)
+{
+	uint32_t copied = payload_read(&bus_legacy);
+
+	zassert_equal(READ_BUFFER_CMD_SIZE + RADIO_MAX_PAYLOAD, copied);
+	TC_PRINT("staging buffer: %u bytes copied per %u bytes RX\n", copied, RADIO_MAX_PAYLOAD);
+}
+
+ZTEST(semtech_bus, test_staging_too_small)
+{
+	const struct sid_pal_serial_bus_buf bufs[] = {
+		{ .tx = payload, .len = sizeof(payload) },
+		{ .tx = payload, .len = sizeof(payload) },
+	};
+
+	zassert_equal(SID_ERROR_OOM, semtech_bus_xfer(&bus_legacy, &client, staging,
+						      sizeof(staging), bufs, ARRAY_SIZE(bufs)));
+	zassert_equal(SID_ERROR_OOM,
+		      semtech_bus_xfer(&bus_legacy, &client, NULL, 0, bufs, 1));
+	zassert_equal(0, radio.xfers);
+
+	/* The scatter-gather bus does not need the staging buffer */
+	zassert_equal(SID_ERROR_NONE,
+		      semtech_bus_xfer(&bus_sg, &client, NULL, 0, bufs, ARRAY_SIZE(bufs)));
+	zassert_equal(2 * sizeof(payload), radio.pos);
+}
+
+ZTEST(semtech_bus, test_invalid_args)
+{
+	const struct sid_pal_serial_bus_buf buf = { .tx = payload, .len = sizeof(payload) };
+
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      semtech_bus_xfer(NULL, &client, staging, sizeof(staging), &buf, 1));
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      semtech_bus_xfer(&bus_sg, NULL, staging, sizeof(staging), &buf, 1));
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      semtech_bus_xfer(&bus_sg, &client, staging, sizeof(staging), NULL, 1));
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      semtech_bus_xfer(&bus_sg, &client, staging, sizeof(staging), &buf, 0));
+}
+
+ZTEST(semtech_bus, test_async_read_overlaps)
+{
+	const uint8_t cmd[READ_BUFFER_CMD_SIZE] = { 0x1E, 0x00, 0x00 };
+	static uint8_t data[RADIO_MAX_PAYLOAD];
+	const struct sid_pal_serial_bus_buf bufs[] = {
+		{ .tx = cmd, .len = sizeof(cmd) },
+		{ .rx = data, .len = sizeof(data) },
+	};
+	struct semtech_bus_stats stats;
+
+	zassert_equal(SID_ERROR_NONE,
+		      semtech_bus_xfer_async(&bus_async, &client, NULL, 0, bufs, ARRAY_SIZE(bufs),
+					     xfer_done, &xfer_done_sem));
+	zassert_equal(SID_ERROR_BUSY,
+		      semtech_bus_xfer_async(&bus_async, &client, NULL, 0, bufs, ARRAY_SIZE(bufs),
+					     xfer_done, &xfer_done_sem));
+
+	/* The caller is free until the transfer ends */
+	zassert_equal(0, radio.xfers);
+
+	zassert_equal(0, k_sem_take(&xfer_done_sem, K_MSEC(100)));
+	zassert_equal(SID_ERROR_NONE, xfer_done_result);
+	zassert_equal(1, radio.xfers);
+	zassert_mem_equal(&radio.miso[sizeof(cmd)], data, sizeof(data));
+
+	semtech_bus_stats_get(&stats);
+	zassert_equal(1, stats.async_xfers);
+	zassert_equal(0, stats.bytes_copied);
+}
+
+ZTEST(semtech_bus, test_async_fallback)
+{
+	const uint8_t cmd[WRITE_BUFFER_CMD_SIZE] = { 0x0E, 0x00 };
+	const struct sid_pal_serial_bus_buf bufs[] = {
+		{ .tx = cmd, .len = sizeof(cmd) },
+		{ .tx = payload, .len = sizeof(payload) },
+	};
+	struct semtech_bus_stats stats;
+
+	/* Without xfer_async the transfer is finished before return */
+	zassert_equal(SID_ERROR_NONE,
+		      semtech_bus_xfer_async(&bus_sg, &client, NULL, 0, bufs, ARRAY_SIZE(bufs),
+					     xfer_done, &xfer_done_sem));
+	zassert_equal(0, k_sem_take(&xfer_done_sem, K_NO_WAIT));
+	zassert_equal(SID_ERROR_NONE, xfer_done_result);
+	zassert_mem_equal(payload, &radio.mosi[sizeof(cmd)], sizeof(payload));
+
+	/* Errors of the staged transfer are reported to the callback */
+	zassert_equal(SID_ERROR_NONE,
+		      semtech_bus_xfer_async(&bus_legacy, &client, NULL, 0, bufs, ARRAY_SIZE(bufs),
+					     xfer_done, &xfer_done_sem));
+	zassert_equal(0, k_sem_take(&xfer_done_sem, K_NO_WAIT));
+	zassert_equal(SID_ERROR_OOM, xfer_done_result);
+
+	semtech_bus_stats_get(&stats);
+	zassert_equal(0, stats.async_xfers);
+	zassert_equal(1, stats.sg_xfers);
+
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      semtech_bus_xfer_async(&bus_sg, &client, NULL, 0, bufs, ARRAY_SIZE(bufs),
+					     NULL, NULL));
+}
+
+ZTEST_SUITE(semtech_bus, NULL, NULL, semtech_bus_before, NULL, NULL);
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#include <sid_pal_serial_bus_ifc.h>
+#include <sid_pal_serial_bus_spi_config.h>
+
+#include "radio_emul.h"
+
+#define RADIO_MAX_PAYLOAD 255
+#define XFER_TIMEOUT K_MSEC(100)
+
+static const struct sid_pal_serial_bus_iface *bus;
+static const struct sid_pal_serial_bus_client client;
+static uint8_t payload[RADIO_MAX_PAYLOAD];
+
+static K_SEM_DEFINE(done_sem, 0, 1);
+static sid_error_t done_result;
+static uint32_t done_calls;
+
+static void xfer_done(sid_error_t result, void *context)
+{
+	zassert_equal_ptr(&done_sem, context);
+	done_result = result;
+	done_calls++;
+	k_sem_give(&done_sem);
+}
+
+static void *spi_async_setup(void)
+{
+	zassert_equal(SID_ERROR_NONE, sid_pal_serial_bus_nordic_spi_create(&bus, NULL));
+	zassert_not_null(bus);
+	zassert_not_null(bus->xfer_async);
+
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (uint8_t)i;
+	}
+	return NULL;
+}
+
+static void spi_async_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&done_sem);
+	done_result = SID_ERROR_GENERIC;
+	done_calls = 0;
+	radio_emul_data_get()->frames = 0;
+}
+
+ZTEST(spi_async, test_write_payload)
+{
+	const uint8_t cmd[] = { 0x0E, 0x00 };
+	const struct sid_pal_serial_bus_buf bufs[] = {
+		{ .tx = cmd, .len = sizeof(cmd) },
+		{ .tx = payload, .len = sizeof(payload) },
+	};
+	struct radio_emul_data *radio = radio_emul_data_get();
+
+	zassert_equal(SID_ERROR_NONE, bus->xfer_async(bus, &client, bufs, ARRAY_SIZE(bufs),
+						      xfer_done, &done_sem));
+	zassert_equal(0, k_sem_take(&done_sem, XFER_TIMEOUT));
+	zassert_equal(SID_ERROR_NONE, done_result);
+
+	zassert_equal(1, radio->frames, "segments must share one chip select");
+	zassert_equal(sizeof(cmd) + sizeof(payload), radio->frame_len);
+	zassert_mem_equal(cmd, radio->frame, sizeof(cmd));
+	zassert_mem_equal(payload, &radio->frame[sizeof(cmd)], sizeof(payload));
+}
+
+ZTEST(spi_async, test_read_payload)
+{
+	const uint8_t cmd[] = { 0x1E, 0x00, 0x5A };
+	uint8_t status[sizeof(cmd)] = { 0 };
+	uint8_t data[RADIO_MAX_PAYLOAD];
+	const struct sid_pal_serial_bus_buf bufs[] = {
+		{ .tx = cmd, .rx = status, .len = sizeof(cmd) },
+		{ .rx = data, .len = sizeof(data) },
+	};
+	struct radio_emul_data *radio = radio_emul_data_get();
+
+	memset(data, 0, sizeof(data));
+	zassert_equal(SID_ERROR_NONE, bus->xfer_async(bus, &client, bufs, ARRAY_SIZE(bufs),
+						      xfer_done, &done_sem));
+	zassert_equal(0, k_sem_take(&done_sem, XFER_TIMEOUT));
+	zassert_equal(SID_ERROR_NONE, done_result);
+
+	zassert_equal(1, radio->frames);
+	zassert_equal(sizeof(cmd) + sizeof(data), radio->frame_len);
+	zassert_equal(RADIO_EMUL_FIRST_MISO, status[0]);
+	zassert_equal((uint8_t)~cmd[0], status[1]);
+	zassert_equal((uint8_t)~cmd[1], status[2]);
+
+	/* Data follows the last command byte, nothing else is sent meanwhile */
+	zassert_equal((uint8_t)~cmd[2], data[0]);
+	for (size_t i = 1; i < sizeof(data); i++) {
+		zassert_equal(0xFF, data[i]);
+		zassert_equal(0x00, radio->frame[sizeof(cmd) + i]);
+	}
+}
+
+ZTEST(spi_async, test_back_to_back)
+{
+	const struct sid_pal_serial_bus_buf buf = { .tx = payload, .len = 16 };
+
+	/* The bus is released before the callback, the woken thread can start the next transfer */
+	for (int i = 0; i < 2; i++) {
+		zassert_equal(SID_ERROR_NONE,
+			      bus->xfer_async(bus, &client, &buf, 1, xfer_done, &done_sem));
+		zassert_equal(0, k_sem_take(&done_sem, XFER_TIMEOUT));
+		zassert_equal(SID_ERROR_NONE, done_result);
+	}
+	zassert_equal(2, done_calls);
+	zassert_equal(2, radio_emul_data_get()->frames);
+}
+
+ZTEST(spi_async, test_invalid_args)
+{
+	const struct sid_pal_serial_bus_buf bufs[5] = {
+		{ .tx = payload, .len = 1 }, { .tx = payload, .len = 1 },
+		{ .tx = payload, .len = 1 }, { .tx = payload, .len = 1 },
+		{ .tx = payload, .len = 1 },
+	};
+	const struct sid_pal_serial_bus_iface other = { 0 };
+
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      bus->xfer_async(&other, &client, bufs, 1, xfer_done, &done_sem));
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      bus->xfer_async(bus, NULL, bufs, 1, xfer_done, &done_sem));
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      bus->xfer_async(bus, &client, NULL, 1, xfer_done, &done_sem));
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      bus->xfer_async(bus, &client, bufs, 0, xfer_done, &done_sem));
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      bus->xfer_async(bus, &client, bufs, ARRAY_SIZE(bufs), xfer_done, &done_sem));
+	zassert_equal(SID_ERROR_INVALID_ARGS,
+		      bus->xfer_async(bus, &client, bufs, 1, NULL, NULL));
+	zassert_equal(0, done_calls);
+	zassert_equal(0, radio_emul_data_get()->frames);
+}
+
+ZTEST_SUITE(spi_async, NULL, spi_async_setup, spi_async_before, NULL, NULL);
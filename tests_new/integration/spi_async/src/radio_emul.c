@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define DT_DRV_COMPAT nordic_sidewalk_radio_emul
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi_emul.h>
+#include <string.h>
+
+#include "radio_emul.h"
+
+/*
+ * Radio on the emulated SPI bus. Bytes sent by the host are logged, the radio answers
+ * with the inverted byte clocked out before.
+ */
+static struct radio_emul_data emul_data;
+
+static int radio_emul_io(const struct emul *target, const struct spi_config *config,
+			 const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs)
+{
+	size_t tx_idx = 0, tx_pos = 0;
+	size_t rx_idx = 0, rx_pos = 0;
+	uint8_t miso = RADIO_EMUL_FIRST_MISO;
+
+	ARG_UNUSED(target);
+	ARG_UNUSED(config);
+
+	emul_data.frame_len = 0;
+	emul_data.frames++;
+
+	while (true) {
+		bool tx_left = tx_bufs && tx_idx < tx_bufs->count;
+		bool rx_left = rx_bufs && rx_idx < rx_bufs->count;
+
+		if (!tx_left && !rx_left) {
+			break;
+		}
+
+		uint8_t mosi = 0;
+
+		if (tx_left) {
+			const struct spi_buf *buf = &tx_bufs->buffers[tx_idx];
+
+			if (buf->buf) {
+				mosi = ((const uint8_t *)buf->buf)[tx_pos];
+			}
+			if (++tx_pos >= buf->len) {
+				tx_idx++;
+				tx_pos = 0;
+			}
+		}
+
+		if (rx_left) {
+			const struct spi_buf *buf = &rx_bufs->buffers[rx_idx];
+
+			if (buf->buf) {
+				((uint8_t *)buf->buf)[rx_pos] = miso;
+			}
+			if (++rx_pos >= buf->len) {
+				rx_idx++;
+				rx_pos = 0;
+			}
+		}
+
+		if (emul_data.frame_len < sizeof(emul_data.frame)) {
+			emul_data.frame[emul_data.frame_len++] = mosi;
+		}
+		miso = ~mosi;
+	}
+
+	return 0;
+}
+
+static struct spi_emul_api radio_emul_api = {
+	.io = radio_emul_io,
+};
+
+static int radio_emul_init(const struct emul *target, const struct device *parent)
+{
+	ARG_UNUSED(target);
+	ARG_UNUSED(parent);
+
+	return 0;
+}
+
+struct radio_emul_data *radio_emul_data_get(void)
+{
+	return &emul_data;
+}
+
+#define RADIO_EMUL(n) EMUL_DT_INST_DEFINE(n, radio_emul_init, NULL, NULL, &radio_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(RADIO_EMUL)
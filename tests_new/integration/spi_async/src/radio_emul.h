@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RADIO_EMUL_H
+#define RADIO_EMUL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Byte clocked out by the radio with the first byte of every frame */
+#define RADIO_EMUL_FIRST_MISO 0xA2
+
+struct radio_emul_data {
+	/* Bytes received in the last frame */
+	uint8_t frame[300];
+	size_t frame_len;
+	/* Number of frames, chip select assertions */
+	uint32_t frames;
+};
+
+struct radio_emul_data *radio_emul_data_get(void);
+
+#endif /* RADIO_EMUL_H */
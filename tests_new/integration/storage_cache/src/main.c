@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <string.h>
+
+#include <sid_pal_storage_kv_ifc.h>
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+#include <sid_storage_cache.h>
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
+#define GROUP_ID_TEST 0x10
+#define GROUP_ID_TEST_OTHER 0x11
+
+/* Sidewalk updates a handful of counters and session records on every message */
+#define BENCH_KEYS 8
+#define BENCH_ROUNDS 200
+
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+#define LARGE_RECORD_SIZE (CONFIG_SIDEWALK_STORAGE_CACHE_DATA_SIZE + 1)
+#else
+#define LARGE_RECORD_SIZE 128
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
+enum test_keys {
+	TEST_KEY_COUNTER,
+	TEST_KEY_SESSION,
+	TEST_KEY_LARGE,
+	TEST_KEY_MISSING,
+};
+
+static void *storage_cache_setup(void)
+{
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_init());
+	return NULL;
+}
+
+static void storage_cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_group_delete(GROUP_ID_TEST));
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_group_delete(GROUP_ID_TEST_OTHER));
+}
+
+ZTEST(storage_cache, test_read_after_write)
+{
+	uint32_t counter = 0x12345678;
+	uint32_t read = 0;
+	uint32_t len = 0;
+
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_record_set(GROUP_ID_TEST, TEST_KEY_COUNTER,
+								   &counter, sizeof(counter)));
+	zassert_equal(SID_ERROR_NONE,
+		      sid_pal_storage_kv_record_get_len(GROUP_ID_TEST, TEST_KEY_COUNTER, &len));
+	zassert_equal(sizeof(counter), len);
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_record_get(GROUP_ID_TEST, TEST_KEY_COUNTER,
+								   &read, sizeof(read)));
+	zassert_equal(counter, read);
+
+	zassert_equal(SID_ERROR_NONE,
+		      sid_pal_storage_kv_record_delete(GROUP_ID_TEST, TEST_KEY_COUNTER));
+	zassert_equal(SID_ERROR_NOT_FOUND, sid_pal_storage_kv_record_get(
+						   GROUP_ID_TEST, TEST_KEY_COUNTER, &read, sizeof(read)));
+	zassert_equal(SID_ERROR_NOT_FOUND,
+		      sid_pal_storage_kv_record_get_len(GROUP_ID_TEST, TEST_KEY_MISSING, &len));
+}
+
+ZTEST(storage_cache, test_large_record_written_through)
+{
+	static uint8_t large[LARGE_RECORD_SIZE];
+	static uint8_t read[sizeof(large)];
+	uint32_t small = 1;
+	uint32_t len = 0;
+
+	memset(large, 0x5A, sizeof(large));
+
+	/* A cached small value is replaced by a large one, which must not be shadowed */
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_record_set(GROUP_ID_TEST, TEST_KEY_LARGE,
+								   &small, sizeof(small)));
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_record_set(GROUP_ID_TEST, TEST_KEY_LARGE,
+								   large, sizeof(large)));
+	zassert_equal(SID_ERROR_NONE,
+		      sid_pal_storage_kv_record_get_len(GROUP_ID_TEST, TEST_KEY_LARGE, &len));
+	zassert_equal(sizeof(large), len);
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_record_get(GROUP_ID_TEST, TEST_KEY_LARGE,
+								   read, sizeof(read)));
+	zassert_mem_equal(large, read, sizeof(large));
+}
+
+ZTEST(storage_cache, test_group_delete_drops_pending_writes)
+{
+	uint32_t value = 7;
+	uint32_t read = 0;
+
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_record_set(GROUP_ID_TEST, TEST_KEY_SESSION,
+								   &value, sizeof(value)));
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_record_set(
+					      GROUP_ID_TEST_OTHER, TEST_KEY_SESSION, &value,
+					      sizeof(value)));
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_group_delete(GROUP_ID_TEST));
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_deinit());
+
+	zassert_equal(SID_ERROR_NOT_FOUND, sid_pal_storage_kv_record_get(
+						   GROUP_ID_TEST, TEST_KEY_SESSION, &read, sizeof(read)));
+	zassert_equal(SID_ERROR_NONE,
+		      sid_pal_storage_kv_record_get(GROUP_ID_TEST_OTHER, TEST_KEY_SESSION, &read,
+						    sizeof(read)));
+	zassert_equal(value, read);
+}
+
+ZTEST(storage_cache, test_writes_coalesced_until_flush)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_SIDEWALK_STORAGE_CACHE);
+
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	struct sid_storage_cache_stats before, after;
+
+	zassert_equal(0, sid_storage_cache_flush());
+	sid_storage_cache_stats_get(&before);
+
+	for (uint32_t counter = 0; counter < 100; counter++) {
+		zassert_equal(SID_ERROR_NONE,
+			      sid_pal_storage_kv_record_set(GROUP_ID_TEST, TEST_KEY_COUNTER,
+							    &counter, sizeof(counter)));
+	}
+	sid_storage_cache_stats_get(&after);
+	zassert_equal(before.backend_writes, after.backend_writes, "written before the flush");
+
+	zassert_equal(0, sid_storage_cache_flush());
+	sid_storage_cache_stats_get(&after);
+	zassert_equal(before.backend_writes + 1, after.backend_writes);
+	zassert_equal(before.flushes + 1, after.flushes);
+	zassert_true(after.writes_coalesced - before.writes_coalesced >= 99);
+
+	/* Nothing pending, the flush does not touch the backend */
+	zassert_equal(0, sid_storage_cache_flush());
+	sid_storage_cache_stats_get(&before);
+	zassert_equal(before.backend_writes, after.backend_writes);
+	zassert_equal(before.flushes, after.flushes);
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+}
+
+ZTEST(storage_cache, test_periodic_flush)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_SIDEWALK_STORAGE_CACHE);
+
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	if (CONFIG_SIDEWALK_STORAGE_CACHE_FLUSH_INTERVAL_MS == 0) {
+		ztest_test_skip();
+	}
+
+	struct sid_storage_cache_stats before, after;
+	uint32_t value = 0xCAFE;
+
+	zassert_equal(0, sid_storage_cache_flush());
+	sid_storage_cache_stats_get(&before);
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_record_set(GROUP_ID_TEST, TEST_KEY_SESSION,
+								   &value, sizeof(value)));
+	k_sleep(K_MSEC(CONFIG_SIDEWALK_STORAGE_CACHE_FLUSH_INTERVAL_MS + 100));
+	sid_storage_cache_stats_get(&after);
+	zassert_equal(before.backend_writes + 1, after.backend_writes);
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+}
+
+/*
+ * Every round rewrites BENCH_KEYS counters and reads them back, like the stack does while
+ * sending messages. Prints the average read latency and the number of records written to
+ * the settings backend, to be compared with the no_cache scenario.
+ */
+ZTEST(storage_cache, test_counter_update_benchmark)
+{
+	uint64_t read_cycles = 0;
+	uint64_t write_cycles = 0;
+	uint32_t reads = 0;
+	uint32_t writes = 0;
+
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	struct sid_storage_cache_stats before, after;
+
+	zassert_equal(0, sid_storage_cache_flush());
+	sid_storage_cache_stats_get(&before);
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
+	timing_init();
+	timing_start();
+
+	for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+		for (uint16_t key = 0; key < BENCH_KEYS; key++) {
+			uint32_t value = round * BENCH_KEYS + key;
+			uint32_t read = 0;
+			timing_t start, end;
+
+			start = timing_counter_get();
+			zassert_equal(SID_ERROR_NONE,
+				      sid_pal_storage_kv_record_set(GROUP_ID_TEST_OTHER, key, &value,
+								    sizeof(value)));
+			end = timing_counter_get();
+			write_cycles += timing_cycles_get(&start, &end);
+			writes++;
+
+			start = timing_counter_get();
+			zassert_equal(SID_ERROR_NONE,
+				      sid_pal_storage_kv_record_get(GROUP_ID_TEST_OTHER, key, &read,
+								    sizeof(read)));
+			end = timing_counter_get();
+			read_cycles += timing_cycles_get(&start, &end);
+			reads++;
+			zassert_equal(value, read);
+		}
+	}
+
+	timing_stop();
+	zassert_equal(SID_ERROR_NONE, sid_pal_storage_kv_deinit());
+
+	uint32_t backend_writes = writes;
+
+#if CONFIG_SIDEWALK_STORAGE_CACHE
+	sid_storage_cache_stats_get(&after);
+	backend_writes = after.backend_writes - before.backend_writes;
+	TC_PRINT("cache: read hits %u misses %u, flushes %u\n",
+		 after.read_hits - before.read_hits, after.read_misses - before.read_misses,
+		 after.flushes - before.flushes);
+#endif /* CONFIG_SIDEWALK_STORAGE_CACHE */
+
+	TC_PRINT("%s: read %llu cycles (%llu ns), write %llu cycles (%llu ns), "
+		 "%u writes, %u records written to flash\n",
+		 IS_ENABLED(CONFIG_SIDEWALK_STORAGE_CACHE) ? "write-back cache" : "no cache",
+		 read_cycles / reads, timing_cycles_to_ns(read_cycles / reads),
+		 write_cycles / writes, timing_cycles_to_ns(write_cycles / writes), writes,
+		 backend_writes);
+}
+
+ZTEST_SUITE(storage_cache, NULL, storage_cache_setup, storage_cache_before, NULL, NULL);
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#include <sx126x_radio.h>
+#include <sx126x_shadow.h>
+
+#define TEST_FREQ_HZ 915000000
+#define TEST_FREQ_OTHER_HZ 902200000
+#define TEST_FSK_IRQ_MASK (SX126X_IRQ_TX_DONE | SX126X_IRQ_RX_DONE | SX126X_IRQ_TIMEOUT)
+#define TEST_PAYLOAD_SIZE 20
+#define BENCH_CYCLES 10
+
+static const radio_sx126x_device_config_t radio_config;
+static halo_drv_semtech_ctx_t drv_ctx = {
+	.config = &radio_config,
+	.radio_state = SID_PAL_RADIO_STANDBY,
+};
+
+/* Fake radio, counts the SPI transactions */
+static struct {
+	uint32_t xfers;
+	uint32_t opcodes[UINT8_MAX + 1];
+	bool fail_next;
+} radio;
+
+int32_t sx126x_radio_bus_xfer(const uint8_t *cmd_buffer, const uint16_t cmd_buffer_size,
+			      uint8_t *buffer, const uint16_t size, uint8_t read_offset)
+{
+	radio.xfers++;
+	radio.opcodes[cmd_buffer[0]]++;
+	if (radio.fail_next) {
+		radio.fail_next = false;
+		return RADIO_ERROR_IO_ERROR;
+	}
+	if (read_offset && buffer) {
+		memset(buffer, 0, size);
+	}
+	return RADIO_ERROR_NONE;
+}
+
+int32_t sx126x_wait_on_busy(void)
+{
+	return RADIO_ERROR_NONE;
+}
+
+int32_t radio_sx126x_set_radio_mode(bool rf_en, bool tx_en)
+{
+	return RADIO_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_set_direction(uint32_t gpio_number, sid_pal_gpio_direction_t direction)
+{
+	return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_write(uint32_t gpio_number, uint8_t value)
+{
+	return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_input_mode(uint32_t gpio_number, sid_pal_gpio_input_t mode)
+{
+	return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_pull_mode(uint32_t gpio_number, sid_pal_gpio_pull_t pull)
+{
+	return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_irq_enable(uint32_t gpio_number)
+{
+	return SID_ERROR_NONE;
+}
+
+sid_error_t sid_pal_gpio_irq_disable(uint32_t gpio_number)
+{
+	return SID_ERROR_NONE;
+}
+
+void sid_pal_delay_us(uint32_t delay)
+{
+}
+
+void sid_pal_enter_critical_region(void)
+{
+}
+
+void sid_pal_exit_critical_region(void)
+{
+}
+
+static const sx126x_mod_params_gfsk_t fsk_mod_params = {
+	.br_in_bps = 50000,
+	.fdev_in_hz = 25000,
+	.mod_shape = SX126X_GFSK_MOD_SHAPE_BT_1,
+	.bw_dsb_param = SX126X_GFSK_BW_234300,
+};
+
+static const sx126x_pkt_params_gfsk_t fsk_tx_pkt_params = {
+	.pbl_len_in_bits = 64,
+	.pbl_min_det = SX126X_GFSK_PBL_DET_16_BITS,
+	.sync_word_len_in_bits = 24,
+	.addr_cmp = SX126X_GFSK_ADDR_CMP_FILT_OFF,
+	.hdr_type = SX126X_GFSK_PKT_VAR_LEN,
+	.pld_len_in_bytes = TEST_PAYLOAD_SIZE,
+	.crc_type = SX126X_GFSK_CRC_2_BYTES_INV,
+	.dc_free = SX126X_GFSK_DC_FREE_WHITENING,
+};
+
+static const uint8_t fsk_sync_word[] = { 0x55, 0x90, 0x4E };
+
+static void radio_irq_process(void)
+{
+	sx126x_irq_mask_t irq_status;
+
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_dio_irq_params(&drv_ctx, 0, 0, 0, 0));
+	zassert_equal(SX126X_STATUS_OK, sx126x_get_and_clear_irq_status(&drv_ctx, &irq_status));
+	zassert_equal(SX126X_STATUS_OK,
+		      sx126x_set_dio_irq_params(&drv_ctx, TEST_FSK_IRQ_MASK, TEST_FSK_IRQ_MASK, 0, 0));
+}
+
+/*
+ * Commands the radio driver sends for a FSK transmission followed by a receive window,
+ * without putting the radio to sleep in between.
+ */
+static void radio_tx_rx_cycle(void)
+{
+	static const uint8_t payload[TEST_PAYLOAD_SIZE];
+	sx126x_pkt_params_gfsk_t rx_pkt_params = fsk_tx_pkt_params;
+	sx126x_pa_cfg_params_t pa_cfg = { .pa_duty_cycle = 4, .hp_max = 7, .pa_lut = 1 };
+
+	rx_pkt_params.pld_len_in_bytes = UINT8_MAX;
+
+	/* sid_pal_radio_set_modem_mode() */
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_pkt_type(&drv_ctx, SX126X_PKT_TYPE_GFSK));
+	zassert_equal(SX126X_STATUS_OK,
+		      sx126x_set_dio_irq_params(&drv_ctx, TEST_FSK_IRQ_MASK, TEST_FSK_IRQ_MASK, 0, 0));
+
+	/* TX */
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_pa_cfg(&drv_ctx, &pa_cfg));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_tx_params(&drv_ctx, 14, SX126X_RAMP_40_US));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_mod_params(&drv_ctx, &fsk_mod_params));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_pkt_params(&drv_ctx, &fsk_tx_pkt_params));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_sync_word(&drv_ctx, fsk_sync_word,
+								  sizeof(fsk_sync_word)));
+	zassert_equal(SX126X_STATUS_OK, sx126x_write_buffer(&drv_ctx, 0, payload, sizeof(payload)));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_tx(&drv_ctx, 0));
+	radio_irq_process();
+
+	/* RX */
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_mod_params(&drv_ctx, &fsk_mod_params));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_pkt_params(&drv_ctx, &rx_pkt_params));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_sync_word(&drv_ctx, fsk_sync_word,
+								  sizeof(fsk_sync_word)));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rx(&drv_ctx, 0));
+	radio_irq_process();
+}
+
+static void sx126x_shadow_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+	memset(&radio, 0, sizeof(radio));
+	sx126x_shadow_invalidate();
+	sx126x_shadow_stats_reset();
+}
+
+ZTEST(sx126x_shadow, test_repeated_write_elided)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW);
+
+	struct sx126x_shadow_stats stats;
+
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(1, radio.opcodes[SX126X_SET_RFFREQUENCY]);
+
+	sx126x_shadow_stats_get(&stats);
+	zassert_equal(1, stats.written[SX126X_SHADOW_RF_FREQUENCY]);
+	zassert_equal(1, stats.elided[SX126X_SHADOW_RF_FREQUENCY]);
+}
+
+ZTEST(sx126x_shadow, test_changed_write_sent)
+{
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_OTHER_HZ));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(3, radio.opcodes[SX126X_SET_RFFREQUENCY]);
+
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_sync_word(&drv_ctx, fsk_sync_word,
+								  sizeof(fsk_sync_word)));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_sync_word(&drv_ctx, fsk_sync_word, 2));
+	zassert_equal(2, radio.opcodes[SX126X_WRITE_REGISTER]);
+}
+
+ZTEST(sx126x_shadow, test_pkt_type_drops_params)
+{
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_pkt_type(&drv_ctx, SX126X_PKT_TYPE_GFSK));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_pkt_params(&drv_ctx, &fsk_tx_pkt_params));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_pkt_type(&drv_ctx, SX126X_PKT_TYPE_LORA));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_pkt_type(&drv_ctx, SX126X_PKT_TYPE_GFSK));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_gfsk_pkt_params(&drv_ctx, &fsk_tx_pkt_params));
+
+	zassert_equal(3, radio.opcodes[SX126X_SET_PACKETTYPE]);
+	zassert_equal(2, radio.opcodes[SX126X_SET_PACKETPARAMS]);
+}
+
+ZTEST(sx126x_shadow, test_sleep_reset_wakeup_invalidate)
+{
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_sleep(&drv_ctx, SX126X_SLEEP_CFG_WARM_START));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(2, radio.opcodes[SX126X_SET_RFFREQUENCY]);
+
+	zassert_equal(SX126X_STATUS_OK, sx126x_wakeup(&drv_ctx));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(3, radio.opcodes[SX126X_SET_RFFREQUENCY]);
+
+	zassert_equal(SX126X_STATUS_OK, sx126x_reset(&drv_ctx));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_rf_freq(&drv_ctx, TEST_FREQ_HZ));
+	zassert_equal(4, radio.opcodes[SX126X_SET_RFFREQUENCY]);
+}
+
+ZTEST(sx126x_shadow, test_failed_write_not_cached)
+{
+	struct sx126x_shadow_stats stats;
+
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_tx_params(&drv_ctx, 14, SX126X_RAMP_40_US));
+	radio.fail_next = true;
+	zassert_equal(SX126X_STATUS_ERROR, sx126x_set_tx_params(&drv_ctx, 10, SX126X_RAMP_40_US));
+	zassert_equal(SX126X_STATUS_OK, sx126x_set_tx_params(&drv_ctx, 14, SX126X_RAMP_40_US));
+	zassert_equal(3, radio.opcodes[SX126X_SET_TXPARAMS]);
+
+	sx126x_shadow_stats_get(&stats);
+	zassert_equal(2, stats.written[SX126X_SHADOW_TX_PARAMS]);
+	zassert_equal(0, stats.elided[SX126X_SHADOW_TX_PARAMS]);
+}
+
+/*
+ * Prints the SPI transactions of the first TX/RX cycle after wakeup and of the following
+ * cycles, to be compared with the no_shadow scenario.
+ */
+ZTEST(sx126x_shadow, test_tx_rx_cycle_benchmark)
+{
+	static const char *const names[SX126X_SHADOW_CMD_COUNT] = {
+		[SX126X_SHADOW_DIO_IRQ_PARAMS] = "dio irq params",
+		[SX126X_SHADOW_RF_FREQUENCY] = "rf frequency",
+		[SX126X_SHADOW_PKT_TYPE] = "packet type",
+		[SX126X_SHADOW_MOD_PARAMS] = "modulation params",
+		[SX126X_SHADOW_PKT_PARAMS] = "packet params",
+		[SX126X_SHADOW_TX_PARAMS] = "tx params",
+		[SX126X_SHADOW_PA_CONFIG] = "pa config",
+		[SX126X_SHADOW_GFSK_SYNC_WORD] = "gfsk sync word",
+		[SX126X_SHADOW_LORA_SYNC_WORD] = "lora sync word",
+	};
+	struct sx126x_shadow_stats stats;
+	uint32_t first_cycle;
+	uint32_t next_cycles;
+
+	radio_tx_rx_cycle();
+	first_cycle = radio.xfers;
+
+	for (int i = 0; i < BENCH_CYCLES; i++) {
+		radio_tx_rx_cycle();
+	}
+	next_cycles = (radio.xfers - first_cycle) / BENCH_CYCLES;
+
+	if (IS_ENABLED(CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW)) {
+		zassert_true(next_cycles < first_cycle);
+	} else {
+		zassert_equal(first_cycle, next_cycles);
+	}
+
+	sx126x_shadow_stats_get(&stats);
+	for (int i = 0; i < SX126X_SHADOW_CMD_COUNT; i++) {
+		TC_PRINT("%s: written %u, elided %u\n", names[i], stats.written[i],
+			 stats.elided[i]);
+	}
+	TC_PRINT("%s: %u SPI transactions in the first TX/RX cycle, %u in the next ones\n",
+		 IS_ENABLED(CONFIG_SIDEWALK_SUBGHZ_SX126X_SHADOW) ? "shadow" : "no shadow",
+		 first_cycle, next_cycles);
+}
+
+ZTEST_SUITE(sx126x_shadow, NULL, NULL, sx126x_shadow_before, NULL, NULL);
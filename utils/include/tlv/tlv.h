@@ -44,6 +44,34 @@ typedef int (*tlv_storage_erase_t)(void *ctx, uint32_t offset, uint32_t size);
  */
 typedef int (*tlv_storage_read_t)(void *ctx, uint32_t offset, uint8_t *data, uint32_t data_cap);
 
+typedef uint16_t tlv_type;
+typedef struct {
+	uint8_t padding;
+	uint8_t data_size;
+} tlv_size;
+
+typedef struct {
+	tlv_type type;
+	tlv_size payload_size;
+} tlv_header;
+
+#if CONFIG_SIDEWALK_TLV_INDEX
+typedef struct {
+	tlv_header header;
+	/* offset of the payload, directly after the header */
+	uint32_t payload_offset;
+} tlv_index_entry;
+
+typedef struct tlv_index {
+	tlv_index_entry entries[CONFIG_SIDEWALK_TLV_INDEX_SIZE];
+	uint16_t count;
+	/* index was built and matches the storage content */
+	bool valid;
+	/* every type found in storage fits in the index */
+	bool complete;
+} tlv_index;
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
+
 typedef struct tlv_ctx {
 	struct tlv_storage {
 		void *ctx;
@@ -57,19 +85,12 @@ typedef struct tlv_ctx {
 	uint32_t end_offset;
 	/* size of starting marker, after the marker the first tlv entry is stored.*/
 	uint32_t tlv_storage_start_marker_size;
+#if CONFIG_SIDEWALK_TLV_INDEX
+	/* optional RAM index of tlv headers, NULL when lookups should scan the storage */
+	tlv_index *index;
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
 } tlv_ctx;
 
-typedef uint16_t tlv_type;
-typedef struct {
-	uint8_t padding;
-	uint8_t data_size;
-} tlv_size;
-
-typedef struct {
-	tlv_type type;
-	tlv_size payload_size;
-} tlv_header;
-
 /**
  * @brief read the header of the TLV storage
  *        The header usually contains some magic value that signal start of data
@@ -134,4 +155,26 @@ int tlv_read(tlv_ctx *ctx, tlv_type type, uint8_t *data, uint16_t data_size);
  */
 int tlv_write(tlv_ctx *ctx, tlv_type type, const uint8_t *data, uint16_t data_size);
 
+#if CONFIG_SIDEWALK_TLV_INDEX
+/**
+ * @brief Build the RAM index of TLV headers
+ *        The storage is scanned once, later tlv_lookup and tlv_read calls are served from the index.
+ *        When storage holds more types than the index can hold, the missing ones are still found by scanning.
+ * 
+ * @param ctx tlv context with index assigned
+ * @return int 0 on success, negative in case of error
+ *   -EINVAL when ctx is invalid or has no index assigned
+ *   other errors are passed from storage handlers. 
+ */
+int tlv_index_build(tlv_ctx *ctx);
+
+/**
+ * @brief Drop the RAM index of TLV headers
+ *        Must be called when storage is modified without tlv_write, e.g. after erase.
+ * 
+ * @param ctx tlv context
+ */
+void tlv_index_invalidate(tlv_ctx *ctx);
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
+
 #endif
@@ -26,12 +26,8 @@ static void header_to_bytes(tlv_header header, uint8_t data[4])
 	data[3] = header.payload_size.data_size;
 }
 
-int tlv_lookup(tlv_ctx *ctx, tlv_type type, tlv_header *lookup_data)
+static int scan_header(tlv_ctx *ctx, tlv_type type, tlv_header *header, uint32_t *payload_offset)
 {
-	if (ctx == NULL || ctx->storage_impl.read == NULL) {
-		return -EINVAL;
-	}
-
 	for (uint32_t offset = ctx->start_offset + ctx->tlv_storage_start_marker_size;
 	     (offset + sizeof(tlv_header)) <= ctx->end_offset;) {
 		uint8_t header_raw[4] = { 0 };
@@ -40,52 +36,143 @@ int tlv_lookup(tlv_ctx *ctx, tlv_type type, tlv_header *lookup_data)
 		if (ret != 0) {
 			return ret;
 		}
-		tlv_header header = bytes_to_header(header_raw);
-		offset += sizeof(header);
-		if (header.type == type) {
-			if (lookup_data) {
-				*lookup_data = header;
-			}
+		tlv_header current = bytes_to_header(header_raw);
+		offset += sizeof(header_raw);
+		if (current.type == type) {
+			*header = current;
+			*payload_offset = offset;
 			return 0;
 		}
 
-		offset += header.payload_size.data_size + header.payload_size.padding;
+		offset += current.payload_size.data_size + current.payload_size.padding;
 	}
 	return -ENODATA;
 }
 
-int tlv_read(tlv_ctx *ctx, tlv_type type, uint8_t *data, uint16_t data_size)
+#if CONFIG_SIDEWALK_TLV_INDEX
+/*
+ * Returns -EAGAIN when the index can not answer and storage has to be scanned.
+ */
+static int index_find_header(tlv_ctx *ctx, tlv_type type, tlv_header *header,
+			     uint32_t *payload_offset)
 {
-	if (ctx == NULL || ctx->storage_impl.read == NULL) {
+	tlv_index *index = ctx->index;
+	if (index == NULL || !index->valid) {
+		return -EAGAIN;
+	}
+
+	for (uint16_t i = 0; i < index->count; i++) {
+		if (index->entries[i].header.type == type) {
+			*header = index->entries[i].header;
+			*payload_offset = index->entries[i].payload_offset;
+			return 0;
+		}
+	}
+	return index->complete ? -ENODATA : -EAGAIN;
+}
+
+static void index_add(tlv_index *index, tlv_header header, uint32_t payload_offset)
+{
+	for (uint16_t i = 0; i < index->count; i++) {
+		if (index->entries[i].header.type == header.type) {
+			/* lookup returns the first entry of a type, keep it */
+			return;
+		}
+	}
+	if (index->count >= ARRAY_SIZE(index->entries)) {
+		index->complete = false;
+		return;
+	}
+	index->entries[index->count++] =
+		(tlv_index_entry){ .header = header, .payload_offset = payload_offset };
+}
+
+int tlv_index_build(tlv_ctx *ctx)
+{
+	if (ctx == NULL || ctx->storage_impl.read == NULL || ctx->index == NULL) {
 		return -EINVAL;
 	}
 
+	tlv_index *index = ctx->index;
+	*index = (tlv_index){ .complete = true };
+
 	for (uint32_t offset = ctx->start_offset + ctx->tlv_storage_start_marker_size;
 	     (offset + sizeof(tlv_header)) <= ctx->end_offset;) {
 		uint8_t header_raw[4] = { 0 };
 		int ret = ctx->storage_impl.read(ctx->storage_impl.ctx, offset, header_raw,
 						 sizeof(header_raw));
 		if (ret != 0) {
+			*index = (tlv_index){ 0 };
 			return ret;
 		}
-
 		tlv_header header = bytes_to_header(header_raw);
 		offset += sizeof(header_raw);
-
-		if (header.type == type) {
-			if (data_size <=
-			    header.payload_size.data_size + header.payload_size.padding) {
-				if (offset + data_size > ctx->end_offset) {
-					return -ENODATA;
-				}
-				return ctx->storage_impl.read(ctx->storage_impl.ctx, offset, data,
-							      data_size);
-			}
-			return -ENOMEM;
-		}
+		index_add(index, header, offset);
 		offset += header.payload_size.data_size + header.payload_size.padding;
 	}
-	return -ENODATA;
+
+	index->valid = true;
+	return 0;
+}
+
+void tlv_index_invalidate(tlv_ctx *ctx)
+{
+	if (ctx == NULL || ctx->index == NULL) {
+		return;
+	}
+	ctx->index->valid = false;
+}
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
+
+static int find_header(tlv_ctx *ctx, tlv_type type, tlv_header *header, uint32_t *payload_offset)
+{
+#if CONFIG_SIDEWALK_TLV_INDEX
+	int ret = index_find_header(ctx, type, header, payload_offset);
+	if (ret != -EAGAIN) {
+		return ret;
+	}
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
+	return scan_header(ctx, type, header, payload_offset);
+}
+
+int tlv_lookup(tlv_ctx *ctx, tlv_type type, tlv_header *lookup_data)
+{
+	if (ctx == NULL || ctx->storage_impl.read == NULL) {
+		return -EINVAL;
+	}
+
+	tlv_header header;
+	uint32_t offset;
+	int ret = find_header(ctx, type, &header, &offset);
+	if (ret != 0) {
+		return ret;
+	}
+	if (lookup_data) {
+		*lookup_data = header;
+	}
+	return 0;
+}
+
+int tlv_read(tlv_ctx *ctx, tlv_type type, uint8_t *data, uint16_t data_size)
+{
+	if (ctx == NULL || ctx->storage_impl.read == NULL) {
+		return -EINVAL;
+	}
+
+	tlv_header header;
+	uint32_t offset;
+	int ret = find_header(ctx, type, &header, &offset);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (data_size > header.payload_size.data_size + header.payload_size.padding) {
+		return -ENOMEM;
+	}
+	if (offset + data_size > ctx->end_offset) {
+		return -ENODATA;
+	}
+	return ctx->storage_impl.read(ctx->storage_impl.ctx, offset, data, data_size);
 }
 
 static uint32_t get_next_free_offset(tlv_ctx *ctx)
@@ -117,6 +204,10 @@ int tlv_write(tlv_ctx *ctx, tlv_type type, const uint8_t *data, uint16_t data_si
 		return -EINVAL;
 	}
 
+#if CONFIG_SIDEWALK_TLV_INDEX
+	tlv_index_invalidate(ctx);
+#endif /* CONFIG_SIDEWALK_TLV_INDEX */
+
 	uint32_t next_free_offset = get_next_free_offset(ctx);
 	if (ctx->end_offset <
 	    (next_free_offset + sizeof(tlv_header) + data_size + CALCULATE_PADDING(data_size))) {